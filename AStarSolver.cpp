@@ -0,0 +1,98 @@
+//
+// Method implementation for the AStarSolver Class
+// Date: 10/18/2026
+//
+
+#include "AStarSolver.h"
+#include "BorderedGrid.h"
+#include "RadixHeap.h"
+
+/**
+ * Return name of the algorithm
+ * @return "astar"
+ */
+const char* AStarSolver::Name() const {
+    return "astar";
+}
+
+/**
+* Manhattan distance between two cells, a lower bound on the route length
+* @param a first cell
+* @param b second cell
+* @return number of moves if there were no walls
+*/
+static uint32_t Manhattan(const GridLocation& a, const GridLocation& b) {
+    size_t dRow = (a.Row() > b.Row()) ? a.Row() - b.Row() : b.Row() - a.Row();
+    size_t dCol = (a.Col() > b.Col()) ? a.Col() - b.Col() : b.Col() - a.Col();
+    return (uint32_t) (dRow + dCol);
+}
+
+/**
+* Find a shortest route with A* search
+* Cells are expanded in order of distance so far plus Manhattan distance to the
+* goal.  The heuristic is consistent, so the keys popped never decrease and a
+* radix heap can serve as the open list; a cell is final the first time it is
+* popped, and is closed in a bordered copy of the maze then.  Stale heap
+* entries are skipped rather than removed.
+* @param maze the maze that we want to solve
+* @param start where the route begins
+* @param goal where the route ends
+* @param solution out parameter used to return solution if it is found
+* @param stats if not nullptr, receives the amount of work done
+* @return true if solution can be found, false otherwise
+*/
+bool AStarSolver::Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+                        stack<GridLocation>& solution, SolveStats* stats) {
+    size_t expanded = 0;
+    bool found = false;
+
+    if (IsOpen(maze, start) && IsOpen(maze, goal)) {
+        CellLayout layout(maze.NumberRows(), maze.NumberCols());
+        vector<unsigned char> cells(layout.NumberHandles());
+        BorderedGrid grid(maze, cells.data());
+        CellHandle first = layout.ToHandle(start);
+        CellHandle last = layout.ToHandle(goal);
+        vector<CellHandle> parent(layout.NumberHandles());
+        vector<uint32_t> distance(layout.NumberHandles(), UINT32_MAX);
+        RadixHeap<CellHandle> open;
+
+        parent[first.Index()] = first;
+        distance[first.Index()] = 0;
+        open.Push(Manhattan(start, goal), first);
+
+        while (!open.Empty()) {
+            uint32_t key;
+            CellHandle current = open.Pop(key);
+
+            if (!grid.IsOpen(current)) {
+                continue;
+            }
+            grid.Close(current);
+            if (current == last) {
+                found = true;
+                break;
+            }
+
+            CellHandle moves[4];
+            size_t count = grid.ValidMoves(current, moves);
+
+            expanded++;
+            for (size_t i = 0; i < count; i++) {
+                uint32_t index = moves[i].Index();
+
+                if (distance[current.Index()] + 1 < distance[index]) {
+                    distance[index] = distance[current.Index()] + 1;
+                    parent[index] = current;
+                    open.Push(distance[index] + Manhattan(layout.ToLocation(moves[i]), goal), moves[i]);
+                }
+            }
+        }
+        if (found) {
+            BuildPath(layout, parent.data(), last, solution);
+        }
+    }
+    if (stats) {
+        stats->cellsExpanded = expanded;
+    }
+    return found;
+}
@@ -0,0 +1,19 @@
+//
+// Interface Definition for the AStarSolver Class
+// A* search with a Manhattan distance heuristic and a radix heap open list
+// Date: 10/18/2026
+//
+
+#ifndef ASTARSOLVER_H
+#define ASTARSOLVER_H
+
+#include "Solver.h"
+
+class AStarSolver : public Solver {
+public:
+    const char* Name() const override;
+    bool Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+               stack<GridLocation>& solution, SolveStats* stats) override;
+};
+
+#endif //ASTARSOLVER_H
@@ -0,0 +1,148 @@
+//
+// Method implementation for the BatchRunner Class
+// Date: 10/18/2026
+//
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <stack>
+#include <thread>
+using std::stack;
+using std::stringstream;
+
+#include "BatchRunner.h"
+#include "Grid.h"
+#include "CursesWindow.h"
+#include "Maze.h"
+#include "Solver.h"
+#include "ThreadPool.h"
+
+/**
+ * Constructor
+ * @param algorithm solver to use, one of the names from Solver::Names()
+ * @param nThreads number of worker threads, 0 for one per hardware thread
+ */
+BatchRunner::BatchRunner(const string& algorithm, unsigned nThreads) {
+    _algorithm = algorithm;
+    _nThreads = (nThreads == 0) ? std::thread::hardware_concurrency() : nThreads;
+    if (_nThreads == 0) {
+        _nThreads = 1;
+    }
+}
+
+/**
+ * Take the next file for a worker, from its own queue or else stolen from another's
+ * @param worker the worker's number
+ * @param file receives the index of the file to solve
+ * @return false once every queue is empty
+ */
+bool BatchRunner::NextFile(unsigned worker, size_t& file) {
+    {
+        std::lock_guard<std::mutex> lock(_queues[worker].mutex);
+        if (!_queues[worker].files.empty()) {
+            file = _queues[worker].files.front();
+            _queues[worker].files.pop_front();
+            return true;
+        }
+    }
+    for (unsigned i = 1; i < _queues.size(); i++) {
+        WorkQueue& victim = _queues[(worker + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (!victim.files.empty()) {
+            file = victim.files.back();
+            victim.files.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Solve every maze in a list, writing one tab separated line per maze as it finishes:
+ * file name, result (solved, unsolvable, wrong, or error), path length, cells
+ * expanded, and milliseconds to solve
+ * Parallel solvers share the hardware with the workers: each worker's solver
+ * gets hardware threads / workers threads, at least one, and with one thread
+ * pbfs searches serially.
+ * @param fileNames maze files to solve
+ * @param out where result lines are written
+ * @return totals over the batch
+ */
+BatchSummary BatchRunner::Run(const vector<string>& fileNames, ostream& out) {
+    ThreadPool pool(_nThreads);
+    std::mutex outMutex;
+    BatchSummary summary = BatchSummary();
+
+    // Deal the files out round robin; stealing evens out whatever this gets wrong
+    _queues = vector<WorkQueue>(pool.NumberThreads());
+    for (size_t i = 0; i < fileNames.size(); i++) {
+        _queues[i % _queues.size()].files.push_back(i);
+    }
+
+    // Every worker's solver is its own; a parallel one (pbfs) gets an equal share of
+    // the hardware threads, so N workers don't start N pools of N threads each
+    unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    unsigned solverThreads = std::max(1u, hardware / pool.NumberThreads());
+
+    auto begin = std::chrono::steady_clock::now();
+    pool.Run([&](unsigned worker) {
+        unique_ptr<Solver> solver = Solver::Create(_algorithm, solverThreads);
+        BatchSummary totals = BatchSummary();
+        size_t file;
+
+        while (NextFile(worker, file)) {
+            Grid maze;
+            stringstream line;
+
+            totals.mazes++;
+            line << fileNames[file] << '\t';
+            if (!maze.LoadFromPath(fileNames[file])) {
+                totals.errors++;
+                line << "error\t0\t0\t0";
+            }
+            else {
+                stack<GridLocation> solution;
+                SolveStats stats = SolveStats();
+
+                auto start = std::chrono::steady_clock::now();
+                bool found = SolveMaze(maze, solution, *solver, &stats);
+                auto stop = std::chrono::steady_clock::now();
+
+                totals.cells += maze.NumberRows() * maze.NumberCols();
+                totals.cellsExpanded += stats.cellsExpanded;
+                if (!found) {
+                    totals.unsolvable++;
+                    line << "unsolvable\t0";
+                }
+                else if (CheckSolution(maze, solution)) {
+                    totals.solved++;
+                    line << "solved\t" << solution.size();
+                }
+                else {
+                    totals.errors++;
+                    line << "wrong\t" << solution.size();
+                }
+                line << '\t' << stats.cellsExpanded << '\t'
+                     << std::chrono::duration<double, std::milli>(stop - start).count();
+            }
+
+            std::lock_guard<std::mutex> lock(outMutex);
+            out << line.str() << '\n';
+        }
+
+        std::lock_guard<std::mutex> lock(outMutex);
+        summary.mazes += totals.mazes;
+        summary.solved += totals.solved;
+        summary.unsolvable += totals.unsolvable;
+        summary.errors += totals.errors;
+        summary.cells += totals.cells;
+        summary.cellsExpanded += totals.cellsExpanded;
+    });
+    auto end = std::chrono::steady_clock::now();
+
+    summary.seconds = std::chrono::duration<double>(end - begin).count();
+    out.flush();
+    return summary;
+}
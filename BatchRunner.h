@@ -0,0 +1,54 @@
+//
+// Interface Definition for the BatchRunner Class
+// Solves a list of maze files on a pool of worker threads, writing one result
+// line per maze
+// Date: 10/18/2026
+//
+
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+using std::deque;
+using std::ostream;
+using std::string;
+using std::vector;
+
+// Totals over a batch
+struct BatchSummary {
+    size_t mazes;               // files attempted
+    size_t solved;              // mazes with a route, checked by CheckSolution
+    size_t unsolvable;          // mazes with no route
+    size_t errors;              // files that could not be loaded, or wrong routes
+    size_t cells;               // grid cells over all mazes loaded
+    size_t cellsExpanded;       // cells expanded by the solver over all mazes
+    double seconds;             // wall clock time for the whole batch
+};
+
+class BatchRunner {
+public:
+    BatchRunner(const string& algorithm, unsigned nThreads);
+
+    BatchSummary Run(const vector<string>& fileNames, ostream& out);
+
+private:
+    // Files waiting for one worker.  The owner takes from the front, and idle
+    // workers steal from the back, so a worker stuck on a giant maze only holds
+    // up the files still in its own queue until someone else takes them.
+    struct WorkQueue {
+        std::mutex mutex;
+        deque<size_t> files;
+    };
+
+    bool NextFile(unsigned worker, size_t& file);
+
+    string _algorithm;
+    unsigned _nThreads;
+    vector<WorkQueue> _queues;
+};
+
+#endif //BATCHRUNNER_H
@@ -0,0 +1,192 @@
+//
+// Method implementation for the BfsSolver Class
+// Date: 10/18/2026
+//
+
+#include "BfsSolver.h"
+#include "BorderedGrid.h"
+#include "CursesWindow.h"
+
+/**
+ * Constructor
+ * @param pwindow if not nullptr, used to animate the solution process
+ * @param workspace scratch memory for searches; nullptr means the calling thread's
+ */
+BfsSolver::BfsSolver(CursesWindow* pwindow, SolverWorkspace* workspace) {
+    _pwindow = pwindow;
+    _workspace = workspace;
+}
+
+/**
+ * Return name of the algorithm
+ * @return "bfs"
+ */
+const char* BfsSolver::Name() const {
+    return "bfs";
+}
+
+/**
+ * Return the workspace searches take their scratch memory from
+ * @return the workspace given to the constructor, or else the calling thread's
+ */
+SolverWorkspace& BfsSolver::Workspace() const {
+    return _workspace ? *_workspace : SolverWorkspace::ForThisThread();
+}
+
+/**
+* Breadth first search between two open cells
+* Rather than queueing a copy of every partial path, the search records one
+* predecessor per cell and keeps a flat queue of cell handles.  The search runs
+* on a bordered copy of the maze, so no move needs a bounds check, and closes
+* each cell as it is queued, so the copy is also the visited set.  The copy,
+* the parent array, the queue and, when animating, the room to trace partial
+* routes all come from the workspace, which is reset first; once the workspace
+* has grown to fit the maze, a search allocates nothing.
+* @param maze the maze that we want to solve
+* @param start where the route begins
+* @param goal where the route ends
+* @param chain receives the route from the goal back to the start, in the
+*        workspace (where the queue was), if there is one
+* @param length receives the number of cells on the route, 0 if there is none
+* @param expanded receives the number of cells expanded
+* @return true if a route exists, false otherwise
+*/
+bool BfsSolver::Search(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+                       const CellHandle*& chain, size_t& length, size_t& expanded) {
+    CellLayout layout(maze.NumberRows(), maze.NumberCols());
+    size_t nCells = maze.NumberRows() * maze.NumberCols();
+    size_t nHandles = layout.NumberHandles();
+    SolverWorkspace& workspace = Workspace();
+    bool found = false;
+
+    workspace.Reset();
+    workspace.Reserve(nHandles + nHandles * sizeof(CellHandle) + (_pwindow ? 2 : 1) * nCells * sizeof(CellHandle) + 4 * 64);
+    BorderedGrid grid(maze, workspace.Allocate<unsigned char>(nHandles));
+    CellHandle* parent = workspace.Allocate<CellHandle>(nHandles);
+    CellHandle* frontier = workspace.Allocate<CellHandle>(nCells);
+    CellHandle* trail = _pwindow ? workspace.Allocate<CellHandle>(nCells) : nullptr;
+    CellHandle first = layout.ToHandle(start);
+    CellHandle last = layout.ToHandle(goal);
+    size_t head = 0;
+    size_t tail = 0;
+
+    chain = nullptr;
+    length = 0;
+    expanded = 0;
+
+    // The start is its own parent, which ends reconstruction
+    parent[first.Index()] = first;
+    grid.Close(first);
+    frontier[tail++] = first;
+    found = (first == last);
+
+    while (!found && head < tail) {
+        CellHandle current = frontier[head++];
+        CellHandle moves[4];
+
+        if (_pwindow) {
+            ShowProgress(layout, parent, current, trail);
+        }
+
+        expanded++;
+        size_t count = grid.ValidMoves(current, moves);
+        for (size_t i = 0; i < count && !found; i++) {
+            CellHandle next = moves[i];
+
+            grid.Close(next);
+            parent[next.Index()] = current;
+            frontier[tail++] = next;
+            found = (next == last);
+        }
+    }
+
+    // The queue is done with, so the route goes where it was
+    if (found) {
+        for (CellHandle cell = last; ; cell = parent[cell.Index()]) {
+            frontier[length++] = cell;
+            if (parent[cell.Index()] == cell) {
+                break;
+            }
+        }
+        chain = frontier;
+    }
+    return found;
+}
+
+/**
+* Animate the route the search has found to a cell
+* @param layout layout of the handles
+* @param parent predecessor of every cell reached
+* @param cell handle of the cell
+* @param trail room for a route through every cell, which receives the route
+*/
+void BfsSolver::ShowProgress(const CellLayout& layout, const CellHandle* parent, CellHandle cell, CellHandle* trail) {
+    size_t length = 0;
+
+    trail[length++] = cell;
+    while (parent[cell.Index()] != cell) {
+        cell = parent[cell.Index()];
+        trail[length++] = cell;
+    }
+    _pwindow->ShowPath(layout, trail, length, false);
+}
+
+/**
+* Find a shortest route using a breadth first algorithm
+* The search itself allocates nothing once the workspace fits, but the stack's
+* deque is rebuilt for every route; use the vector form to avoid the heap.
+* @param maze the maze that we want to solve
+* @param start where the route begins
+* @param goal where the route ends
+* @param solution out parameter used to return solution if it is found
+* @param stats if not nullptr, receives the amount of work done
+* @return true if solution can be found, false otherwise
+*/
+bool BfsSolver::Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+                      stack<GridLocation>& solution, SolveStats* stats) {
+    CellLayout layout(maze.NumberRows(), maze.NumberCols());
+    const CellHandle* chain;
+    size_t length = 0;
+    size_t expanded = 0;
+    bool found = IsOpen(maze, start) && IsOpen(maze, goal) && Search(maze, start, goal, chain, length, expanded);
+
+    if (found) {
+        solution = stack<GridLocation>();
+        for (size_t i = length; i > 0; i--) {
+            solution.push(layout.ToLocation(chain[i-1]));
+        }
+    }
+    if (stats) {
+        stats->cellsExpanded = expanded;
+    }
+    return found;
+}
+
+/**
+* Find a shortest route using a breadth first algorithm, into a vector
+* A caller that reuses "route" from solve to solve, on mazes no bigger than the
+* workspace has already seen, causes no heap allocation at all.
+* @param maze the maze that we want to solve
+* @param start where the route begins
+* @param goal where the route ends
+* @param route receives the route, start first; left empty if there is none
+* @param stats if not nullptr, receives the amount of work done
+* @return true if a route exists, false otherwise
+*/
+bool BfsSolver::Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+                      vector<GridLocation>& route, SolveStats* stats) {
+    CellLayout layout(maze.NumberRows(), maze.NumberCols());
+    const CellHandle* chain;
+    size_t length = 0;
+    size_t expanded = 0;
+    bool found = IsOpen(maze, start) && IsOpen(maze, goal) && Search(maze, start, goal, chain, length, expanded);
+
+    route.resize(length);
+    for (size_t i = 0; i < length; i++) {
+        route[i] = layout.ToLocation(chain[length - 1 - i]);
+    }
+    if (stats) {
+        stats->cellsExpanded = expanded;
+    }
+    return found;
+}
@@ -0,0 +1,38 @@
+//
+// Interface Definition for the BfsSolver Class
+// Breadth first search over a bordered copy of the maze, with a flat parent
+// array and queue of cell handles, all carved out of a SolverWorkspace so a
+// solve into a reused vector doesn't touch the heap
+// Date: 10/18/2026
+//
+
+#ifndef BFSSOLVER_H
+#define BFSSOLVER_H
+
+#include "CellHandle.h"
+#include "Solver.h"
+#include "SolverWorkspace.h"
+
+class CursesWindow;
+
+class BfsSolver : public Solver {
+public:
+    explicit BfsSolver(CursesWindow* pwindow = nullptr, SolverWorkspace* workspace = nullptr);
+
+    const char* Name() const override;
+    bool Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+               stack<GridLocation>& solution, SolveStats* stats) override;
+    bool Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+               vector<GridLocation>& route, SolveStats* stats);
+
+private:
+    SolverWorkspace& Workspace() const;
+    bool Search(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+                const CellHandle*& chain, size_t& length, size_t& expanded);
+    void ShowProgress(const CellLayout& layout, const CellHandle* parent, CellHandle cell, CellHandle* trail);
+
+    CursesWindow* _pwindow;
+    SolverWorkspace* _workspace;
+};
+
+#endif //BFSSOLVER_H
@@ -0,0 +1,110 @@
+//
+// Method implementation for the BidirectionalSolver Class
+// Date: 10/18/2026
+//
+
+#include <algorithm>
+#include "BidirectionalSolver.h"
+#include "BorderedGrid.h"
+
+/**
+ * Return name of the algorithm
+ * @return "bibfs"
+ */
+const char* BidirectionalSolver::Name() const {
+    return "bibfs";
+}
+
+/**
+* Find a shortest route with a breadth first search from both ends at once
+* One search grows from the start and one from the goal.  Each step expands a
+* whole level of whichever frontier is smaller, and the search stops as soon as
+* one side reaches a cell the other side has seen.  Because whole levels are
+* expanded in turn, that first meeting lies on a shortest path.  The two halves
+* are then spliced into one path.  Both searches run over handles into a
+* bordered copy of the maze, a batch of frontier cells at a time.
+* @param maze the maze that we want to solve
+* @param start where the route begins
+* @param goal where the route ends
+* @param solution out parameter used to return solution if it is found
+* @param stats if not nullptr, receives the amount of work done
+* @return true if solution can be found, false otherwise
+*/
+bool BidirectionalSolver::Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+                                stack<GridLocation>& solution, SolveStats* stats) {
+    size_t expanded = 0;
+    uint32_t meeting = NO_PARENT;
+
+    if (stats) {
+        stats->cellsExpanded = 0;
+    }
+    if (!IsOpen(maze, start) || !IsOpen(maze, goal)) {
+        return false;
+    }
+
+    // Side 0 searches forward from the start, side 1 backward from the goal
+    CellLayout layout(maze.NumberRows(), maze.NumberCols());
+    const int32_t* offsets = layout.Offsets();
+    vector<unsigned char> cells(layout.NumberHandles());
+    BorderedGrid grid(maze, cells.data());
+    CellHandle ends[2] = { layout.ToHandle(start), layout.ToHandle(goal) };
+    // A cell's parent on a side is the border handle CellHandle() until that side reaches it
+    vector<CellHandle> parent[2];
+    vector<CellHandle> frontier[2];
+    vector<CellHandle> next;
+    unsigned char masks[BorderedGrid::BATCH];
+
+    for (int side = 0; side < 2; side++) {
+        parent[side].assign(layout.NumberHandles(), CellHandle());
+        parent[side][ends[side].Index()] = ends[side];
+        frontier[side].push_back(ends[side]);
+    }
+    if (ends[0] == ends[1]) {
+        meeting = ends[0].Index();
+    }
+
+    while (meeting == NO_PARENT && !frontier[0].empty() && !frontier[1].empty()) {
+        int side = (frontier[0].size() <= frontier[1].size()) ? 0 : 1;
+
+        // The open neighbors of a batch of frontier cells are found together
+        next.clear();
+        for (size_t batch = 0; batch < frontier[side].size() && meeting == NO_PARENT; batch += BorderedGrid::BATCH) {
+            size_t size = std::min(BorderedGrid::BATCH, frontier[side].size() - batch);
+
+            grid.MoveMasks(&frontier[side][batch], size, masks);
+            for (size_t f = 0; f < size && meeting == NO_PARENT; f++) {
+                CellHandle current = frontier[side][batch + f];
+
+                expanded++;
+                for (unsigned mask = masks[f]; mask != 0; mask &= mask - 1) {
+                    CellHandle cell = current + offsets[__builtin_ctz(mask)];
+
+                    if (parent[side][cell.Index()] == CellHandle()) {
+                        parent[side][cell.Index()] = current;
+                        if (parent[1 - side][cell.Index()] != CellHandle()) {
+                            meeting = cell.Index();
+                            break;
+                        }
+                        next.push_back(cell);
+                    }
+                }
+            }
+        }
+        frontier[side].swap(next);
+    }
+    if (stats) {
+        stats->cellsExpanded = expanded;
+    }
+    if (meeting == NO_PARENT) {
+        return false;
+    }
+
+    // Start .. meeting is the forward chain reversed, then the backward chain
+    // runs from just past the meeting cell to the goal
+    BuildPath(layout, parent[0].data(), CellHandle(meeting), solution);
+    for (CellHandle cell(meeting); parent[1][cell.Index()] != cell; ) {
+        cell = parent[1][cell.Index()];
+        solution.push(layout.ToLocation(cell));
+    }
+    return true;
+}
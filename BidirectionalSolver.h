@@ -0,0 +1,19 @@
+//
+// Interface Definition for the BidirectionalSolver Class
+// Breadth first search growing from both ends and meeting in the middle
+// Date: 10/18/2026
+//
+
+#ifndef BIDIRECTIONALSOLVER_H
+#define BIDIRECTIONALSOLVER_H
+
+#include "Solver.h"
+
+class BidirectionalSolver : public Solver {
+public:
+    const char* Name() const override;
+    bool Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+               stack<GridLocation>& solution, SolveStats* stats) override;
+};
+
+#endif //BIDIRECTIONALSOLVER_H
@@ -0,0 +1,41 @@
+//
+// Method implementation for the BorderedGrid Class
+// Date: 10/18/2026
+//
+
+#include <cstring>
+#include "BorderedGrid.h"
+
+const size_t BorderedGrid::BATCH;
+
+/**
+ * Constructor
+ * Copies the maze into the caller's bytes, 1 for open and 0 for a wall, with
+ * the border all walls.  The maze is read 64 cells at a time.
+ * @param maze the maze
+ * @param cells room for maze's CellLayout::NumberHandles() bytes
+ */
+BorderedGrid::BorderedGrid(const Grid& maze, unsigned char* cells)
+    : _layout(maze.NumberRows(), maze.NumberCols()), _cells(cells) {
+    size_t nCols = maze.NumberCols();
+    size_t stride = _layout.Stride();
+
+    assert(_layout.NumberHandles() <= UINT32_MAX);
+    memset(_cells, 0, stride);
+    memset(_cells + (maze.NumberRows() + 1) * stride, 0, stride);
+    for (size_t row = 0; row < maze.NumberRows(); row++) {
+        unsigned char* line = _cells + (row + 1) * stride;
+
+        line[0] = 0;
+        line[nCols + 1] = 0;
+        for (size_t word = 0; word < maze.WordsPerRow(); word++) {
+            uint64_t bits = maze.RowWord(row, word);
+            size_t first = 64 * word;
+            size_t last = (first + 64 < nCols) ? first + 64 : nCols;
+
+            for (size_t col = first; col < last; col++) {
+                line[col + 1] = (unsigned char) ((bits >> (col - first)) & 1);
+            }
+        }
+    }
+}
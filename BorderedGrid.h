@@ -0,0 +1,151 @@
+//
+// Interface Definition for the BorderedGrid Class
+// A byte per cell copy of a maze with a wall all round it, indexed by
+// CellHandle.  Every step from a grid cell lands in the array, so listing the
+// moves out of a cell takes four loads and no bounds checks.  The bytes are
+// the caller's (a workspace, say) and a search may close cells as it reaches
+// them, which makes the copy its visited set as well.
+// Date: 10/18/2026
+//
+
+#ifndef BORDEREDGRID_H
+#define BORDEREDGRID_H
+
+#include <cassert>
+
+#include "CellHandle.h"
+#include "Grid.h"
+
+class BorderedGrid {
+public:
+    // Frontier cells a search hands MoveMasks at a time
+    static const size_t BATCH = 64;
+
+    BorderedGrid(const Grid& maze, unsigned char* cells);
+
+    const CellLayout& Layout() const;
+    bool IsOpen(CellHandle cell) const;
+    void Open(CellHandle cell);
+    void Close(CellHandle cell);
+    size_t ValidMoves(CellHandle cell, CellHandle moves[4]) const;
+    void MoveMasks(const CellHandle cells[], size_t count, unsigned char masks[]) const;
+
+    template <typename Reach, typename Done>
+    size_t BreadthFirst(CellHandle queue[], size_t& head, size_t& tail, Reach reach, Done done) const;
+
+private:
+    CellLayout _layout;
+    unsigned char* _cells;
+};
+
+/**
+ * Return how handles map onto grid locations
+ * @return the layout
+ */
+inline const CellLayout& BorderedGrid::Layout() const {
+    return _layout;
+}
+
+/**
+ * Is the cell open, and not closed since?
+ * @param cell handle, of a grid cell or a border cell
+ * @return true if open
+ */
+inline bool BorderedGrid::IsOpen(CellHandle cell) const {
+    return _cells[cell.Index()] != 0;
+}
+
+/**
+ * Open a cell that is a wall
+ * @param cell handle of a grid cell
+ */
+inline void BorderedGrid::Open(CellHandle cell) {
+    assert(cell.Index() < _layout.NumberHandles());
+    _cells[cell.Index()] = 1;
+}
+
+/**
+ * Turn a cell into a wall
+ * @param cell handle of a grid cell
+ */
+inline void BorderedGrid::Close(CellHandle cell) {
+    assert(cell.Index() < _layout.NumberHandles());
+    _cells[cell.Index()] = 0;
+}
+
+/**
+ * List the open neighbors of a cell, in the order GenerateValidMoves does
+ * Every neighbor is written and only the open ones are counted, so there is
+ * no branch per neighbor
+ * @param cell handle of a grid cell
+ * @param moves receives the open neighbors
+ * @return number of open neighbors
+ */
+inline size_t BorderedGrid::ValidMoves(CellHandle cell, CellHandle moves[4]) const {
+    const int32_t* offsets = _layout.Offsets();
+    size_t count = 0;
+
+    for (unsigned i = 0; i < 4; i++) {
+        CellHandle next = cell + offsets[i];
+
+        moves[count] = next;
+        count += _cells[next.Index()];
+    }
+    return count;
+}
+
+/**
+ * List the open neighbors of a batch of cells as masks, bit (1 << Direction)
+ * set if that neighbor is open, as the batched GenerateValidMoves does
+ * Four loads and no branches per cell; the neighbors of the whole batch are in
+ * flight together, and the caller follows the set bits with the layout's offsets.
+ * @param cells handles of grid cells
+ * @param count number of cells
+ * @param masks receives one mask per cell
+ */
+inline void BorderedGrid::MoveMasks(const CellHandle cells[], size_t count, unsigned char masks[]) const {
+    ptrdiff_t stride = (ptrdiff_t) _layout.Stride();
+
+    for (size_t i = 0; i < count; i++) {
+        const unsigned char* cell = _cells + cells[i].Index();
+
+        masks[i] = (unsigned char) ((cell[-stride] << (int) Direction::North) | (cell[1] << (int) Direction::East)
+                                    | (cell[stride] << (int) Direction::South) | (cell[-1] << (int) Direction::West));
+    }
+}
+
+/**
+ * The breadth first loop the searches share: expand queued cells in order,
+ * offering each open neighbor to the caller, which records it and says
+ * whether it joins the queue
+ * The caller keeps its own visited set, or closes cells in this grid as it
+ * queues them, so the loop serves one search from scratch as well as many
+ * searches over a grid that stays as it is.
+ * @param queue room for every grid cell; cells from head to tail are waiting
+ * @param head position of the next cell to expand, updated upon return
+ * @param tail position past the last cell queued, updated upon return
+ * @param reach reach(next, from) returns true if next, just reached from
+ *        from, should be queued; false if it was reached before
+ * @param done done() returns true to stop before the next expansion
+ * @return number of cells expanded
+ */
+template <typename Reach, typename Done>
+size_t BorderedGrid::BreadthFirst(CellHandle queue[], size_t& head, size_t& tail, Reach reach, Done done) const {
+    size_t expanded = 0;
+
+    while (head < tail && !done()) {
+        CellHandle current = queue[head++];
+        CellHandle moves[4];
+        size_t count = ValidMoves(current, moves);
+
+        expanded++;
+        for (size_t i = 0; i < count; i++) {
+            if (reach(moves[i], current)) {
+                queue[tail++] = moves[i];
+            }
+        }
+    }
+    return expanded;
+}
+
+#endif //BORDEREDGRID_H
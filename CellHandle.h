@@ -0,0 +1,204 @@
+//
+// Interface Definition for the CellHandle and CellLayout Classes
+// A CellHandle names a cell by a 32-bit index into the grid with a one cell
+// wall all round it, so a step to any neighbor is the addition of a fixed
+// offset and never leaves the array.  CellLayout knows the width that turns
+// handles into GridLocations and back.
+// Date: 10/18/2026
+//
+
+#ifndef CELLHANDLE_H
+#define CELLHANDLE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Grid.h"
+
+class CellHandle {
+public:
+    constexpr CellHandle();
+    constexpr explicit CellHandle(uint32_t index);
+
+    constexpr uint32_t Index() const;
+    constexpr CellHandle operator+(int32_t offset) const;
+
+    friend constexpr bool operator==(CellHandle lhs, CellHandle rhs);
+    friend constexpr bool operator!=(CellHandle lhs, CellHandle rhs);
+
+private:
+    uint32_t _index;
+};
+
+class CellLayout {
+public:
+    constexpr CellLayout(size_t nRows, size_t nCols);
+
+    constexpr size_t NumberRows() const;
+    constexpr size_t NumberCols() const;
+    constexpr size_t Stride() const;
+    constexpr size_t NumberHandles() const;
+
+    constexpr CellHandle ToHandle(const GridLocation& loc) const;
+    constexpr GridLocation ToLocation(CellHandle cell) const;
+    constexpr int32_t Offset(Direction dir) const;
+    constexpr const int32_t* Offsets() const;
+    constexpr bool AreAdjacent(CellHandle a, CellHandle b) const;
+
+private:
+    size_t _nRows;
+    size_t _nCols;
+    // Row r, column c of the grid is handle (r + 1) * _stride + (c + 1)
+    size_t _stride;
+    // Offsets of the North, East, South and West neighbors, the order
+    // GenerateValidMoves lists moves in
+    int32_t _offsets[4];
+};
+
+// Handles are taken apart and put together on the solvers' inner loops, so
+// everything is inline
+
+/**
+ * Default constructor
+ * Creates the handle of the top left border cell, which no grid cell has
+ */
+constexpr CellHandle::CellHandle() : _index(0) {
+}
+
+/**
+ * Constructor
+ * @param index position in a bordered grid, from CellLayout
+ */
+constexpr CellHandle::CellHandle(uint32_t index) : _index(index) {
+}
+
+/**
+ * Return position in the bordered grid
+ * @return index
+ */
+constexpr uint32_t CellHandle::Index() const {
+    return _index;
+}
+
+/**
+ * Return the handle a step away
+ * @param offset from CellLayout::Offset
+ * @return handle of the neighbor
+ */
+constexpr CellHandle CellHandle::operator+(int32_t offset) const {
+    return CellHandle(_index + (uint32_t) offset);
+}
+
+/**
+ * Are two handles the same cell?
+ * @param lhs left hand side of the comparison
+ * @param rhs right hand side of the comparison
+ * @return true or false
+ */
+constexpr bool operator==(CellHandle lhs, CellHandle rhs) {
+    return lhs._index == rhs._index;
+}
+
+/**
+ * Are two handles different cells?
+ * @param lhs left hand side of the comparison
+ * @param rhs right hand side of the comparison
+ * @return true or false
+ */
+constexpr bool operator!=(CellHandle lhs, CellHandle rhs) {
+    return lhs._index != rhs._index;
+}
+
+/**
+ * Constructor
+ * @param nRows number of rows of the grid, not counting the border
+ * @param nCols number of columns of the grid, not counting the border
+ */
+constexpr CellLayout::CellLayout(size_t nRows, size_t nCols)
+    : _nRows(nRows), _nCols(nCols), _stride(nCols + 2),
+      _offsets{ -(int32_t) (nCols + 2), 1, (int32_t) (nCols + 2), -1 } {
+}
+
+/**
+ * Return number of rows of the grid
+ * @return number of rows, not counting the border
+ */
+constexpr size_t CellLayout::NumberRows() const {
+    return _nRows;
+}
+
+/**
+ * Return number of columns of the grid
+ * @return number of columns, not counting the border
+ */
+constexpr size_t CellLayout::NumberCols() const {
+    return _nCols;
+}
+
+/**
+ * Return the distance between handles of vertically adjacent cells
+ * @return number of columns plus the border on both sides
+ */
+constexpr size_t CellLayout::Stride() const {
+    return _stride;
+}
+
+/**
+ * Return how many handles there are, border included: the size of an array
+ * indexed by handle
+ * @return number of handles
+ */
+constexpr size_t CellLayout::NumberHandles() const {
+    return (_nRows + 2) * _stride;
+}
+
+/**
+ * Return the handle of a cell
+ * @param loc grid location, within the grid
+ * @return handle
+ */
+constexpr CellHandle CellLayout::ToHandle(const GridLocation& loc) const {
+    return CellHandle((uint32_t) ((loc.Row() + 1) * _stride + loc.Col() + 1));
+}
+
+/**
+ * Return the location of a cell
+ * @param cell handle of a cell within the grid, not the border
+ * @return grid location
+ */
+constexpr GridLocation CellLayout::ToLocation(CellHandle cell) const {
+    return GridLocation(cell.Index() / _stride - 1, cell.Index() % _stride - 1);
+}
+
+/**
+ * Return what to add to a handle to step one way
+ * @param dir direction of the step
+ * @return offset
+ */
+constexpr int32_t CellLayout::Offset(Direction dir) const {
+    return _offsets[(int) dir];
+}
+
+/**
+ * Return the offsets of all four steps, indexed by Direction
+ * @return North, East, South and West offsets
+ */
+constexpr const int32_t* CellLayout::Offsets() const {
+    return _offsets;
+}
+
+/**
+ * Are two cells a single move apart?
+ * The border columns keep the last cell of a row from looking adjacent to the
+ * first cell of the next.
+ * @param a handle of a cell within the grid
+ * @param b handle of a cell within the grid
+ * @return true if they share an edge
+ */
+constexpr bool CellLayout::AreAdjacent(CellHandle a, CellHandle b) const {
+    uint32_t gap = (a.Index() > b.Index()) ? a.Index() - b.Index() : b.Index() - a.Index();
+
+    return gap == 1 || gap == _stride;
+}
+
+#endif //CELLHANDLE_H
@@ -0,0 +1,151 @@
+//
+// Method implementation for the ConnectivityIndex Class
+// Date: 10/18/2026
+//
+
+#include <cassert>
+#include "ConnectivityIndex.h"
+
+const uint32_t ConnectivityIndex::NO_COMPONENT;
+
+/**
+ * Find the root of a union-find node, halving the path on the way
+ * @param parent union-find parent of each node
+ * @param node node to look up
+ * @return root of the node's set
+ */
+static uint32_t FindRoot(vector<uint32_t>& parent, uint32_t node) {
+    while (parent[node] != node) {
+        parent[node] = parent[parent[node]];
+        node = parent[node];
+    }
+    return node;
+}
+
+/**
+ * Default constructor
+ * Creates an index of an 0x0 maze
+ */
+ConnectivityIndex::ConnectivityIndex() {
+    _nRows = 0;
+    _nCols = 0;
+    _nComponents = 0;
+}
+
+/**
+ * Constructor
+ * Creates the index of a maze
+ * @param maze the maze to label
+ */
+ConnectivityIndex::ConnectivityIndex(const Grid& maze) : ConnectivityIndex() {
+    Build(maze);
+}
+
+/**
+ * Find the runs of open cells in a row of the maze, 64 cells at a time
+ * @param maze the maze
+ * @param row row number
+ * @param begin receives the first column of each run
+ * @param end receives one past the last column of each run
+ */
+void ConnectivityIndex::FindRuns(const Grid& maze, size_t row, vector<uint32_t>& begin, vector<uint32_t>& end) {
+    uint64_t carry = 0;
+
+    begin.clear();
+    end.clear();
+    for (size_t w = 0; w < maze.WordsPerRow(); w++) {
+        uint64_t open = maze.RowWord(row, w);
+        uint64_t shifted = (open << 1) | carry;
+        uint64_t starts = open & ~shifted;
+        uint64_t stops = ~open & shifted;
+
+        // Starts and stops alternate along the row, so each list stays in order
+        while (starts != 0) {
+            begin.push_back((uint32_t) (64 * w + __builtin_ctzll(starts)));
+            starts &= starts - 1;
+        }
+        while (stops != 0) {
+            end.push_back((uint32_t) (64 * w + __builtin_ctzll(stops)));
+            stops &= stops - 1;
+        }
+        carry = open >> 63;
+    }
+    if (end.size() < begin.size()) {
+        end.push_back((uint32_t) maze.NumberCols());
+    }
+}
+
+/**
+ * Label every cell of a maze with its connected component
+ * Two passes over the rows.  The first numbers the runs of open cells in
+ * order and joins each run, in a union-find, to the runs it overlaps in the row
+ * above.  The roots are then numbered as components, and the second pass finds
+ * the same runs again and writes their component into every cell.
+ * @param maze the maze to label
+ */
+void ConnectivityIndex::Build(const Grid& maze) {
+    vector<uint32_t> parent;
+    vector<uint32_t> prevBegin;
+    vector<uint32_t> prevEnd;
+    vector<uint32_t> runBegin;
+    vector<uint32_t> runEnd;
+
+    _nRows = maze.NumberRows();
+    _nCols = maze.NumberCols();
+    _nComponents = 0;
+    _labels.assign(_nRows * _nCols, NO_COMPONENT);
+
+    // First pass: union runs with the overlapping runs of the row above
+    uint32_t prevFirst = 0;
+    for (size_t row = 0; row < _nRows; row++) {
+        uint32_t first = (uint32_t) parent.size();
+        size_t above = 0;
+
+        FindRuns(maze, row, runBegin, runEnd);
+        assert(parent.size() + runBegin.size() < NO_COMPONENT);
+        for (size_t run = 0; run < runBegin.size(); run++) {
+            uint32_t node = first + (uint32_t) run;
+
+            parent.push_back(node);
+            while (above < prevBegin.size() && prevEnd[above] <= runBegin[run]) {
+                above++;
+            }
+            for (size_t other = above; other < prevBegin.size() && prevBegin[other] < runEnd[run]; other++) {
+                uint32_t a = FindRoot(parent, node);
+                uint32_t b = FindRoot(parent, prevFirst + (uint32_t) other);
+
+                // The smaller number becomes the root, so a root precedes its set
+                if (a < b) {
+                    parent[b] = a;
+                }
+                else if (b < a) {
+                    parent[a] = b;
+                }
+            }
+        }
+        prevBegin.swap(runBegin);
+        prevEnd.swap(runEnd);
+        prevFirst = first;
+    }
+
+    // Number the roots in order; every other run takes its root's number
+    vector<uint32_t> component(parent.size());
+    for (uint32_t node = 0; node < parent.size(); node++) {
+        uint32_t root = FindRoot(parent, node);
+
+        component[node] = (root == node) ? (uint32_t) _nComponents++ : component[root];
+    }
+
+    // Second pass: the runs come out in the same order, so run numbers line up
+    uint32_t node = 0;
+    for (size_t row = 0; row < _nRows; row++) {
+        uint32_t* labels = &_labels[row * _nCols];
+
+        FindRuns(maze, row, runBegin, runEnd);
+        for (size_t run = 0; run < runBegin.size(); run++, node++) {
+            for (uint32_t col = runBegin[run]; col < runEnd[run]; col++) {
+                labels[col] = component[node];
+            }
+        }
+    }
+}
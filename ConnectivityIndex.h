@@ -0,0 +1,90 @@
+//
+// Interface Definition for the ConnectivityIndex Class
+// Labels every open cell of a maze with its connected component, so whether
+// one cell can reach another is a comparison of two labels
+// Date: 10/18/2026
+//
+
+#ifndef CONNECTIVITYINDEX_H
+#define CONNECTIVITYINDEX_H
+
+#include <cstdint>
+#include <vector>
+using std::vector;
+
+#include "Grid.h"
+
+class ConnectivityIndex {
+public:
+    // Component of a wall, or of a location outside the grid
+    static const uint32_t NO_COMPONENT = UINT32_MAX;
+
+    ConnectivityIndex();
+    explicit ConnectivityIndex(const Grid& maze);
+
+    void Build(const Grid& maze);
+
+    size_t NumberRows() const;
+    size_t NumberCols() const;
+    size_t NumberComponents() const;
+    uint32_t Component(const GridLocation& loc) const;
+    bool Connected(const GridLocation& a, const GridLocation& b) const;
+
+private:
+    static void FindRuns(const Grid& maze, size_t row, vector<uint32_t>& begin, vector<uint32_t>& end);
+
+    // Component of each cell, row after row
+    vector<uint32_t> _labels;
+    size_t _nRows;
+    size_t _nCols;
+    size_t _nComponents;
+};
+
+/**
+ * Return number of rows of the maze the index was built for
+ * @return number of rows
+ */
+inline size_t ConnectivityIndex::NumberRows() const {
+    return _nRows;
+}
+
+/**
+ * Return number of columns of the maze the index was built for
+ * @return number of columns
+ */
+inline size_t ConnectivityIndex::NumberCols() const {
+    return _nCols;
+}
+
+/**
+ * Return number of connected components of open cells
+ * @return number of components, which are numbered from 0
+ */
+inline size_t ConnectivityIndex::NumberComponents() const {
+    return _nComponents;
+}
+
+/**
+ * Return the connected component holding a cell
+ * @param loc grid location, possibly outside the grid
+ * @return component number, or NO_COMPONENT for a wall or a location outside the grid
+ */
+inline uint32_t ConnectivityIndex::Component(const GridLocation& loc) const {
+    if (loc.Row() >= _nRows || loc.Col() >= _nCols) {
+        return NO_COMPONENT;
+    }
+    return _labels[loc.Row() * _nCols + loc.Col()];
+}
+
+/**
+ * Determine whether a route exists between two cells
+ * @param a one cell
+ * @param b the other cell
+ * @return true if both are open and in the same component
+ */
+inline bool ConnectivityIndex::Connected(const GridLocation& a, const GridLocation& b) const {
+    uint32_t component = Component(a);
+    return component != NO_COMPONENT && component == Component(b);
+}
+
+#endif //CONNECTIVITYINDEX_H
@@ -72,6 +72,17 @@ void CursesWindow::ShowPath(stack<GridLocation> path, bool fStayOn) {
     refresh();
 }
 
+void CursesWindow::ShowPath(const CellLayout& layout, const CellHandle* path, size_t length, bool fStayOn) {
+    PlotPath(layout, path, length, true);
+    if (!fStayOn) {
+        refresh();
+        std::chrono::milliseconds dura( 250);
+        std::this_thread::sleep_for( dura );
+        PlotPath(layout, path, length, false);
+    }
+    refresh();
+}
+
 void CursesWindow::PlotPath(stack<GridLocation> path, bool fOn) {
     while (!path.empty()) {
         GridLocation loc;
@@ -87,6 +98,22 @@ void CursesWindow::PlotPath(stack<GridLocation> path, bool fOn) {
     }
 }
 
+void CursesWindow::PlotPath(const CellLayout& layout, const CellHandle* path, size_t length, bool fOn) {
+    // The screen has the same one cell border as the handles, so a handle's
+    // row and column within the bordered grid are its screen position
+    for (size_t i = 0; i < length; i++) {
+        unsigned row = path[i].Index() / layout.Stride();
+        unsigned col = path[i].Index() % layout.Stride();
+
+        if (fOn) {
+            PlotPath('*', row, col);
+        }
+        else {
+            PlotCorridor(row, col);
+        }
+    }
+}
+
 void CursesWindow::PlotObstacle(unsigned row, unsigned col) {
     assert(_fInit);
     attron(COLOR_PAIR(1));
@@ -12,6 +12,7 @@
 using std::stack;
 
 #include <curses.h>
+#include "CellHandle.h"
 #include "Grid.h"
 
 class CursesWindow {
@@ -23,9 +24,11 @@ public:
 
     void ShowGrid(const Grid& grid);
     void ShowPath(stack<GridLocation> path, bool fStayOn);
+    void ShowPath(const CellLayout& layout, const CellHandle* path, size_t length, bool fStayOn);
 
 private:
     void PlotPath(stack<GridLocation> path, bool fOn);
+    void PlotPath(const CellLayout& layout, const CellHandle* path, size_t length, bool fOn);
     void PlotBorder(chtype ch, unsigned row, unsigned col );
     void PlotObstacle(unsigned row, unsigned col);
     void PlotCorridor(unsigned row, unsigned col);
@@ -0,0 +1,73 @@
+//
+// Dead-end filling: seals corridors that lead nowhere before a search
+// Date: 10/18/2026
+//
+
+#include <cstdint>
+#include <stack>
+#include <vector>
+using std::stack;
+using std::vector;
+
+#include "Grid.h"
+#include "BorderedGrid.h"
+#include "CursesWindow.h"
+#include "Maze.h"
+
+/**
+* Turn every dead end of a maze into wall, apart from the start and goal
+* A dead end is an open cell with at most one open neighbor.  No shortest route
+* passes through one, and sealing it may make its neighbor a dead end in turn,
+* so whole dead-end branches fill in.  Cells are queued as they become dead ends
+* rather than found by rescanning the grid, and neighbors are counted on a
+* bordered copy of the maze, which is sealed along with it.  In a perfect maze
+* (one with no loops) only the route from start to goal is left open.
+* Call it on a copy of a maze that must stay intact.
+* @param maze the maze to fill, changed in place
+* @param start where routes begin, never sealed
+* @param goal where routes end, never sealed
+* @return number of cells sealed
+*/
+size_t FillDeadEnds(Grid& maze, const GridLocation& start, const GridLocation& goal) {
+    CellLayout layout(maze.NumberRows(), maze.NumberCols());
+    vector<unsigned char> cells(layout.NumberHandles());
+    BorderedGrid grid(maze, cells.data());
+    CellHandle first = maze.IsWithinGrid(start) ? layout.ToHandle(start) : CellHandle();
+    CellHandle last = maze.IsWithinGrid(goal) ? layout.ToHandle(goal) : CellHandle();
+    vector<CellHandle> deadEnds;
+    CellHandle moves[4];
+    size_t sealed = 0;
+
+    for (size_t row = 0; row < maze.NumberRows(); row++) {
+        CellHandle cell = layout.ToHandle(GridLocation(row, 0));
+
+        for (size_t col = 0; col < maze.NumberCols(); col++, cell = cell + 1) {
+            if (grid.IsOpen(cell) && grid.ValidMoves(cell, moves) <= 1) {
+                deadEnds.push_back(cell);
+            }
+        }
+    }
+
+    while (!deadEnds.empty()) {
+        CellHandle cell = deadEnds.back();
+
+        deadEnds.pop_back();
+        if (cell == first || cell == last || !grid.IsOpen(cell)) {
+            continue;
+        }
+        grid.Close(cell);
+        maze[layout.ToLocation(cell)] = false;
+        sealed++;
+
+        // The one neighbor left, if any, may have become a dead end
+        size_t count = grid.ValidMoves(cell, moves);
+        for (size_t i = 0; i < count; i++) {
+            CellHandle around[4];
+
+            if (grid.ValidMoves(moves[i], around) <= 1) {
+                deadEnds.push_back(moves[i]);
+            }
+        }
+    }
+    return sealed;
+}
@@ -0,0 +1,49 @@
+//
+// Method implementation for the DeadEndFillingSolver Class
+// Date: 10/18/2026
+//
+
+#include <cassert>
+#include "DeadEndFillingSolver.h"
+#include "CursesWindow.h"
+#include "Maze.h"
+
+/**
+ * Constructor
+ * @param solver the solver to run on the filled maze
+ */
+DeadEndFillingSolver::DeadEndFillingSolver(unique_ptr<Solver> solver) : _solver(std::move(solver)) {
+    assert(_solver);
+    _name = string("fill+") + _solver->Name();
+}
+
+/**
+ * Return name of the algorithm
+ * @return "fill+" followed by the name of the solver it runs
+ */
+const char* DeadEndFillingSolver::Name() const {
+    return _name.c_str();
+}
+
+/**
+* Find a shortest route after filling in the maze's dead ends
+* The maze itself is left alone; the filling is done on a scratch copy, whose
+* storage is kept for the next call.
+* @param maze the maze that we want to solve
+* @param start where the route begins
+* @param goal where the route ends
+* @param solution out parameter used to return solution if it is found
+* @param stats if not nullptr, receives the work done by the solver and the number of cells filled
+* @return true if solution can be found, false otherwise
+*/
+bool DeadEndFillingSolver::Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+                                 stack<GridLocation>& solution, SolveStats* stats) {
+    _filled = maze;
+    size_t pruned = FillDeadEnds(_filled, start, goal);
+    bool found = _solver->Solve(_filled, start, goal, solution, stats);
+
+    if (stats) {
+        stats->cellsPruned = pruned;
+    }
+    return found;
+}
@@ -0,0 +1,27 @@
+//
+// Interface Definition for the DeadEndFillingSolver Class
+// Fills in the dead ends of a copy of the maze, then hands the copy to another
+// solver, so any solver can skip the branches that lead nowhere
+// Date: 10/18/2026
+//
+
+#ifndef DEADENDFILLINGSOLVER_H
+#define DEADENDFILLINGSOLVER_H
+
+#include "Solver.h"
+
+class DeadEndFillingSolver : public Solver {
+public:
+    explicit DeadEndFillingSolver(unique_ptr<Solver> solver);
+
+    const char* Name() const override;
+    bool Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+               stack<GridLocation>& solution, SolveStats* stats) override;
+
+private:
+    unique_ptr<Solver> _solver;
+    string _name;
+    Grid _filled;
+};
+
+#endif //DEADENDFILLINGSOLVER_H
@@ -0,0 +1,387 @@
+//
+// Method implementation for the DirectionOptimizingSolver Class
+// Date: 10/18/2026
+//
+
+#include <algorithm>
+#include <cassert>
+#include "DirectionOptimizingSolver.h"
+
+// Beamer's rule, with edges between open cells standing in for graph edges: a
+// top down step checks the edges of the frontier cells, and a bottom up step
+// would, at worst, check those of every unvisited cell.  Go bottom up once the
+// frontier's edges pass 1/ALPHA of the unvisited cells' edges, and back once
+// they drop under 1/BETA of them, so the search doesn't flip back and forth.
+// The edges of a level are counted as it is expanded, from the neighbor masks
+// each step works out anyway, so the level just expanded stands in for the next.
+static const size_t ALPHA = 14;
+static const size_t BETA = 24;
+
+// Word range of a row holding no cells
+static const uint32_t NO_WORD = UINT32_MAX;
+
+// Frontier cells a top down step finds the open neighbors of at once
+static const size_t BATCH = 64;
+
+/**
+ * Return name of the algorithm
+ * @return "dobfs"
+ */
+const char* DirectionOptimizingSolver::Name() const {
+    return "dobfs";
+}
+
+/**
+* Note that a word of a row holds next level cells
+* @param row row number
+* @param word word number within the row
+*/
+void DirectionOptimizingSolver::AddToNext(size_t row, size_t word) {
+    if (_nextFirst[row] == NO_WORD) {
+        _nextFirst[row] = (uint32_t) word;
+        _nextLast[row] = (uint32_t) word;
+        _nextFirstRow = std::min(_nextFirstRow, row);
+        _nextLastRow = std::max(_nextLastRow, row);
+    }
+    else {
+        _nextFirst[row] = std::min(_nextFirst[row], (uint32_t) word);
+        _nextLast[row] = std::max(_nextLast[row], (uint32_t) word);
+    }
+}
+
+/**
+* Make the next level the frontier
+* The old frontier's word ranges (and, if asked, its bits) are cleared, so the
+* level after this one starts out empty.
+* @param clearBits whether the old frontier's bitmap needs clearing too
+*/
+void DirectionOptimizingSolver::RetireFrontier(bool clearBits) {
+    for (size_t row = _firstRow; row <= _lastRow && _firstRow != SIZE_MAX; row++) {
+        if (clearBits && _frontierFirst[row] != NO_WORD) {
+            std::fill(&_frontier[row * _nWords + _frontierFirst[row]], &_frontier[row * _nWords + _frontierLast[row]] + 1, 0);
+        }
+        _frontierFirst[row] = NO_WORD;
+        _frontierLast[row] = 0;
+    }
+    _frontier.swap(_next);
+    _frontierFirst.swap(_nextFirst);
+    _frontierLast.swap(_nextLast);
+    _firstRow = _nextFirstRow;
+    _lastRow = _nextLastRow;
+    _nextFirstRow = SIZE_MAX;
+    _nextLastRow = 0;
+}
+
+/**
+* Find the words of a row the next level can reach: those holding, or beside
+* a word holding, a frontier cell in the row or the rows above and below
+* @param row row number
+* @param firstWord receives the first word to scan
+* @param lastWord receives the last word to scan
+* @return false if the next level can't reach the row at all
+*/
+bool DirectionOptimizingSolver::ScanRange(size_t row, size_t& firstWord, size_t& lastWord) const {
+    uint32_t first = _frontierFirst[row];
+    uint32_t last = (first == NO_WORD) ? 0 : _frontierLast[row];
+
+    if (row > 0 && _frontierFirst[row - 1] != NO_WORD) {
+        first = std::min(first, _frontierFirst[row - 1]);
+        last = std::max(last, _frontierLast[row - 1]);
+    }
+    if (row + 1 < _frontierFirst.size() && _frontierFirst[row + 1] != NO_WORD) {
+        first = std::min(first, _frontierFirst[row + 1]);
+        last = std::max(last, _frontierLast[row + 1]);
+    }
+    if (first == NO_WORD) {
+        return false;
+    }
+    firstWord = (first > 0) ? first - 1 : 0;
+    lastWord = std::min<size_t>(last + 1, _nWords - 1);
+    return true;
+}
+
+/**
+* Return one cell's bit of a row bitmap
+* @param words the row's words
+* @param col column number
+* @return 1 if the bit is set, 0 if not
+*/
+static inline unsigned RowBit(const uint64_t* words, size_t col) {
+    return (unsigned) (words[col / 64] >> (col % 64)) & 1;
+}
+
+/**
+* Return which neighbors of a cell are open
+* @param row row number
+* @param col column number
+* @param nRows number of rows of the maze
+* @param nCols number of columns of the maze
+* @return bit (1 << Direction) set for each open neighbor
+*/
+inline unsigned DirectionOptimizingSolver::OpenMask(size_t row, size_t col, size_t nRows, size_t nCols) const {
+    const uint64_t* open = &_open[row * _nWords];
+
+    return ((row > 0 ? RowBit(open - _nWords, col) : 0) << (int) Direction::North)
+           | ((col + 1 < nCols ? RowBit(open, col + 1) : 0) << (int) Direction::East)
+           | ((row + 1 < nRows ? RowBit(open + _nWords, col) : 0) << (int) Direction::South)
+           | ((col > 0 ? RowBit(open, col - 1) : 0) << (int) Direction::West);
+}
+
+/**
+* Expand every cell of the frontier, claiming unvisited neighbors
+* The frontier is taken a batch at a time: first the open neighbors of every
+* cell in the batch are read from the open bitmap as a mask, bit (1 << Direction)
+* set for each, then the masks are followed to claim the neighbors.
+* @param maze the maze being solved
+* @param frontier cells of the current level
+* @param next receives the cells of the next level
+* @param edges receives the number of edges of the frontier cells
+* @return number of cells in the next level
+*/
+size_t DirectionOptimizingSolver::TopDownStep(const Grid& maze, const vector<uint32_t>& frontier, vector<uint32_t>& next,
+                                              size_t& edges) {
+    static const int rowStep[4] = { -1, 0, 1, 0 };
+    static const int colStep[4] = { 0, 1, 0, -1 };
+    size_t nRows = maze.NumberRows();
+    size_t nCols = maze.NumberCols();
+    size_t rows[BATCH];
+    size_t cols[BATCH];
+    unsigned char masks[BATCH];
+
+    next.clear();
+    edges = 0;
+    for (size_t batch = 0; batch < frontier.size(); batch += BATCH) {
+        size_t size = std::min(BATCH, frontier.size() - batch);
+
+        for (size_t f = 0; f < size; f++) {
+            rows[f] = frontier[batch + f] / nCols;
+            cols[f] = frontier[batch + f] % nCols;
+            masks[f] = (unsigned char) OpenMask(rows[f], cols[f], nRows, nCols);
+            edges += __builtin_popcount(masks[f]);
+        }
+        for (size_t f = 0; f < size; f++) {
+            for (unsigned mask = masks[f]; mask != 0; mask &= mask - 1) {
+                unsigned dir = __builtin_ctz(mask);
+                size_t row = rows[f] + rowStep[dir];
+                size_t col = cols[f] + colStep[dir];
+                size_t word = row * _nWords + col / 64;
+                uint64_t bit = uint64_t(1) << (col % 64);
+
+                if (!(_visited[word] & bit)) {
+                    _visited[word] |= bit;
+                    _parent[row * nCols + col] = frontier[batch + f];
+                    next.push_back((uint32_t) (row * nCols + col));
+                }
+            }
+        }
+    }
+    return next.size();
+}
+
+/**
+* Find every unvisited open cell with a neighbor in the frontier, 64 cells at a time
+* The frontier words above, below, and either side of each word are shifted into
+* line with it, so one AND finds all of its cells that the frontier reaches.
+* Only words beside frontier words can be reached, so only they are scanned.
+* @param maze the maze being solved
+* @param edges receives the number of edges of the frontier cells
+* @return number of cells in the next level, which replaces the frontier bitmap
+*/
+size_t DirectionOptimizingSolver::BottomUpStep(const Grid& maze, size_t& edges) {
+    size_t nRows = maze.NumberRows();
+    size_t nCols = maze.NumberCols();
+    size_t firstRow = (_firstRow > 0) ? _firstRow - 1 : 0;
+    size_t lastRow = std::min(_lastRow + 1, nRows - 1);
+    size_t found = 0;
+
+    edges = 0;
+    for (size_t row = firstRow; row <= lastRow; row++) {
+        size_t firstWord;
+        size_t lastWord;
+
+        if (!ScanRange(row, firstWord, lastWord)) {
+            continue;
+        }
+        for (size_t w = firstWord; w <= lastWord; w++) {
+            size_t word = row * _nWords + w;
+            uint64_t candidates = _open[word] & ~_visited[word];
+
+            const uint64_t* frontier = &_frontier[word];
+            const uint64_t* open = &_open[word];
+
+            if (frontier[0] != 0) {
+                // The open neighbors of all the frontier cells, a direction at a time
+                edges += __builtin_popcountll(frontier[0] & (row > 0 ? open[-(ptrdiff_t) _nWords] : 0))
+                         + __builtin_popcountll(frontier[0] & (row + 1 < nRows ? open[_nWords] : 0))
+                         + __builtin_popcountll(frontier[0] & ((open[0] << 1) | (w > 0 ? open[-1] >> 63 : 0)))
+                         + __builtin_popcountll(frontier[0] & ((open[0] >> 1) | (w + 1 < _nWords ? open[1] << 63 : 0)));
+            }
+            if (candidates == 0) {
+                continue;
+            }
+
+            uint64_t fromNorth = row > 0 ? frontier[-(ptrdiff_t) _nWords] : 0;
+            uint64_t fromSouth = row + 1 < nRows ? frontier[_nWords] : 0;
+            uint64_t fromWest = (frontier[0] << 1) | (w > 0 ? frontier[-1] >> 63 : 0);
+            uint64_t fromEast = (frontier[0] >> 1) | (w + 1 < _nWords ? frontier[1] << 63 : 0);
+            uint64_t reached = candidates & (fromNorth | fromSouth | fromWest | fromEast);
+
+            if (reached == 0) {
+                continue;
+            }
+            _next[word] = reached;
+            _visited[word] |= reached;
+            AddToNext(row, w);
+            while (reached) {
+                unsigned bit = __builtin_ctzll(reached);
+                uint64_t mask = uint64_t(1) << bit;
+                size_t cell = row * nCols + w * 64 + bit;
+
+                // Any neighbor in the frontier is a valid parent; take the first
+                if (fromNorth & mask) {
+                    _parent[cell] = (uint32_t) (cell - nCols);
+                }
+                else if (fromWest & mask) {
+                    _parent[cell] = (uint32_t) (cell - 1);
+                }
+                else if (fromEast & mask) {
+                    _parent[cell] = (uint32_t) (cell + 1);
+                }
+                else {
+                    _parent[cell] = (uint32_t) (cell + nCols);
+                }
+                reached &= reached - 1;
+                found++;
+            }
+        }
+    }
+    RetireFrontier(true);
+    return found;
+}
+
+/**
+* Find a shortest route with a direction optimizing breadth first search
+* Levels are expanded top down, one frontier cell at a time, while the frontier
+* is small next to what is left to visit.  When it grows large in comparison,
+* as it does once a search has swept most of an open floor, most of those
+* neighbor checks land on cells already visited; then it is cheaper to scan
+* the unvisited cells beside the frontier for a neighbor in it, which the
+* bitmaps let us do a word at a time.
+* @param maze the maze that we want to solve
+* @param start where the route begins
+* @param goal where the route ends
+* @param solution out parameter used to return solution if it is found
+* @param stats if not nullptr, receives the amount of work done and the mode of each level
+* @return true if solution can be found, false otherwise
+*/
+bool DirectionOptimizingSolver::Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+                                      stack<GridLocation>& solution, SolveStats* stats) {
+    size_t nRows = maze.NumberRows();
+    size_t nCols = maze.NumberCols();
+    size_t expanded = 0;
+    string modes;
+    bool found = false;
+
+    if (IsOpen(maze, start) && IsOpen(maze, goal)) {
+        assert(nRows * nCols < NO_PARENT);
+
+        _nWords = maze.WordsPerRow();
+
+        size_t totalWords = nRows * _nWords;
+        uint32_t first = (uint32_t) (start.Row() * nCols + start.Col());
+        uint32_t last = (uint32_t) (goal.Row() * nCols + goal.Col());
+        size_t goalWord = goal.Row() * _nWords + goal.Col() / 64;
+        uint64_t goalBit = uint64_t(1) << (goal.Col() % 64);
+        vector<uint32_t> frontier;
+        vector<uint32_t> next;
+        size_t frontierSize = 1;
+        size_t frontierEdges = 0;
+        size_t unvisitedEdges = 0;
+        bool bottomUp = false;
+
+        _open.resize(totalWords);
+        for (size_t row = 0; row < nRows; row++) {
+            for (size_t w = 0; w < _nWords; w++) {
+                _open[row * _nWords + w] = maze.RowWord(row, w);
+            }
+        }
+
+        // Every pair of open cells side by side or one above the other is an
+        // edge, counted once from each end
+        for (size_t row = 0; row < nRows; row++) {
+            for (size_t w = 0; w < _nWords; w++) {
+                const uint64_t* open = &_open[row * _nWords + w];
+                uint64_t east = (open[0] >> 1) | (w + 1 < _nWords ? open[1] << 63 : 0);
+
+                unvisitedEdges += 2 * (size_t) __builtin_popcountll(open[0] & east);
+                unvisitedEdges += 2 * (size_t) __builtin_popcountll(row + 1 < nRows ? open[0] & open[_nWords] : 0);
+            }
+        }
+        _visited.assign(totalWords, 0);
+        _frontier.assign(totalWords, 0);
+        _next.assign(totalWords, 0);
+        _parent.assign(nRows * nCols, NO_PARENT);
+        _frontierFirst.assign(nRows, NO_WORD);
+        _frontierLast.assign(nRows, 0);
+        _nextFirst.assign(nRows, NO_WORD);
+        _nextLast.assign(nRows, 0);
+        _firstRow = SIZE_MAX;
+        _lastRow = 0;
+        _nextFirstRow = SIZE_MAX;
+        _nextLastRow = 0;
+
+        // The start is its own parent, which ends reconstruction
+        _parent[first] = first;
+        _visited[start.Row() * _nWords + start.Col() / 64] |= uint64_t(1) << (start.Col() % 64);
+        frontier.push_back(first);
+        frontierEdges = __builtin_popcount(OpenMask(start.Row(), start.Col(), nRows, nCols));
+        found = (first == last);
+
+        // The frontier is a list of cells while searching top down, and a bitmap
+        // while searching bottom up; the bitmaps and their word ranges are empty
+        // outside bottom up
+        while (!found && frontierSize > 0) {
+            expanded += frontierSize;
+            if (!bottomUp && frontierEdges * ALPHA > unvisitedEdges) {
+                bottomUp = true;
+                for (uint32_t cell : frontier) {
+                    _next[cell / nCols * _nWords + cell % nCols / 64] |= uint64_t(1) << (cell % nCols % 64);
+                    AddToNext(cell / nCols, cell % nCols / 64);
+                }
+                RetireFrontier(false);
+            }
+            else if (bottomUp && frontierEdges * BETA < unvisitedEdges) {
+                bottomUp = false;
+                frontier.clear();
+                for (size_t row = _firstRow; row <= _lastRow; row++) {
+                    for (size_t w = _frontierFirst[row]; _frontierFirst[row] != NO_WORD && w <= _frontierLast[row]; w++) {
+                        for (uint64_t bits = _frontier[row * _nWords + w]; bits; bits &= bits - 1) {
+                            frontier.push_back((uint32_t) (row * nCols + w * 64 + __builtin_ctzll(bits)));
+                        }
+                    }
+                }
+                RetireFrontier(true);
+            }
+
+            if (bottomUp) {
+                modes += 'B';
+                frontierSize = BottomUpStep(maze, frontierEdges);
+            }
+            else {
+                modes += 'T';
+                frontierSize = TopDownStep(maze, frontier, next, frontierEdges);
+                frontier.swap(next);
+            }
+            unvisitedEdges -= frontierEdges;
+            found = (_visited[goalWord] & goalBit) != 0;
+        }
+        if (found) {
+            BuildPath(maze, _parent.data(), last, solution);
+        }
+    }
+    if (stats) {
+        stats->cellsExpanded = expanded;
+        stats->levelModes = modes;
+    }
+    return found;
+}
@@ -0,0 +1,49 @@
+//
+// Interface Definition for the DirectionOptimizingSolver Class
+// Breadth first search that switches between expanding the frontier (top down)
+// and scanning unvisited cells for a frontier neighbor (bottom up), choosing by
+// how the frontier's edges compare with those of the cells still unvisited
+// Date: 10/18/2026
+//
+
+#ifndef DIRECTIONOPTIMIZINGSOLVER_H
+#define DIRECTIONOPTIMIZINGSOLVER_H
+
+#include "Solver.h"
+
+class DirectionOptimizingSolver : public Solver {
+public:
+    const char* Name() const override;
+    bool Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+               stack<GridLocation>& solution, SolveStats* stats) override;
+
+private:
+    unsigned OpenMask(size_t row, size_t col, size_t nRows, size_t nCols) const;
+    size_t TopDownStep(const Grid& maze, const vector<uint32_t>& frontier, vector<uint32_t>& next, size_t& edges);
+    size_t BottomUpStep(const Grid& maze, size_t& edges);
+    bool ScanRange(size_t row, size_t& firstWord, size_t& lastWord) const;
+    void AddToNext(size_t row, size_t word);
+    void RetireFrontier(bool clearBits);
+
+    // Bitmaps hold one row after another, WordsPerRow() words per row, with bit i
+    // of word w of a row standing for column 64 * w + i, as Grid::RowWord does
+    vector<uint64_t> _open;
+    vector<uint64_t> _visited;
+    vector<uint64_t> _frontier;
+    vector<uint64_t> _next;
+    vector<uint32_t> _parent;
+    size_t _nWords;
+
+    // Range of words of each row holding frontier (or next level) cells; first > last
+    // when a row holds none.  _firstRow .. _lastRow are the rows holding any.
+    vector<uint32_t> _frontierFirst;
+    vector<uint32_t> _frontierLast;
+    vector<uint32_t> _nextFirst;
+    vector<uint32_t> _nextLast;
+    size_t _firstRow;
+    size_t _lastRow;
+    size_t _nextFirstRow;
+    size_t _nextLastRow;
+};
+
+#endif //DIRECTIONOPTIMIZINGSOLVER_H
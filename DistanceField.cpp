@@ -0,0 +1,111 @@
+//
+// Breadth first distances from one cell to every cell of a maze
+// Date: 10/18/2026
+//
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <stack>
+#include <vector>
+using std::stack;
+using std::vector;
+
+#include "Grid.h"
+#include "BorderedGrid.h"
+#include "CursesWindow.h"
+#include "Maze.h"
+
+// Distance files are a 64 byte header followed by one uint32_t per cell, row
+// after row, UNREACHABLE where the source can't reach.  The header and the
+// distances are written in host byte order, which is little endian on the
+// machines we run on; a reader on a big endian machine must swap them.
+struct DistanceFieldHeader {
+    char magic[8];              // "MAZEDST\0"
+    uint32_t version;           // 1
+    uint32_t reserved;          // zero
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t sourceRow;
+    uint64_t sourceCol;
+    unsigned char padding[16];  // zero
+};
+static_assert(sizeof(DistanceFieldHeader) == 64, "distance field header must be 64 bytes");
+
+/**
+* Compute the number of moves from one cell to every cell of the maze
+* A breadth first search over a bordered copy of the maze that keeps no
+* parents: cells are closed in the copy as they are queued, and the distances
+* are laid out by handle while the search runs, then packed into rows.  Moves
+* are those GenerateValidMoves allows.
+* @param maze the maze
+* @param source the cell distances are measured from
+* @return distance of each cell, indexed row * cols + col, UNREACHABLE for walls
+*         and cells cut off from the source (every cell, if the source is a wall)
+*/
+vector<uint32_t> ComputeDistanceField(const Grid& maze, const GridLocation& source) {
+    size_t nRows = maze.NumberRows();
+    size_t nCols = maze.NumberCols();
+
+    if (!maze.IsWithinGrid(source) || !maze[source]) {
+        return vector<uint32_t>(nRows * nCols, UNREACHABLE);
+    }
+    assert(nRows * nCols < UNREACHABLE);
+
+    CellLayout layout(nRows, nCols);
+    vector<unsigned char> cells(layout.NumberHandles());
+    BorderedGrid grid(maze, cells.data());
+    vector<uint32_t> distance(layout.NumberHandles(), UNREACHABLE);
+    vector<CellHandle> queue(nRows * nCols);
+    size_t head = 0;
+    size_t tail = 0;
+    CellHandle first = layout.ToHandle(source);
+    auto reach = [&](CellHandle next, CellHandle from) {
+        grid.Close(next);
+        distance[next.Index()] = distance[from.Index()] + 1;
+        return true;
+    };
+
+    grid.Close(first);
+    distance[first.Index()] = 0;
+    queue[tail++] = first;
+    grid.BreadthFirst(queue.data(), head, tail, reach, []() { return false; });
+
+    // Each row moves down to where it belongs without the border, which is
+    // never past where it starts
+    for (size_t row = 0; row < nRows; row++) {
+        std::copy_n(distance.begin() + layout.ToHandle(GridLocation(row, 0)).Index(), nCols, distance.begin() + row * nCols);
+    }
+    distance.resize(nRows * nCols);
+    return distance;
+}
+
+/**
+* Write a distance field to a file, in binary
+* @param path pathname of the file to write
+* @param maze the maze the field was computed for
+* @param source the cell distances were measured from
+* @param distance the field, as ComputeDistanceField returns it
+* @return true if the file was written, false if not
+*/
+bool SaveDistanceField(const string& path, const Grid& maze, const GridLocation& source, const vector<uint32_t>& distance) {
+    DistanceFieldHeader header;
+
+    assert(distance.size() == maze.NumberRows() * maze.NumberCols());
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "MAZEDST", 8);
+    header.version = 1;
+    header.rows = maze.NumberRows();
+    header.cols = maze.NumberCols();
+    header.sourceRow = source.Row();
+    header.sourceCol = source.Col();
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+                   && fwrite(distance.data(), sizeof(uint32_t), distance.size(), file) == distance.size();
+    return fclose(file) == 0 && written;
+}
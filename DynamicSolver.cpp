@@ -0,0 +1,293 @@
+//
+// Method implementation for the DynamicSolver Class
+// Date: 10/18/2026
+//
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include "DynamicSolver.h"
+#include "CursesWindow.h"
+#include "Maze.h"
+
+const uint32_t DynamicSolver::NOT_QUEUED;
+
+/**
+ * Constructor
+ * Takes over a maze and queues the start; the first Solve does the work of an
+ * A* search
+ * @param maze the maze, which SetCell changes from then on
+ * @param start where routes begin
+ * @param goal where routes end
+ */
+DynamicSolver::DynamicSolver(Grid maze, const GridLocation& start, const GridLocation& goal)
+    : _maze(std::move(maze)), _cells(CellLayout(_maze.NumberRows(), _maze.NumberCols()).NumberHandles()),
+      _grid(_maze, _cells.data()), _goalLocation(goal) {
+    size_t nHandles = _cells.size();
+
+    assert(_maze.IsWithinGrid(start) && _maze.IsWithinGrid(goal));
+    // Keys pack g + h into 32 bits
+    assert(nHandles + _maze.NumberRows() + _maze.NumberCols() < UNREACHABLE);
+    _start = _grid.Layout().ToHandle(start);
+    _goal = _grid.Layout().ToHandle(goal);
+    _g.assign(nHandles, UNREACHABLE);
+    _rhs.assign(nHandles, UNREACHABLE);
+    _slot.assign(nHandles, NOT_QUEUED);
+    UpdateCell(_start);
+}
+
+/**
+ * Open or wall off a cell, and queue the cells whose distances that may change
+ * @param loc grid location, within the maze
+ * @param open true to open the cell, false to make it a wall
+ */
+void DynamicSolver::SetCell(const GridLocation& loc, bool open) {
+    CellHandle cell = _grid.Layout().ToHandle(loc);
+    CellHandle neighbors[4];
+
+    assert(_maze.IsWithinGrid(loc));
+    if (_grid.IsOpen(cell) == open) {
+        return;
+    }
+    _maze[loc] = open;
+    if (open) {
+        _grid.Open(cell);
+    }
+    else {
+        _grid.Close(cell);
+    }
+
+    // Walls keep rhs at UNREACHABLE whatever happens, so only the open
+    // neighbors can change
+    size_t count = _grid.ValidMoves(cell, neighbors);
+    UpdateCell(cell);
+    for (size_t i = 0; i < count; i++) {
+        UpdateCell(neighbors[i]);
+    }
+}
+
+/**
+ * Estimate the moves from a cell to the goal, by Manhattan distance
+ * @param cell handle of the cell
+ * @return lower bound on the moves to the goal
+ */
+inline uint32_t DynamicSolver::Heuristic(CellHandle cell) const {
+    GridLocation loc = _grid.Layout().ToLocation(cell);
+    size_t row = loc.Row(), col = loc.Col();
+    size_t goalRow = _goalLocation.Row(), goalCol = _goalLocation.Col();
+
+    return (uint32_t) ((row > goalRow ? row - goalRow : goalRow - row) + (col > goalCol ? col - goalCol : goalCol - col));
+}
+
+/**
+ * Return the priority of a cell: min(g, rhs) + h, ties broken by min(g, rhs),
+ * packed so that comparing keys compares both
+ * @param cell handle of the cell
+ * @return key, or UINT64_MAX if the cell can't be reached
+ */
+inline uint64_t DynamicSolver::Key(CellHandle cell) const {
+    uint32_t distance = std::min(_g[cell.Index()], _rhs[cell.Index()]);
+
+    if (distance == UNREACHABLE) {
+        return UINT64_MAX;
+    }
+    return ((uint64_t) (distance + Heuristic(cell)) << 32) | distance;
+}
+
+/**
+ * Recompute a cell's rhs from its open neighbors, and queue it if that leaves
+ * it inconsistent (g different from rhs) or take it out of the queue if not
+ * @param cell handle of the cell
+ */
+void DynamicSolver::UpdateCell(CellHandle cell) {
+    uint32_t index = cell.Index();
+
+    if (!_grid.IsOpen(cell)) {
+        _rhs[index] = UNREACHABLE;
+    }
+    else if (cell == _start) {
+        _rhs[index] = 0;
+    }
+    else {
+        CellHandle neighbors[4];
+        size_t count = _grid.ValidMoves(cell, neighbors);
+        uint32_t best = UNREACHABLE;
+
+        for (size_t i = 0; i < count; i++) {
+            best = std::min(best, _g[neighbors[i].Index()]);
+        }
+        _rhs[index] = (best == UNREACHABLE) ? UNREACHABLE : best + 1;
+    }
+
+    if (_slot[index] != NOT_QUEUED) {
+        Unqueue(cell);
+    }
+    if (_g[index] != _rhs[index]) {
+        Queue(cell, Key(cell));
+    }
+}
+
+/**
+ * Expand queued cells until the goal's distance is settled
+ * A cell whose distance went down passes it on to its neighbors; one whose
+ * distance went up forgets it and asks its neighbors again.
+ * @return number of cells expanded
+ */
+size_t DynamicSolver::ComputeShortestPath() {
+    size_t expanded = 0;
+    CellHandle neighbors[4];
+
+    while (!_heap.empty() && (_heap[0].first < Key(_goal) || _rhs[_goal.Index()] != _g[_goal.Index()])) {
+        CellHandle cell = _heap[0].second;
+        uint32_t index = cell.Index();
+        size_t count = _grid.ValidMoves(cell, neighbors);
+
+        Unqueue(cell);
+        expanded++;
+        if (_g[index] > _rhs[index]) {
+            _g[index] = _rhs[index];
+        }
+        else {
+            _g[index] = UNREACHABLE;
+            UpdateCell(cell);
+        }
+        for (size_t i = 0; i < count; i++) {
+            UpdateCell(neighbors[i]);
+        }
+    }
+    return expanded;
+}
+
+/**
+ * Find a shortest route from the start to the goal of the maze as it stands,
+ * repairing the search left by the last solve
+ * @param route receives the route, start first; left empty if there is none
+ * @param stats if not nullptr, receives the number of cells expanded by this solve
+ * @return true if a route exists, false otherwise
+ */
+bool DynamicSolver::Solve(vector<GridLocation>& route, SolveStats* stats) {
+    const CellLayout& layout = _grid.Layout();
+    size_t expanded = ComputeShortestPath();
+    bool found = _g[_goal.Index()] != UNREACHABLE;
+
+    // Walk back from the goal, each step to the neighbor closest to the start
+    route.clear();
+    if (found) {
+        CellHandle cell = _goal;
+        CellHandle neighbors[4];
+
+        route.push_back(layout.ToLocation(cell));
+        while (cell != _start) {
+            size_t count = _grid.ValidMoves(cell, neighbors);
+            CellHandle best = cell;
+
+            for (size_t i = 0; i < count; i++) {
+                if (_g[neighbors[i].Index()] < _g[best.Index()]) {
+                    best = neighbors[i];
+                }
+            }
+            assert(best != cell && _g[best.Index()] + 1 == _g[cell.Index()]);
+            cell = best;
+            route.push_back(layout.ToLocation(cell));
+        }
+        std::reverse(route.begin(), route.end());
+    }
+    if (stats) {
+        stats->cellsExpanded = expanded;
+    }
+    return found;
+}
+
+/**
+ * Find a shortest route from the start to the goal, in the form SolveMaze returns
+ * @param solution receives the route with start at the bottom and goal on top
+ * @param stats if not nullptr, receives the number of cells expanded by this solve
+ * @return true if a route exists, false otherwise
+ */
+bool DynamicSolver::Solve(stack<GridLocation>& solution, SolveStats* stats) {
+    vector<GridLocation> route;
+
+    if (!Solve(route, stats)) {
+        return false;
+    }
+    solution = stack<GridLocation>();
+    for (const GridLocation& loc : route) {
+        solution.push(loc);
+    }
+    return true;
+}
+
+/**
+ * Add a cell to the queue
+ * @param cell handle of the cell, not already queued
+ * @param key its priority, smallest first
+ */
+void DynamicSolver::Queue(CellHandle cell, uint64_t key) {
+    _heap.push_back(std::make_pair(key, cell));
+    _slot[cell.Index()] = (uint32_t) (_heap.size() - 1);
+    SiftUp(_heap.size() - 1);
+}
+
+/**
+ * Take a cell out of the queue, wherever it is
+ * @param cell handle of the cell, which must be queued
+ */
+void DynamicSolver::Unqueue(CellHandle cell) {
+    size_t slot = _slot[cell.Index()];
+    pair<uint64_t, CellHandle> last = _heap.back();
+
+    _heap.pop_back();
+    _slot[cell.Index()] = NOT_QUEUED;
+    if (slot < _heap.size()) {
+        Place(slot, last);
+        SiftUp(slot);
+        SiftDown(slot);
+    }
+}
+
+/**
+ * Put an entry in a slot of the heap and record where it went
+ * @param slot heap slot
+ * @param entry (key, cell)
+ */
+inline void DynamicSolver::Place(size_t slot, const pair<uint64_t, CellHandle>& entry) {
+    _heap[slot] = entry;
+    _slot[entry.second.Index()] = (uint32_t) slot;
+}
+
+/**
+ * Move an entry towards the root while its key is smaller than its parent's
+ * @param slot heap slot of the entry
+ */
+void DynamicSolver::SiftUp(size_t slot) {
+    pair<uint64_t, CellHandle> entry = _heap[slot];
+
+    while (slot > 0 && entry.first < _heap[(slot - 1) / 2].first) {
+        Place(slot, _heap[(slot - 1) / 2]);
+        slot = (slot - 1) / 2;
+    }
+    Place(slot, entry);
+}
+
+/**
+ * Move an entry away from the root while a child has a smaller key
+ * @param slot heap slot of the entry
+ */
+void DynamicSolver::SiftDown(size_t slot) {
+    pair<uint64_t, CellHandle> entry = _heap[slot];
+    size_t size = _heap.size();
+
+    while (2 * slot + 1 < size) {
+        size_t child = 2 * slot + 1;
+
+        if (child + 1 < size && _heap[child + 1].first < _heap[child].first) {
+            child++;
+        }
+        if (!(_heap[child].first < entry.first)) {
+            break;
+        }
+        Place(slot, _heap[child]);
+        slot = child;
+    }
+    Place(slot, entry);
+}
@@ -0,0 +1,78 @@
+//
+// Interface Definition for the DynamicSolver Class
+// Lifelong planning A* (LPA*) between a fixed start and goal: cells can be
+// opened and walled off between solves, and each solve repairs only the part
+// of the search that the changes affect
+// Date: 10/18/2026
+//
+
+#ifndef DYNAMICSOLVER_H
+#define DYNAMICSOLVER_H
+
+#include <cstdint>
+#include <stack>
+#include <utility>
+#include <vector>
+using std::pair;
+using std::stack;
+using std::vector;
+
+#include "Grid.h"
+#include "BorderedGrid.h"
+#include "Solver.h"
+
+class DynamicSolver {
+public:
+    DynamicSolver(Grid maze, const GridLocation& start, const GridLocation& goal);
+
+    DynamicSolver(const DynamicSolver&) = delete;
+    DynamicSolver& operator=(const DynamicSolver&) = delete;
+
+    const Grid& Maze() const;
+    void SetCell(const GridLocation& loc, bool open);
+
+    bool Solve(vector<GridLocation>& route, SolveStats* stats = nullptr);
+    bool Solve(stack<GridLocation>& solution, SolveStats* stats = nullptr);
+
+private:
+    static const uint32_t NOT_QUEUED = UINT32_MAX;
+
+    uint32_t Heuristic(CellHandle cell) const;
+    uint64_t Key(CellHandle cell) const;
+    void UpdateCell(CellHandle cell);
+    size_t ComputeShortestPath();
+
+    void Queue(CellHandle cell, uint64_t key);
+    void Unqueue(CellHandle cell);
+    void Place(size_t slot, const pair<uint64_t, CellHandle>& entry);
+    void SiftUp(size_t slot);
+    void SiftDown(size_t slot);
+
+    // The maze as a Grid for Maze(), and as a bordered copy, kept in step by
+    // SetCell, for stepping between cells
+    Grid _maze;
+    vector<unsigned char> _cells;
+    BorderedGrid _grid;
+    CellHandle _start;
+    CellHandle _goal;
+    GridLocation _goalLocation;
+
+    // g is the distance from the start as of the last time a cell was expanded,
+    // rhs the distance its neighbors' g values give it now, both indexed by
+    // handle.  The two differ for exactly the cells in the queue, which is a
+    // binary heap of (key, cell) with the slot of each cell in _slot, or NOT_QUEUED.
+    vector<uint32_t> _g;
+    vector<uint32_t> _rhs;
+    vector<uint32_t> _slot;
+    vector<pair<uint64_t, CellHandle>> _heap;
+};
+
+/**
+ * Return the maze as it stands after every SetCell so far
+ * @return the maze
+ */
+inline const Grid& DynamicSolver::Maze() const {
+    return _maze;
+}
+
+#endif //DYNAMICSOLVER_H
@@ -0,0 +1,287 @@
+//
+// Bit-parallel flood fill used to decide whether a maze is solvable
+// without building a path
+// Date: 10/18/2026
+//
+
+#include <cassert>
+#include <cstdint>
+#include <stack>
+#include <vector>
+using std::stack;
+using std::vector;
+
+#include "Grid.h"
+#include "CursesWindow.h"
+#include "Maze.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MAZE_HAVE_AVX2_DISPATCH 1
+#endif
+
+/**
+* Move reachable cells of one row vertically into the next, a word at a time
+* reach |= from & open, for every word of the row
+* @param reach reachable cells of the row being updated
+* @param from reachable cells of the neighboring row
+* @param open open cells of the row being updated
+* @param nWords number of words in a row
+* @return true if any cell was added to reach
+*/
+static bool MergeRowScalar(uint64_t* reach, const uint64_t* from, const uint64_t* open, size_t nWords) {
+    uint64_t added = 0;
+
+    for (size_t w = 0; w < nWords; w++) {
+        uint64_t extra = from[w] & open[w] & ~reach[w];
+
+        reach[w] |= extra;
+        added |= extra;
+    }
+    return added != 0;
+}
+
+#ifdef MAZE_HAVE_AVX2_DISPATCH
+/**
+* AVX2 version of MergeRowScalar, handling four words per instruction
+* @param reach reachable cells of the row being updated
+* @param from reachable cells of the neighboring row
+* @param open open cells of the row being updated
+* @param nWords number of words in a row
+* @return true if any cell was added to reach
+*/
+__attribute__((target("avx2")))
+static bool MergeRowAvx2(uint64_t* reach, const uint64_t* from, const uint64_t* open, size_t nWords) {
+    __m256i added = _mm256_setzero_si256();
+    size_t w = 0;
+
+    for (; w + 4 <= nWords; w += 4) {
+        __m256i r = _mm256_loadu_si256((const __m256i*) (reach + w));
+        __m256i extra = _mm256_andnot_si256(r, _mm256_and_si256(_mm256_loadu_si256((const __m256i*) (from + w)),
+                                                                _mm256_loadu_si256((const __m256i*) (open + w))));
+
+        _mm256_storeu_si256((__m256i*) (reach + w), _mm256_or_si256(r, extra));
+        added = _mm256_or_si256(added, extra);
+    }
+    bool any = !_mm256_testz_si256(added, added);
+    return MergeRowScalar(reach + w, from + w, open + w, nWords - w) || any;
+}
+#endif
+
+typedef bool (*MergeRowFunction)(uint64_t* reach, const uint64_t* from, const uint64_t* open, size_t nWords);
+
+/**
+* Pick the fastest row merge the processor supports
+* @return row merge function
+*/
+static MergeRowFunction SelectMergeRow() {
+#ifdef MAZE_HAVE_AVX2_DISPATCH
+    if (__builtin_cpu_supports("avx2")) {
+        return MergeRowAvx2;
+    }
+#endif
+    return MergeRowScalar;
+}
+
+/**
+* Spread reachable cells of a row horizontally along its open runs
+* Rightward spread uses the carry of an addition: adding the reachable cells to
+* the open cells carries through every open cell to the right of them.  Leftward
+* spread is a shift-doubling (Kogge-Stone) fill within each word, handing the
+* low bit on to the word below.
+* @param reach reachable cells of the row, a subset of open, updated upon return
+* @param open open cells of the row
+* @param nWords number of words in a row
+*/
+static void FillRow(uint64_t* reach, const uint64_t* open, size_t nWords) {
+    uint64_t carry = 0;
+
+    for (size_t w = 0; w < nWords; w++) {
+        uint64_t sum = open[w] + reach[w];
+        uint64_t carryOut = sum < open[w];
+
+        sum += carry;
+        carryOut |= (sum == 0 && carry);
+        reach[w] |= (sum ^ open[w]) & open[w];
+        carry = carryOut;
+    }
+
+    uint64_t incoming = 0;
+    for (size_t w = nWords; w > 0; w--) {
+        uint64_t gen = reach[w-1] | (incoming & open[w-1]);
+        uint64_t pro = open[w-1];
+
+        gen |= pro & (gen >> 1);  pro &= pro >> 1;
+        gen |= pro & (gen >> 2);  pro &= pro >> 2;
+        gen |= pro & (gen >> 4);  pro &= pro >> 4;
+        gen |= pro & (gen >> 8);  pro &= pro >> 8;
+        gen |= pro & (gen >> 16); pro &= pro >> 16;
+        gen |= pro & (gen >> 32);
+        reach[w-1] = gen;
+        incoming = (gen & 1) << 63;
+    }
+}
+
+/**
+* Spread reachable cells of one word along its open runs, both ways
+* Upward spread is the carry of an addition, downward a shift-doubling fill, as
+* in FillRow, but nothing crosses into the neighboring words.
+* @param reach reachable cells, a subset of open
+* @param open open cells
+* @return reach grown to cover the open runs it touches
+*/
+static uint64_t FillWord(uint64_t reach, uint64_t open) {
+    uint64_t gen = reach | (((open + reach) ^ open) & open);
+    uint64_t pro = open;
+
+    gen |= pro & (gen >> 1);  pro &= pro >> 1;
+    gen |= pro & (gen >> 2);  pro &= pro >> 2;
+    gen |= pro & (gen >> 4);  pro &= pro >> 4;
+    gen |= pro & (gen >> 8);  pro &= pro >> 8;
+    gen |= pro & (gen >> 16); pro &= pro >> 16;
+    gen |= pro & (gen >> 32);
+    return gen;
+}
+
+/**
+* Determine whether the maze can be solved, without finding the route
+* Floods the set of cells reachable from the upper left corner a whole row of
+* 64 cell words at a time, sweeping down then up the grid.  Sweeps are cheap
+* and finish most mazes in a few passes, but a route that doubles back
+* vertically needs a pass per switchback.  So when a couple of passes haven't
+* settled it, the fill carries on word by word from a worklist: a word is
+* revisited only when a neighbor has gained cells it can take, which bounds
+* the work by the number of cells reached, as a breadth first search is.
+* @param maze the maze to check
+* @return true if a route exists, false otherwise
+*/
+bool IsSolvable(const Grid& maze) {
+    static const MergeRowFunction mergeRow = SelectMergeRow();
+    static const unsigned SWEEPS = 2;
+    size_t nRows = maze.NumberRows();
+    size_t nWords = maze.WordsPerRow();
+
+    if (nRows == 0 || nWords == 0) {
+        return false;
+    }
+
+    size_t goalRow = nRows - 1;
+    size_t goalCol = maze.NumberCols() - 1;
+    if (!maze[GridLocation(0, 0)] || !maze[GridLocation(goalRow, goalCol)]) {
+        return false;
+    }
+
+    vector<uint64_t> open(nRows * nWords);
+    vector<uint64_t> reach(nRows * nWords, 0);
+    for (size_t row = 0; row < nRows; row++) {
+        for (size_t w = 0; w < nWords; w++) {
+            open[row * nWords + w] = maze.RowWord(row, w);
+        }
+    }
+
+    uint64_t* goalWord = &reach[goalRow * nWords + goalCol / 64];
+    uint64_t goalBit = uint64_t(1) << (goalCol % 64);
+
+    reach[0] = 1;
+    FillRow(&reach[0], &open[0], nWords);
+
+    bool changed = true;
+    for (unsigned sweep = 0; sweep < SWEEPS && changed && !(*goalWord & goalBit); sweep++) {
+        changed = false;
+        for (size_t row = 1; row < nRows; row++) {
+            uint64_t* rowReach = &reach[row * nWords];
+
+            if (mergeRow(rowReach, rowReach - nWords, &open[row * nWords], nWords)) {
+                FillRow(rowReach, &open[row * nWords], nWords);
+                changed = true;
+            }
+        }
+        for (size_t row = nRows - 1; row > 0; row--) {
+            uint64_t* rowReach = &reach[(row - 1) * nWords];
+
+            if (mergeRow(rowReach, rowReach + nWords, &open[(row - 1) * nWords], nWords)) {
+                FillRow(rowReach, &open[(row - 1) * nWords], nWords);
+                changed = true;
+            }
+        }
+    }
+    if (!changed || (*goalWord & goalBit)) {
+        return (*goalWord & goalBit) != 0;
+    }
+
+    // Cells a word would take from its neighbors: from the words above and
+    // below, and across the boundary from the ends of the words either side
+    auto incoming = [&](size_t index) {
+        size_t w = index % nWords;
+        uint64_t from = 0;
+
+        if (index >= nWords) {
+            from |= reach[index - nWords];
+        }
+        if (index + nWords < reach.size()) {
+            from |= reach[index + nWords];
+        }
+        if (w > 0) {
+            from |= reach[index - 1] >> 63;
+        }
+        if (w + 1 < nWords) {
+            from |= reach[index + 1] << 63;
+        }
+        return from & open[index] & ~reach[index];
+    };
+
+    // Every word with cells to take from a neighbor starts on the worklist
+    vector<uint32_t> worklist;
+    vector<bool> queued(reach.size(), false);
+    assert(reach.size() <= UINT32_MAX);
+    for (size_t index = 0; index < reach.size(); index++) {
+        if (incoming(index) != 0) {
+            worklist.push_back((uint32_t) index);
+            queued[index] = true;
+        }
+    }
+
+    while (!worklist.empty() && !(*goalWord & goalBit)) {
+        size_t index = worklist.back();
+        size_t w = index % nWords;
+        uint64_t gained = incoming(index);
+
+        worklist.pop_back();
+        queued[index] = false;
+        if (gained == 0) {
+            continue;
+        }
+        gained = FillWord(reach[index] | gained, open[index]) & ~reach[index];
+        reach[index] |= gained;
+
+        // Queue the neighbors the new cells reach into
+        size_t neighbors[4];
+        uint64_t touches[4];
+        size_t count = 0;
+        if (index >= nWords) {
+            neighbors[count] = index - nWords;
+            touches[count++] = gained;
+        }
+        if (index + nWords < reach.size()) {
+            neighbors[count] = index + nWords;
+            touches[count++] = gained;
+        }
+        if (w > 0) {
+            neighbors[count] = index - 1;
+            touches[count++] = gained << 63;
+        }
+        if (w + 1 < nWords) {
+            neighbors[count] = index + 1;
+            touches[count++] = gained >> 63;
+        }
+        for (size_t i = 0; i < count; i++) {
+            size_t next = neighbors[i];
+
+            if (!queued[next] && (touches[i] & open[next] & ~reach[next]) != 0) {
+                worklist.push_back((uint32_t) next);
+                queued[next] = true;
+            }
+        }
+    }
+    return (*goalWord & goalBit) != 0;
+}
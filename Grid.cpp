@@ -7,121 +7,205 @@
 //
 
 #include <cassert>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "Grid.h"
 using namespace std;
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define GRID_HAVE_AVX2_DISPATCH 1
+#endif
+
+// Rows are aligned to, and padded out to a multiple of, one cache line
+static const size_t CACHE_LINE_SIZE = 64;
+
+// Binary maze (.mzb) files are a 64 byte header followed by the rows exactly as
+// bit per cell storage holds them: bit c of a row is column c, low bit of the
+// first byte first, each row padded with walls to a multiple of 64 bytes.  The
+// header keeps the rows cache line aligned once the file is mapped at a page
+// boundary, so loading maps the file and points the grid at it.  All fields
+// are little endian.
+struct BinaryMazeHeader {
+    char magic[8];              // MZB_MAGIC
+    uint32_t version;           // MZB_VERSION
+    uint32_t flags;             // MZB_CHECKSUM if the checksum field is filled in
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t stride;            // bytes per row
+    uint64_t checksum;          // BinaryChecksum of the rows
+    unsigned char reserved[16]; // zero
+};
+static_assert(sizeof(BinaryMazeHeader) == CACHE_LINE_SIZE, "binary maze header must be one cache line");
+
+static const char MZB_MAGIC[8] = { 'M', 'A', 'Z', 'E', 'B', 'I', 'N', '\0' };
+static const uint32_t MZB_VERSION = 1;
+static const uint32_t MZB_CHECKSUM = 1;
+
 /**
  * Default constructor
- * Creates an 0x0 grid
+ * Creates an 0x0 grid that stores a byte per cell
  */
-Grid::Grid() {
+Grid::Grid() : Grid(GridStorage::Bytes) {
+}
+
+/**
+ * Constructor
+ * Creates an 0x0 grid with a specific storage mode
+ * @param storage byte per cell or bit per cell
+ */
+Grid::Grid(GridStorage storage) {
+    _data = nullptr;
+    _stride = 0;
+    _storage = storage;
+    _shift = (storage == GridStorage::Bits) ? 3 : 0;
+    _bitMask = (storage == GridStorage::Bits) ? 7 : 0;
+    _mapping = nullptr;
+    _mappingLength = 0;
     _nRows = 0;
     _nCols = 0;
-    //_array[0][0] = {};
 }
 
 /**
- * Destructor
- * Frees the dynamic memory allocated for the list
+ * Copy constructor
+ * Creates a grid with the same dimensions and contents as another
+ * @param other grid to copy
  */
-Grid::~Grid() {
-    /*for (int row = 0; row < _nRows; row++) {
-        for (int col = 0; col < _nCols; col++) {
-            delete[] _array;
-        }
-    }*/
-    /*for (int row = 0; row < _nRows; row++) {
-        for (int col = 0; col <_nCols; col++) {
-            delete[] _array[col];
-        }
-    }*/
+Grid::Grid(const Grid& other) : Grid(other._storage) {
+    *this = other;
 }
 
 /**
- * Configure nRows x nCols grid of bool initially filled with false
- * 1) Frees any existing allocation
- * 2) Allocates storage for the nRows x nCols grid
- * 3) Initializes it to all false
- * @param nRows = number of rows
- * @param nCols = number of columns
+ * Move constructor
+ * Takes over the storage of another grid, leaving it as an 0x0 grid
+ * @param other grid to move from
  */
-void Grid::Configure(size_t nRows, size_t nCols) {
-    _nRows = nRows;
-    _nCols = nCols;
-    /*vector<vector<bool>> here;
-
-    for (int row = 0; row < nRows; row++) {
-        vector<bool> size;
-        for (int col = 0; col < nCols; col++) {
-            size.push_back(false);
-            cout << size[0] << " ";
-        }
-        here.push_back(size);
-        cout << endl;
-    }
-    _grid = &here;*/
+Grid::Grid(Grid&& other) noexcept : Grid(other._storage) {
+    *this = std::move(other);
+}
 
-    //bool** change[nRows][nCols];
+/**
+ * Destructor
+ * Frees the dynamic memory allocated for the grid
+ */
+Grid::~Grid() {
+    Release();
+}
 
-    //_array = reinterpret_cast<bool **>(_array[nRows][nCols]);
-    _array = (bool**)malloc(nRows*sizeof(bool*));
-        for (int i = 0; i < nRows; i++) {
-            _array[i] = (bool*) malloc(nCols*sizeof(bool));
+/**
+ * Copy assignment
+ * This grid takes on the storage mode of the other grid
+ * @param other grid to copy
+ * @return this grid
+ */
+Grid& Grid::operator=(const Grid& other) {
+    if (this != &other) {
+        if (_storage != other._storage) {
+            Release();
+            _storage = other._storage;
+            _shift = other._shift;
+            _bitMask = other._bitMask;
         }
-
-    for (int row = 0; row < nRows; row++) {
-        for (int col = 0; col < nCols; col++) {
-            _array[row][col] = false;
+        Allocate(other._nRows, other._nCols);
+        if (_data != nullptr) {
+            memcpy(_data, other._data, _stride * _nRows);
         }
     }
-
+    return *this;
 }
 
 /**
- * Return number of rows in grid
- * @return number of rows
+ * Move assignment
+ * Frees this grid's storage and takes over the storage of another grid
+ * @param other grid to move from, left as an 0x0 grid
+ * @return this grid
  */
-size_t Grid::NumberRows() const {
-    return _nRows;
+Grid& Grid::operator=(Grid&& other) noexcept {
+    if (this != &other) {
+        Release();
+        _data = other._data;
+        _stride = other._stride;
+        _storage = other._storage;
+        _shift = other._shift;
+        _bitMask = other._bitMask;
+        _mapping = other._mapping;
+        _mappingLength = other._mappingLength;
+        _nRows = other._nRows;
+        _nCols = other._nCols;
+        other._data = nullptr;
+        other._mapping = nullptr;
+        other._mappingLength = 0;
+        other._stride = 0;
+        other._nRows = 0;
+        other._nCols = 0;
+    }
+    return *this;
 }
 
 /**
- * Return number of columns in grid
- * @return number of columns
+ * Configure nRows x nCols grid of bool initially filled with false
+ * 1) Frees any existing allocation
+ * 2) Allocates storage for the nRows x nCols grid
+ * 3) Initializes it to all false
+ * @param nRows = number of rows
+ * @param nCols = number of columns
  */
-size_t Grid::NumberCols() const {
-    return _nCols;
+void Grid::Configure(size_t nRows, size_t nCols) {
+    Allocate(nRows, nCols);
+    if (_data != nullptr) {
+        memset(_data, 0, _stride * _nRows);
+    }
 }
 
-
 /**
- * Overload [] operator for indexing grid with a GridLocation (for retrieval)
- * @param loc grid location
- * @return true/false stored at that location in grid
+ * Make the storage fit an nRows x nCols grid, leaving the contents undefined
+ * The existing buffer is kept if it is already the right size
+ * @param nRows = number of rows
+ * @param nCols = number of columns
  */
-bool Grid::operator[] (const GridLocation& loc) const {
-    return (bool) _array[loc.Row()][loc.Col()];
-}
+void Grid::Allocate(size_t nRows, size_t nCols) {
+    size_t rowBytes = (_storage == GridStorage::Bits) ? (nCols + 7) / 8 : nCols;
+    size_t stride = (rowBytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
 
-/**
- * Overload [] operator for indexing grid with a GridLocation (for update)
- * @param loc grid location
- * @return settable location fo that location on the grid
- */
-bool& Grid::operator[] (const GridLocation& loc) {
-    return (bool &) _array[loc.Row()][loc.Col()];
+    if (_data == nullptr || stride * nRows != _stride * _nRows) {
+        void* buffer = nullptr;
+
+        Release();
+        if (stride * nRows > 0) {
+            if (posix_memalign(&buffer, CACHE_LINE_SIZE, stride * nRows) != 0) {
+                throw std::bad_alloc();
+            }
+        }
+        _data = (unsigned char*) buffer;
+    }
+    _stride = stride;
+    _nRows = nRows;
+    _nCols = nCols;
 }
 
 /**
- * Determine whether a GridLocaiton is within limits of grid
- * @param loc grid location
- * @return true if within grid, false if not
+ * Free the storage, leaving an 0x0 grid with the same storage mode
  */
-bool Grid::IsWithinGrid(const GridLocation& loc) const {
-    if (loc.Row() < _nRows && loc.Row() >= 0 && loc.Col() < _nCols && loc.Col() >= 0) {
-        return true;
+void Grid::Release() {
+    if (_mapping != nullptr) {
+        munmap(_mapping, _mappingLength);
     }
-    return false;
+    else {
+        free(_data);
+    }
+    _data = nullptr;
+    _mapping = nullptr;
+    _mappingLength = 0;
+    _stride = 0;
+    _nRows = 0;
+    _nCols = 0;
 }
 
 /**
@@ -144,8 +228,9 @@ bool Grid::LoadFromFile(istream& is) {
     string line;
 
     // Read from stream
-    is >> nRows;
-    is >> nCols;
+    if (!(is >> nRows >> nCols)) {
+        return false;
+    }
     getline(is, line);  // Discard remainder of line number of columns is on
     if (nRows <= 0 || nCols <= 0) {
         return false;
@@ -157,8 +242,11 @@ bool Grid::LoadFromFile(istream& is) {
     // Read maze and fill with true/false
     for (size_t row = 0; row < NumberRows(); row++) {
         getline(is, line);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
         if (line.length() != NumberCols()) {
-            //return false;
+            return false;
         }
         for (size_t col = 0; col < NumberCols(); col++) {
             if (line[col] == '@') {
@@ -174,3 +262,368 @@ bool Grid::LoadFromFile(istream& is) {
     }
     return true;
 }
+
+/**
+* Convert a row of '-' (open) and '@' (wall) characters into cell storage, a cell at a time
+* @param text the row's characters
+* @param nCols number of characters
+* @param out the row's storage: a byte per cell, or a bit per cell (low bit first)
+*        with the bytes zeroed beforehand
+* @param bits true for a bit per cell
+* @return false if a character is neither '-' nor '@'
+*/
+static bool ConvertRowScalar(const char* text, size_t nCols, unsigned char* out, bool bits) {
+    unsigned char bad = 0;
+
+    for (size_t col = 0; col < nCols; col++) {
+        unsigned char open = (text[col] == '-');
+
+        bad |= !open & (text[col] != '@');
+        if (bits) {
+            out[col / 8] |= open << (col % 8);
+        }
+        else {
+            out[col] = open;
+        }
+    }
+    return !bad;
+}
+
+#ifdef __SSE2__
+/**
+* SSE2 version of ConvertRowScalar, handling 16 characters per compare
+* @param text the row's characters
+* @param nCols number of characters
+* @param out the row's storage, zeroed beforehand for a bit per cell
+* @param bits true for a bit per cell
+* @return false if a character is neither '-' nor '@'
+*/
+static bool ConvertRowSse2(const char* text, size_t nCols, unsigned char* out, bool bits) {
+    const __m128i dash = _mm_set1_epi8('-');
+    const __m128i at = _mm_set1_epi8('@');
+    const __m128i one = _mm_set1_epi8(1);
+    unsigned bad = 0;
+    size_t col = 0;
+
+    for (; col + 16 <= nCols; col += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*) (text + col));
+        __m128i open = _mm_cmpeq_epi8(chunk, dash);
+        __m128i valid = _mm_or_si128(open, _mm_cmpeq_epi8(chunk, at));
+
+        bad |= ~_mm_movemask_epi8(valid) & 0xFFFF;
+        if (bits) {
+            uint16_t mask = (uint16_t) _mm_movemask_epi8(open);
+            memcpy(out + col / 8, &mask, sizeof(mask));
+        }
+        else {
+            _mm_storeu_si128((__m128i*) (out + col), _mm_and_si128(open, one));
+        }
+    }
+    return ConvertRowScalar(text + col, nCols - col, out + (bits ? col / 8 : col), bits) && !bad;
+}
+#endif
+
+#ifdef GRID_HAVE_AVX2_DISPATCH
+/**
+* AVX2 version of ConvertRowScalar, handling 32 characters per compare
+* @param text the row's characters
+* @param nCols number of characters
+* @param out the row's storage, zeroed beforehand for a bit per cell
+* @param bits true for a bit per cell
+* @return false if a character is neither '-' nor '@'
+*/
+__attribute__((target("avx2")))
+static bool ConvertRowAvx2(const char* text, size_t nCols, unsigned char* out, bool bits) {
+    const __m256i dash = _mm256_set1_epi8('-');
+    const __m256i at = _mm256_set1_epi8('@');
+    const __m256i one = _mm256_set1_epi8(1);
+    uint32_t bad = 0;
+    size_t col = 0;
+
+    for (; col + 32 <= nCols; col += 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*) (text + col));
+        __m256i open = _mm256_cmpeq_epi8(chunk, dash);
+        __m256i valid = _mm256_or_si256(open, _mm256_cmpeq_epi8(chunk, at));
+
+        bad |= ~(uint32_t) _mm256_movemask_epi8(valid);
+        if (bits) {
+            uint32_t mask = (uint32_t) _mm256_movemask_epi8(open);
+            memcpy(out + col / 8, &mask, sizeof(mask));
+        }
+        else {
+            _mm256_storeu_si256((__m256i*) (out + col), _mm256_and_si256(open, one));
+        }
+    }
+    return ConvertRowScalar(text + col, nCols - col, out + (bits ? col / 8 : col), bits) && !bad;
+}
+#endif
+
+typedef bool (*ConvertRowFunction)(const char* text, size_t nCols, unsigned char* out, bool bits);
+
+/**
+* Pick the fastest row conversion the processor supports
+* @return row conversion function
+*/
+static ConvertRowFunction SelectConvertRow() {
+#ifdef GRID_HAVE_AVX2_DISPATCH
+    if (__builtin_cpu_supports("avx2")) {
+        return ConvertRowAvx2;
+    }
+#endif
+#ifdef __SSE2__
+    return ConvertRowSse2;
+#else
+    return ConvertRowScalar;
+#endif
+}
+
+/**
+* Parse a whole maze file held in memory, in the format LoadFromFile reads
+* @param text the file's contents
+* @param length number of bytes
+* @return true if the text is a well formed maze, false if not
+*/
+bool Grid::ParseText(const char* text, size_t length) {
+    static const ConvertRowFunction convertRow = SelectConvertRow();
+    const char* p = text;
+    const char* end = text + length;
+    size_t header[2];
+
+    // Header: number of rows and number of columns, then the rest of the line is ignored
+    for (size_t i = 0; i < 2; i++) {
+        while (p < end && isspace((unsigned char) *p)) {
+            p++;
+        }
+        if (p == end || !isdigit((unsigned char) *p)) {
+            return false;
+        }
+        header[i] = 0;
+        while (p < end && isdigit((unsigned char) *p)) {
+            if (header[i] > (SIZE_MAX - 9) / 10) {
+                return false;
+            }
+            header[i] = header[i] * 10 + (*p++ - '0');
+        }
+    }
+    p = (const char*) memchr(p, '\n', end - p);
+    if (p == nullptr || header[0] == 0 || header[1] == 0) {
+        return false;
+    }
+    p++;
+
+    size_t nRows = header[0];
+    size_t nCols = header[1];
+
+    // Every cell needs a character, so a header promising more than the file
+    // holds is rejected before allocating for it
+    if (nCols > (size_t) (end - p) || nRows > (size_t) (end - p) / nCols) {
+        return false;
+    }
+    Allocate(nRows, nCols);
+
+    size_t rowBytes = (_storage == GridStorage::Bits) ? (nCols + 7) / 8 : nCols;
+    for (size_t row = 0; row < nRows; row++) {
+        unsigned char* out = RowData(row);
+
+        // Each row is exactly nCols characters, then an optional '\r', then '\n'
+        // (or the end of the file, for the last row)
+        if ((size_t) (end - p) < nCols) {
+            return false;
+        }
+        const char* rowEnd = p + nCols;
+        if (rowEnd < end && *rowEnd == '\r') {
+            rowEnd++;
+        }
+        if (rowEnd < end && *rowEnd != '\n') {
+            return false;
+        }
+
+        if (_storage == GridStorage::Bits) {
+            memset(out, 0, _stride);
+        }
+        else {
+            memset(out + rowBytes, 0, _stride - rowBytes);
+        }
+        if (!convertRow(p, nCols, out, _storage == GridStorage::Bits)) {
+            return false;
+        }
+        p = (rowEnd < end) ? rowEnd + 1 : end;
+    }
+    return true;
+}
+
+/**
+* Checksum of the rows of a binary maze file, FNV-1a taken a 64 bit word at a time
+* @param data first row
+* @param length bytes over all rows, a multiple of 8
+* @return checksum
+*/
+static uint64_t BinaryChecksum(const unsigned char* data, size_t length) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+
+    for (size_t i = 0; i < length; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+/**
+* Load grid from a maze file, either the text format LoadFromFile reads or the
+* binary format SaveBinary writes, told apart by the binary format's magic number
+* Text is mapped into memory rather than read through a stream, and each row is
+* converted a vector register at a time.  Rows must be exactly as long as the
+* header says.  Binary files are mapped copy on write and used as the grid's
+* storage as they are, so the grid switches to a bit per cell and the load
+* takes the same time whatever the size of the maze.
+* @param path pathname of the maze file
+* @param verify for binary files, also check the rows against the checksum, which
+*        reads the whole file
+* @return true if the load succeeded, false if the file can't be read or is malformed
+*/
+bool Grid::LoadFromPath(const string& path, bool verify) {
+    struct stat info;
+    char magic[sizeof(MZB_MAGIC)];
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        return false;
+    }
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    size_t length = (size_t) info.st_size;
+    if (pread(fd, magic, sizeof(magic), 0) == (ssize_t) sizeof(magic)
+        && memcmp(magic, MZB_MAGIC, sizeof(magic)) == 0) {
+        bool loaded = MapBinary(fd, length, verify);
+        close(fd);
+        return loaded;
+    }
+
+    void* text = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (text == MAP_FAILED) {
+        return false;
+    }
+    madvise(text, length, MADV_SEQUENTIAL);
+
+    bool loaded = ParseText((const char*) text, length);
+    munmap(text, length);
+    if (!loaded) {
+        Release();
+    }
+    return loaded;
+}
+
+/**
+* Map a binary maze file and make its rows the grid's storage
+* The header must describe rows that fit in the file, and every row must have
+* walls past its last column.  On failure the grid is left as it was.
+* @param fd open file descriptor of the file, starting with the binary magic number
+* @param length size of the file in bytes
+* @param verify check the rows against the checksum, if the file has one
+* @return true if the file is well formed and was mapped
+*/
+bool Grid::MapBinary(int fd, size_t length, bool verify) {
+    BinaryMazeHeader header;
+
+    if (length < sizeof(header) || pread(fd, &header, sizeof(header), 0) != (ssize_t) sizeof(header)) {
+        return false;
+    }
+    if (header.version != MZB_VERSION || header.rows == 0 || header.cols == 0) {
+        return false;
+    }
+    // A row must fit in the file, which also keeps the stride from wrapping
+    // around, and the division keeps rows * stride from doing so
+    size_t rowsLength = length - sizeof(header);
+    if (header.cols > rowsLength / CACHE_LINE_SIZE * CACHE_LINE_SIZE * 8) {
+        return false;
+    }
+    size_t rowBytes = (header.cols + 7) / 8;
+    size_t stride = (rowBytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    if (header.stride != stride || header.rows > rowsLength / stride) {
+        return false;
+    }
+
+    // Private and writable, so the grid can be changed without touching the file
+    void* mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    unsigned char* data = (unsigned char*) mapping + sizeof(header);
+    if (verify && (header.flags & MZB_CHECKSUM) != 0
+        && BinaryChecksum(data, stride * header.rows) != header.checksum) {
+        munmap(mapping, length);
+        return false;
+    }
+
+    // RowWord hands out the last word of a row whole, so the bits past the
+    // last column must be walls
+    if (header.cols % 64 != 0) {
+        uint64_t padding = ~(uint64_t) 0 << (header.cols % 64);
+        size_t last = header.cols / 64 * 8;
+
+        for (size_t row = 0; row < header.rows; row++) {
+            uint64_t bits;
+
+            memcpy(&bits, data + row * stride + last, sizeof(bits));
+            if ((bits & padding) != 0) {
+                munmap(mapping, length);
+                return false;
+            }
+        }
+    }
+
+    Release();
+    _storage = GridStorage::Bits;
+    _shift = 3;
+    _bitMask = 7;
+    _mapping = mapping;
+    _mappingLength = length;
+    _data = data;
+    _stride = stride;
+    _nRows = header.rows;
+    _nCols = header.cols;
+    return true;
+}
+
+/**
+* Save the grid as a binary maze file, which LoadFromPath maps rather than parses
+* @param path pathname of the file to write
+* @param checksum fill in the checksum, which LoadFromPath checks when asked to verify
+* @return true if the file was written, false if not
+*/
+bool Grid::SaveBinary(const string& path, bool checksum) const {
+    size_t rowBytes = (_nCols + 7) / 8;
+    size_t stride = (rowBytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    vector<unsigned char> rows(stride * _nRows, 0);
+    BinaryMazeHeader header;
+
+    // RowWord gives the bit per cell layout in either storage mode, walls past the end
+    for (size_t row = 0; row < _nRows; row++) {
+        for (size_t word = 0; word < WordsPerRow(); word++) {
+            uint64_t bits = RowWord(row, word);
+            memcpy(&rows[row * stride + word * 8], &bits, sizeof(bits));
+        }
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MZB_MAGIC, sizeof(MZB_MAGIC));
+    header.version = MZB_VERSION;
+    header.flags = checksum ? MZB_CHECKSUM : 0;
+    header.rows = _nRows;
+    header.cols = _nCols;
+    header.stride = stride;
+    header.checksum = checksum ? BinaryChecksum(rows.data(), rows.size()) : 0;
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+                   && fwrite(rows.data(), 1, rows.size(), file) == rows.size();
+    return fclose(file) == 0 && written;
+}
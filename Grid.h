@@ -9,8 +9,13 @@
 #ifndef GRID_H
 #define GRID_H
 
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 using std::ostream;
 using std::istream;
 using std::string;
@@ -20,20 +25,44 @@ using namespace std;
 
 #include "GridLocation.h"
 
+// How a grid stores its cells: one byte per cell (fastest single cell access)
+// or one bit per cell (an eighth of the memory, and 64 cells per word access)
+enum class GridStorage { Bytes, Bits };
+
+// The four moves out of a cell
+enum class Direction { North, East, South, West };
+
 class Grid {
 public:
+    class CellReference;
+
     Grid();
+    explicit Grid(GridStorage storage);
+    Grid(const Grid& other);
+    Grid(Grid&& other) noexcept;
     ~Grid();
 
+    Grid& operator=(const Grid& other);
+    Grid& operator=(Grid&& other) noexcept;
+
     void Configure(size_t nRows, size_t nCols);
 
     size_t NumberRows() const;
     size_t NumberCols() const;
+    GridStorage Storage() const;
     bool IsWithinGrid(const GridLocation& loc) const;
 
     bool operator[] (const GridLocation& loc) const;
-    bool& operator[] (const GridLocation& loc);
+    CellReference operator[] (const GridLocation& loc);
     bool LoadFromFile(istream& is);
+    bool LoadFromPath(const string& path, bool verify = false);
+    bool SaveBinary(const string& path, bool checksum = true) const;
+
+    // Word level access: bit i of word w of a row is the cell in column 64 * w + i
+    size_t WordsPerRow() const;
+    uint64_t RowWord(size_t row, size_t word) const;
+    uint64_t NeighborWord(size_t row, size_t word, Direction dir) const;
+    uint64_t OpenNeighborMask(size_t row, size_t word, Direction dir) const;
 
     friend ostream& operator<<(ostream& os, const Grid& grid) {
         for (size_t row = 0; row < grid.NumberRows(); row ++) {
@@ -50,17 +79,252 @@ public:
         return os;
     }
 
+    // Settable location of one cell, returned by the non-const [] operator.
+    // Behaves like a bool& for both storage modes.
+    class CellReference {
+    public:
+        operator bool() const;
+        CellReference& operator=(bool value);
+        CellReference& operator=(const CellReference& other);
+
+    private:
+        friend class Grid;
+        CellReference(unsigned char* byte, unsigned char mask);
+
+        unsigned char* _byte;
+        unsigned char _mask;
+    };
+
 private:
-    // Declared private since not needed
-    Grid(const Grid& other);
-    const Grid& operator=(const Grid& other);
+    void Allocate(size_t nRows, size_t nCols);
+    void Release();
+    bool ParseText(const char* text, size_t length);
+    bool MapBinary(int fd, size_t length, bool verify);
+    const unsigned char* RowData(size_t row) const;
+    unsigned char* RowData(size_t row);
 
-    // Declare your data structure here
-    bool** _array;
+    // Cells are stored row after row in one aligned buffer, a byte or a bit per
+    // cell depending on _storage.  Each row is padded out to _stride bytes (a
+    // multiple of the cache line size) so that rows start on cache line
+    // boundaries; padding cells are always false.  Column col lives in bit
+    // (col & _bitMask) of byte (col >> _shift): _shift is 0 for a byte per cell,
+    // which the accessors test first so that mode stays a single load or store.
+    unsigned char* _data;
+    size_t _stride;
+    GridStorage _storage;
+    unsigned _shift;
+    unsigned _bitMask;
+
+    // When the cells were mapped straight from a binary maze file, the whole
+    // mapping (header included), which is unmapped rather than freed
+    void* _mapping;
+    size_t _mappingLength;
 
     size_t _nRows;
     size_t _nCols;
 
 };
 
+// Accessors sit on the solver's inner loop, so they are defined inline
+
+/**
+ * Return number of rows in grid
+ * @return number of rows
+ */
+inline size_t Grid::NumberRows() const {
+    return _nRows;
+}
+
+/**
+ * Return number of columns in grid
+ * @return number of columns
+ */
+inline size_t Grid::NumberCols() const {
+    return _nCols;
+}
+
+/**
+ * Return how the grid stores its cells
+ * @return byte per cell or bit per cell
+ */
+inline GridStorage Grid::Storage() const {
+    return _storage;
+}
+
+/**
+ * Return start of the storage for a row
+ * @param row row number
+ * @return pointer to first byte of the row
+ */
+inline const unsigned char* Grid::RowData(size_t row) const {
+    return _data + row * _stride;
+}
+
+/**
+ * Return start of the storage for a row
+ * @param row row number
+ * @return pointer to first byte of the row
+ */
+inline unsigned char* Grid::RowData(size_t row) {
+    return _data + row * _stride;
+}
+
+/**
+ * Overload [] operator for indexing grid with a GridLocation (for retrieval)
+ * @param loc grid location
+ * @return true/false stored at that location in grid
+ */
+inline bool Grid::operator[] (const GridLocation& loc) const {
+    if (_shift == 0) {
+        return RowData(loc.Row())[loc.Col()];
+    }
+    return (RowData(loc.Row())[loc.Col() >> _shift] >> (loc.Col() & _bitMask)) & 1;
+}
+
+/**
+ * Overload [] operator for indexing grid with a GridLocation (for update)
+ * @param loc grid location
+ * @return settable location fo that location on the grid
+ */
+inline Grid::CellReference Grid::operator[] (const GridLocation& loc) {
+    if (_shift == 0) {
+        return CellReference(&RowData(loc.Row())[loc.Col()], 0);
+    }
+    return CellReference(&RowData(loc.Row())[loc.Col() >> _shift], (unsigned char) (1u << (loc.Col() & _bitMask)));
+}
+
+/**
+ * Determine whether a GridLocaiton is within limits of grid
+ * @param loc grid location
+ * @return true if within grid, false if not
+ */
+inline bool Grid::IsWithinGrid(const GridLocation& loc) const {
+    // Row() and Col() are unsigned, so a step off the top or left edge wraps
+    // around to a huge value and fails the upper bound test
+    return loc.Row() < _nRows && loc.Col() < _nCols;
+}
+
+/**
+ * Return number of 64 cell words needed to hold one row
+ * @return words per row
+ */
+inline size_t Grid::WordsPerRow() const {
+    return (_nCols + 63) / 64;
+}
+
+/**
+ * Return 64 cells of a row as a bit mask, bit i set if column 64 * word + i is open
+ * Columns past the end of the row read as walls
+ * @param row row number, must be within the grid
+ * @param word word number, must be less than WordsPerRow()
+ * @return open cell mask
+ */
+inline uint64_t Grid::RowWord(size_t row, size_t word) const {
+    if (_storage == GridStorage::Bits) {
+        // Bits are numbered from the low bit of the first byte, which is the
+        // word's own bit order on the little endian machines we run on
+        uint64_t bits;
+        memcpy(&bits, RowData(row) + word * 8, sizeof(bits));
+        return bits;
+    }
+
+    // Padding keeps all 64 bytes within the row, and rows are 64 byte aligned
+    const unsigned char* bytes = RowData(row) + word * 64;
+    uint64_t mask = 0;
+#ifdef __SSE2__
+    const __m128i zero = _mm_setzero_si128();
+    for (unsigned i = 0; i < 4; i++) {
+        __m128i chunk = _mm_load_si128((const __m128i*) (bytes + 16 * i));
+        uint64_t walls = (uint64_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zero));
+        mask |= (~walls & 0xFFFF) << (16 * i);
+    }
+#else
+    for (unsigned i = 0; i < 64; i++) {
+        mask |= uint64_t(bytes[i] != 0) << i;
+    }
+#endif
+    return mask;
+}
+
+/**
+ * Return a mask of which of 64 cells have an open neighbor in one direction
+ * Bit i is set if the cell one step "dir" from column 64 * word + i is within the
+ * grid and open, whatever the cell itself holds
+ * @param row row number, must be within the grid
+ * @param word word number, must be less than WordsPerRow()
+ * @param dir direction of the neighbor
+ * @return open neighbor mask
+ */
+inline uint64_t Grid::NeighborWord(size_t row, size_t word, Direction dir) const {
+    switch (dir) {
+        case Direction::North:
+            return row > 0 ? RowWord(row - 1, word) : 0;
+        case Direction::South:
+            return row + 1 < _nRows ? RowWord(row + 1, word) : 0;
+        case Direction::East:
+            return (RowWord(row, word) >> 1)
+                   | (word + 1 < WordsPerRow() ? RowWord(row, word + 1) << 63 : 0);
+        case Direction::West:
+            return (RowWord(row, word) << 1)
+                   | (word > 0 ? RowWord(row, word - 1) >> 63 : 0);
+    }
+    return 0;
+}
+
+/**
+ * Return a mask of which of 64 cells are open and can move one step in a direction
+ * @param row row number, must be within the grid
+ * @param word word number, must be less than WordsPerRow()
+ * @param dir direction of the move
+ * @return mask of open cells whose neighbor in that direction is open
+ */
+inline uint64_t Grid::OpenNeighborMask(size_t row, size_t word, Direction dir) const {
+    return RowWord(row, word) & NeighborWord(row, word, dir);
+}
+
+/**
+ * Read the cell value
+ * @return true if open, false if a wall
+ */
+inline Grid::CellReference::operator bool() const {
+    if (_mask == 0) {
+        return *_byte != 0;
+    }
+    return (*_byte & _mask) != 0;
+}
+
+/**
+ * Set the cell value
+ * @param value true for open, false for a wall
+ * @return this reference
+ */
+inline Grid::CellReference& Grid::CellReference::operator=(bool value) {
+    if (_mask == 0) {
+        *_byte = value;
+    }
+    else {
+        *_byte = value ? (*_byte | _mask) : (*_byte & ~_mask);
+    }
+    return *this;
+}
+
+/**
+ * Set the cell value from another cell, as in grid[a] = grid[b]
+ * @param other cell to copy the value of
+ * @return this reference
+ */
+inline Grid::CellReference& Grid::CellReference::operator=(const CellReference& other) {
+    return *this = (bool) other;
+}
+
+/**
+ * Constructor, used by the non-const [] operator
+ * @param byte the byte holding the cell
+ * @param mask the cell's bit within the byte, or 0 for byte per cell storage
+ */
+inline Grid::CellReference::CellReference(unsigned char* byte, unsigned char mask) {
+    _byte = byte;
+    _mask = mask;
+}
+
 #endif //GRID_H
@@ -9,43 +9,6 @@
 #include <cassert>
 #include "GridLocation.h"
 
-/**
- * Default constructor
- * Creates an location of (0,0)
- */
-GridLocation::GridLocation() {
-    _row = 0;
-    _col = 0;
-
-}
-
-/**
- * Constructor
- * Creates a specific location
- * @param row - row number
- * @param col - column number
- */
-GridLocation::GridLocation(size_t row, size_t col) {
-    _row = row;
-    _col = col;
-}
-
-/**
- * Returns row number
- * @return row
- */
-size_t GridLocation::Row() const {
-    return _row;
-}
-
-/**
- * Returns column number
- * @return column
- */
-size_t GridLocation::Col() const {
-    return _col;
-}
-
 /**
  * Return a string-ized version of a GridLocation object
  * @return string
@@ -66,10 +29,10 @@ string GridLocation::ToString() const {
  * @returns true or false
  */
 bool operator <(const GridLocation &lhs, const GridLocation& rhs) {
-    if (lhs._row < rhs._row || lhs._col < rhs._col) {
-        return true;
+    if (lhs._row != rhs._row) {
+        return lhs._row < rhs._row;
     }
-    return false;
+    return lhs._col < rhs._col;
 }
 
 /*
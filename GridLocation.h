@@ -7,17 +7,18 @@
 #ifndef GRIDLOCATION_H
 #define GRIDLOCATION_H
 
+#include <cstddef>
 #include <string>
 using std::string;
 using std::to_string;
 
 class GridLocation {
 public:
-    GridLocation();
-    GridLocation(size_t row, size_t col);
+    constexpr GridLocation();
+    constexpr GridLocation(size_t row, size_t col);
 
-    size_t Row() const;
-    size_t Col() const;
+    constexpr size_t Row() const;
+    constexpr size_t Col() const;
 
     string ToString() const;
 
@@ -29,5 +30,39 @@ private:
     size_t _col;
 };
 
+// Defined here, and constexpr, so that CellLayout can convert to and from
+// cell handles at compile time
+
+/**
+ * Default constructor
+ * Creates an location of (0,0)
+ */
+constexpr GridLocation::GridLocation() : _row(0), _col(0) {
+}
+
+/**
+ * Constructor
+ * Creates a specific location
+ * @param row - row number
+ * @param col - column number
+ */
+constexpr GridLocation::GridLocation(size_t row, size_t col) : _row(row), _col(col) {
+}
+
+/**
+ * Returns row number
+ * @return row
+ */
+constexpr size_t GridLocation::Row() const {
+    return _row;
+}
+
+/**
+ * Returns column number
+ * @return column
+ */
+constexpr size_t GridLocation::Col() const {
+    return _col;
+}
 
 #endif //GRIDLOCATION_H
@@ -0,0 +1,1165 @@
+//
+// Method implementation for the HierarchicalGraph Class
+// Date: 10/18/2026
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include "HierarchicalGraph.h"
+#include "CursesWindow.h"
+#include "Maze.h"
+#include "ThreadPool.h"
+
+const size_t HierarchicalGraph::DEFAULT_CLUSTER_SIZE;
+const size_t HierarchicalGraph::SUPER_CLUSTER_SIZE;
+const unsigned HierarchicalGraph::NUMBER_LANDMARKS;
+const uint32_t HierarchicalGraph::NO_NODE;
+
+// An entrance this many cells wide or wider gets a node at each end rather than
+// one in the middle, so routes along the border don't detour through the middle
+static const uint32_t WIDE_ENTRANCE = 6;
+
+/**
+ * Constructor
+ * Takes over a maze, finds the entrances between its clusters and measures the
+ * routes between the entrances of each cluster, the clusters shared out over
+ * a pool of threads, then builds the second level and the landmarks on top
+ * @param maze the maze to answer queries on
+ * @param clusterSize width and height of a cluster, at least 2
+ * @param nThreads number of threads to measure clusters on; 0 means one per hardware thread
+ */
+HierarchicalGraph::HierarchicalGraph(Grid maze, size_t clusterSize, unsigned nThreads) : _maze(std::move(maze)) {
+    size_t nRows = _maze.NumberRows();
+    size_t nCols = _maze.NumberCols();
+
+    assert(clusterSize >= 2 && nRows * nCols < UINT32_MAX);
+    _clusterSize = clusterSize;
+    _clusterRows = (nRows + clusterSize - 1) / clusterSize;
+    _clusterCols = (nCols + clusterSize - 1) / clusterSize;
+
+    // Nodes are the cells on either side of each entrance, grouped by cluster
+    vector<pair<uint32_t, uint32_t>> transitions;
+    vector<pair<uint32_t, uint32_t>> keyed;
+    FindEntrances(transitions);
+    for (const auto& transition : transitions) {
+        keyed.push_back(std::make_pair(ClusterOf(transition.first), transition.first));
+        keyed.push_back(std::make_pair(ClusterOf(transition.second), transition.second));
+    }
+    std::sort(keyed.begin(), keyed.end());
+    keyed.erase(std::unique(keyed.begin(), keyed.end()), keyed.end());
+    assert(keyed.size() + 2 < NO_NODE);
+
+    _clusterBegin.assign(NumberClusters() + 1, 0);
+    _nodeCell.resize(keyed.size());
+    _nodeCluster.resize(keyed.size());
+    _nodeRow.resize(keyed.size());
+    _nodeCol.resize(keyed.size());
+    for (size_t node = 0; node < keyed.size(); node++) {
+        _nodeCell[node] = keyed[node].second;
+        _nodeCluster[node] = keyed[node].first;
+        _nodeRow[node] = (uint32_t) (keyed[node].second / nCols);
+        _nodeCol[node] = (uint32_t) (keyed[node].second % nCols);
+        _clusterBegin[keyed[node].first + 1]++;
+    }
+    for (size_t cluster = 0; cluster < NumberClusters(); cluster++) {
+        _clusterBegin[cluster + 1] += _clusterBegin[cluster];
+    }
+
+    // Each transition is an edge of one move, in both directions
+    vector<uint32_t> endpoints;
+    _interBegin.assign(_nodeCell.size() + 1, 0);
+    for (const auto& transition : transitions) {
+        uint32_t a = (uint32_t) (std::lower_bound(keyed.begin(), keyed.end(), std::make_pair(ClusterOf(transition.first), transition.first)) - keyed.begin());
+        uint32_t b = (uint32_t) (std::lower_bound(keyed.begin(), keyed.end(), std::make_pair(ClusterOf(transition.second), transition.second)) - keyed.begin());
+
+        endpoints.push_back(a);
+        endpoints.push_back(b);
+        _interBegin[a + 1]++;
+        _interBegin[b + 1]++;
+    }
+    for (size_t node = 0; node < _nodeCell.size(); node++) {
+        _interBegin[node + 1] += _interBegin[node];
+    }
+    vector<uint32_t> fill(_interBegin.begin(), _interBegin.end() - 1);
+    _interTarget.resize(endpoints.size());
+    for (size_t i = 0; i < endpoints.size(); i += 2) {
+        _interTarget[fill[endpoints[i]]++] = endpoints[i + 1];
+        _interTarget[fill[endpoints[i + 1]]++] = endpoints[i];
+    }
+    _nEdges = _interTarget.size();
+
+    ComputeIntraLengths(nThreads);
+    LabelComponents();
+    BuildLevelTwo(nThreads);
+    ComputeLandmarks(nThreads);
+
+    // Query state, two extra nodes for the start and the goal
+    _nodeRow.resize(StartNode() + 2);
+    _nodeCol.resize(StartNode() + 2);
+    _startCell = 0;
+    _goalCell = 0;
+    _startSuper = NO_NODE;
+    _goalSuper = NO_NODE;
+    _direct = UNREACHABLE;
+    _targetRow = 0;
+    _targetCol = 0;
+    std::fill(_targetLandmark, _targetLandmark + NUMBER_LANDMARKS, 0);
+    _cost.resize(StartNode() + 2);
+    _parent.resize(StartNode() + 2);
+    _estimate.resize(StartNode() + 2);
+    _stamp.assign(StartNode() + 2, 0);
+    _epoch = 0;
+    PrepareScratch(_scratch);
+}
+
+/**
+ * Find the entrances between neighboring clusters
+ * An entrance is a run of open cells along the border of two clusters whose
+ * neighbors across the border are open too.
+ * @param transitions receives the pairs of cells, one on each side of the border,
+ *        that the abstract graph may cross an entrance by
+ */
+void HierarchicalGraph::FindEntrances(vector<pair<uint32_t, uint32_t>>& transitions) const {
+    size_t nRows = _maze.NumberRows();
+    size_t nCols = _maze.NumberCols();
+
+    // Between clusters side by side, column x on the left and x + 1 on the right
+    for (size_t x = _clusterSize - 1; x + 1 < nCols; x += _clusterSize) {
+        for (size_t top = 0; top < nRows; top += _clusterSize) {
+            size_t bottom = std::min(top + _clusterSize, nRows);
+
+            for (size_t row = top; row < bottom; row++) {
+                if (_maze[GridLocation(row, x)] && _maze[GridLocation(row, x + 1)]) {
+                    size_t begin = row;
+
+                    while (row + 1 < bottom && _maze[GridLocation(row + 1, x)] && _maze[GridLocation(row + 1, x + 1)]) {
+                        row++;
+                    }
+                    AddEntrance((uint32_t) (begin * nCols + x), (uint32_t) (row * nCols + x), (uint32_t) nCols, 1, transitions);
+                }
+            }
+        }
+    }
+
+    // Between clusters one above the other, row y above and y + 1 below
+    for (size_t y = _clusterSize - 1; y + 1 < nRows; y += _clusterSize) {
+        for (size_t left = 0; left < nCols; left += _clusterSize) {
+            size_t right = std::min(left + _clusterSize, nCols);
+
+            for (size_t col = left; col < right; col++) {
+                if (_maze[GridLocation(y, col)] && _maze[GridLocation(y + 1, col)]) {
+                    size_t begin = col;
+
+                    while (col + 1 < right && _maze[GridLocation(y, col + 1)] && _maze[GridLocation(y + 1, col + 1)]) {
+                        col++;
+                    }
+                    AddEntrance((uint32_t) (y * nCols + begin), (uint32_t) (y * nCols + col), 1, (uint32_t) nCols, transitions);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Choose the transitions of one entrance: the middle of a narrow one, both ends of a wide one
+ * @param first first cell of the entrance on the near side of the border
+ * @param last last cell of the entrance on the near side
+ * @param step distance between cells along the entrance
+ * @param across distance from a cell to its neighbor across the border
+ * @param transitions receives the pairs of cells chosen
+ */
+void HierarchicalGraph::AddEntrance(uint32_t first, uint32_t last, uint32_t step, uint32_t across, vector<pair<uint32_t, uint32_t>>& transitions) const {
+    uint32_t width = (last - first) / step + 1;
+
+    if (width < WIDE_ENTRANCE) {
+        uint32_t middle = first + (width / 2) * step;
+        transitions.push_back(std::make_pair(middle, middle + across));
+    }
+    else {
+        transitions.push_back(std::make_pair(first, first + across));
+        transitions.push_back(std::make_pair(last, last + across));
+    }
+}
+
+/**
+ * Fill in each cluster's matrix of routes between its nodes, with one breadth
+ * first search per node confined to the cluster
+ * Clusters are independent, so threads take them one at a time from a shared counter.
+ * @param nThreads number of threads; 0 means one per hardware thread
+ */
+void HierarchicalGraph::ComputeIntraLengths(unsigned nThreads) {
+    _matrixBegin.assign(NumberClusters() + 1, 0);
+    for (size_t cluster = 0; cluster < NumberClusters(); cluster++) {
+        size_t k = _clusterBegin[cluster + 1] - _clusterBegin[cluster];
+        _matrixBegin[cluster + 1] = _matrixBegin[cluster] + k * k;
+    }
+    _intraLength.assign(_matrixBegin.back(), UNREACHABLE);
+
+    ThreadPool pool(nThreads);
+    std::atomic<size_t> next(0);
+    vector<size_t> edges(pool.NumberThreads(), 0);
+
+    pool.Run([&](unsigned thread) {
+        ClusterScratch scratch;
+
+        PrepareScratch(scratch);
+        for (size_t cluster = next++; cluster < NumberClusters(); cluster = next++) {
+            uint32_t begin = _clusterBegin[cluster];
+            uint32_t k = _clusterBegin[cluster + 1] - begin;
+            uint32_t* matrix = _intraLength.data() + _matrixBegin[cluster];
+
+            LoadCluster((uint32_t) cluster, scratch);
+            for (uint32_t i = 0; i < k; i++) {
+                SearchCluster((uint32_t) cluster, _nodeCell[begin + i], scratch);
+                for (uint32_t j = 0; j < k; j++) {
+                    matrix[i * k + j] = scratch.distance[LocalIndex((uint32_t) cluster, _nodeCell[begin + j])];
+                    edges[thread] += (j != i && matrix[i * k + j] != UNREACHABLE);
+                }
+            }
+        }
+    });
+    for (size_t count : edges) {
+        _nEdges += count;
+    }
+}
+
+/**
+ * Label each node with its connected component in the abstract graph, so a
+ * query between components can be turned down without a search
+ */
+void HierarchicalGraph::LabelComponents() {
+    vector<uint32_t> pending;
+    uint32_t nComponents = 0;
+
+    _nodeComponent.assign(_nodeCell.size(), NO_NODE);
+    for (uint32_t seed = 0; seed < _nodeCell.size(); seed++) {
+        if (_nodeComponent[seed] != NO_NODE) {
+            continue;
+        }
+        _nodeComponent[seed] = nComponents;
+        pending.push_back(seed);
+        while (!pending.empty()) {
+            uint32_t node = pending.back();
+            uint32_t cluster = _nodeCluster[node];
+            uint32_t begin = _clusterBegin[cluster];
+            uint32_t k = _clusterBegin[cluster + 1] - begin;
+            const uint32_t* row = _intraLength.data() + _matrixBegin[cluster] + (node - begin) * k;
+
+            pending.pop_back();
+            for (uint32_t j = 0; j < k; j++) {
+                if (row[j] != UNREACHABLE && _nodeComponent[begin + j] == NO_NODE) {
+                    _nodeComponent[begin + j] = nComponents;
+                    pending.push_back(begin + j);
+                }
+            }
+            for (uint32_t edge = _interBegin[node]; edge < _interBegin[node + 1]; edge++) {
+                if (_nodeComponent[_interTarget[edge]] == NO_NODE) {
+                    _nodeComponent[_interTarget[edge]] = nComponents;
+                    pending.push_back(_interTarget[edge]);
+                }
+            }
+        }
+        nComponents++;
+    }
+}
+
+/**
+ * Build the second level: group the clusters into super clusters, keep one
+ * edge crossing each entrance between super clusters, and measure the first level routes between the nodes of each
+ * super cluster, the super clusters shared out over a pool of threads
+ * @param nThreads number of threads; 0 means one per hardware thread
+ */
+void HierarchicalGraph::BuildLevelTwo(unsigned nThreads) {
+    size_t nCols = _maze.NumberCols();
+    size_t span = SUPER_CLUSTER_SIZE * _clusterSize;
+
+    _superRows = (_clusterRows + SUPER_CLUSTER_SIZE - 1) / SUPER_CLUSTER_SIZE;
+    _superCols = (_clusterCols + SUPER_CLUSTER_SIZE - 1) / SUPER_CLUSTER_SIZE;
+    _nodeSuper.resize(_nodeCell.size());
+    for (size_t node = 0; node < _nodeCell.size(); node++) {
+        _nodeSuper[node] = SuperOf(_nodeCluster[node]);
+    }
+
+    // The edges crossing between super clusters, keyed by the border line they
+    // cross (columns first, then rows) and their position along it, each with
+    // its node on the left or upper side first
+    vector<pair<uint64_t, pair<uint32_t, uint32_t>>> crossings;
+    for (uint32_t node = 0; node < _nodeCell.size(); node++) {
+        for (uint32_t edge = _interBegin[node]; edge < _interBegin[node + 1]; edge++) {
+            uint32_t target = _interTarget[edge];
+            uint32_t near = _nodeCell[node];
+
+            if (_nodeSuper[target] != _nodeSuper[node] && near < _nodeCell[target]) {
+                uint64_t key = (_nodeCell[target] - near == nCols)
+                               ? ((uint64_t) (nCols + near / nCols) << 32) | (near % nCols)
+                               : ((uint64_t) (near % nCols) << 32) | (near / nCols);
+                crossings.push_back(std::make_pair(key, std::make_pair(node, target)));
+            }
+        }
+    }
+    std::sort(crossings.begin(), crossings.end());
+
+    // Crossings of one entrance lie on the same line, on the same side of any
+    // super cluster corner, with open cells on both sides all the way between.
+    // The second level keeps only the middle one, however wide the entrance:
+    // the routes come out hardly any longer, and the searches far quicker.
+    vector<pair<uint32_t, uint32_t>> kept;
+    for (size_t first = 0; first < crossings.size(); ) {
+        size_t last = first;
+
+        while (last + 1 < crossings.size() && crossings[last + 1].first >> 32 == crossings[first].first >> 32
+               && (uint32_t) crossings[last + 1].first / span == (uint32_t) crossings[first].first / span) {
+            uint64_t line = crossings[first].first >> 32;
+            uint32_t position = (uint32_t) crossings[last].first + 1;
+            uint32_t end = (uint32_t) crossings[last + 1].first;
+
+            for (; position < end; position++) {
+                GridLocation near = (line >= nCols) ? GridLocation(line - nCols, position) : GridLocation(position, line);
+                GridLocation far = (line >= nCols) ? GridLocation(near.Row() + 1, position) : GridLocation(position, line + 1);
+
+                if (!_maze[near] || !_maze[far]) {
+                    break;
+                }
+            }
+            if (position < end) {
+                break;
+            }
+            last++;
+        }
+        kept.push_back(crossings[first + (last - first) / 2].second);
+        first = last + 1;
+    }
+
+    // Second level nodes are the nodes of the crossings kept, grouped by super cluster
+    vector<pair<uint32_t, uint32_t>> keyed;
+    for (const auto& crossing : kept) {
+        keyed.push_back(std::make_pair(_nodeSuper[crossing.first], crossing.first));
+        keyed.push_back(std::make_pair(_nodeSuper[crossing.second], crossing.second));
+    }
+    std::sort(keyed.begin(), keyed.end());
+    keyed.erase(std::unique(keyed.begin(), keyed.end()), keyed.end());
+
+    _superBegin.assign(_superRows * _superCols + 1, 0);
+    _levelTwoNode.resize(keyed.size());
+    _levelTwoSlot.assign(_nodeCell.size(), NO_NODE);
+    for (uint32_t slot = 0; slot < keyed.size(); slot++) {
+        _levelTwoNode[slot] = keyed[slot].second;
+        _levelTwoSlot[keyed[slot].second] = slot;
+        _superBegin[keyed[slot].first + 1]++;
+    }
+    for (size_t super = 0; super + 1 < _superBegin.size(); super++) {
+        _superBegin[super + 1] += _superBegin[super];
+    }
+
+    _crossingBegin.assign(keyed.size() + 1, 0);
+    for (const auto& crossing : kept) {
+        _crossingBegin[_levelTwoSlot[crossing.first] + 1]++;
+        _crossingBegin[_levelTwoSlot[crossing.second] + 1]++;
+    }
+    for (size_t slot = 0; slot < keyed.size(); slot++) {
+        _crossingBegin[slot + 1] += _crossingBegin[slot];
+    }
+    vector<uint32_t> fill(_crossingBegin.begin(), _crossingBegin.end() - 1);
+    _crossingTarget.resize(2 * kept.size());
+    for (const auto& crossing : kept) {
+        _crossingTarget[fill[_levelTwoSlot[crossing.first]]++] = crossing.second;
+        _crossingTarget[fill[_levelTwoSlot[crossing.second]]++] = crossing.first;
+    }
+
+    // A query searches the second level nodes under numbers of their own, after
+    // the first level's, so those of a super cluster are side by side in memory
+    for (uint32_t node : _levelTwoNode) {
+        _nodeRow.push_back(_nodeRow[node]);
+        _nodeCol.push_back(_nodeCol[node]);
+    }
+
+    // Matrices of the routes between the second level nodes of each super cluster
+    size_t nSupers = _superRows * _superCols;
+    _superMatrixBegin.assign(nSupers + 1, 0);
+    for (size_t super = 0; super < nSupers; super++) {
+        size_t k = _superBegin[super + 1] - _superBegin[super];
+        _superMatrixBegin[super + 1] = _superMatrixBegin[super] + k * k;
+    }
+    _superLength.assign(_superMatrixBegin.back(), UNREACHABLE);
+
+    ThreadPool pool(nThreads);
+    std::atomic<size_t> next(0);
+
+    pool.Run([&](unsigned) {
+        NodeScratch scratch;
+
+        PrepareNodeScratch(scratch);
+        for (size_t super = next++; super < nSupers; super = next++) {
+            uint32_t begin = _superBegin[super];
+            uint32_t k = _superBegin[super + 1] - begin;
+            uint32_t* matrix = _superLength.data() + _superMatrixBegin[super];
+
+            for (uint32_t i = 0; i < k; i++) {
+                MeasureFrom(_levelTwoNode[begin + i], (uint32_t) super, scratch);
+                for (uint32_t j = 0; j < k; j++) {
+                    uint32_t node = _levelTwoNode[begin + j];
+
+                    matrix[i * k + j] = (scratch.stamp[node] == scratch.epoch) ? scratch.cost[node] : UNREACHABLE;
+                }
+            }
+        }
+    });
+}
+
+/**
+ * Measure the distances from the landmarks: the nodes closest to the corners of
+ * the maze and the middles of its sides, one landmark to a thread at a time
+ * @param nThreads number of threads; 0 means one per hardware thread
+ */
+void HierarchicalGraph::ComputeLandmarks(unsigned nThreads) {
+    size_t lastRow = _maze.NumberRows() - 1;
+    size_t lastCol = _maze.NumberCols() - 1;
+    const size_t spots[NUMBER_LANDMARKS][2] = {
+        { 0, 0 }, { 0, lastCol }, { lastRow, 0 }, { lastRow, lastCol },
+        { 0, lastCol / 2 }, { lastRow / 2, 0 }, { lastRow, lastCol / 2 }, { lastRow / 2, lastCol }
+    };
+    uint32_t landmarks[NUMBER_LANDMARKS];
+
+    _landmarkLength.assign((_nodeCell.size() + _levelTwoNode.size()) * NUMBER_LANDMARKS, UINT16_MAX);
+    if (_nodeCell.empty()) {
+        return;
+    }
+    for (unsigned i = 0; i < NUMBER_LANDMARKS; i++) {
+        size_t best = SIZE_MAX;
+
+        for (uint32_t node = 0; node < _nodeCell.size(); node++) {
+            size_t distance = (_nodeRow[node] > spots[i][0] ? _nodeRow[node] - spots[i][0] : spots[i][0] - _nodeRow[node])
+                              + (_nodeCol[node] > spots[i][1] ? _nodeCol[node] - spots[i][1] : spots[i][1] - _nodeCol[node]);
+            if (distance < best) {
+                best = distance;
+                landmarks[i] = node;
+            }
+        }
+    }
+
+    ThreadPool pool(nThreads);
+    std::atomic<unsigned> next(0);
+
+    pool.Run([&](unsigned) {
+        NodeScratch scratch;
+
+        PrepareNodeScratch(scratch);
+        for (unsigned i = next++; i < NUMBER_LANDMARKS; i = next++) {
+            MeasureFrom(landmarks[i], NO_NODE, scratch);
+            for (size_t node = 0; node < _nodeCell.size(); node++) {
+                if (scratch.stamp[node] == scratch.epoch) {
+                    _landmarkLength[node * NUMBER_LANDMARKS + i] = (uint16_t) std::min<uint32_t>(scratch.cost[node], UINT16_MAX);
+                }
+            }
+        }
+    });
+    for (size_t slot = 0; slot < _levelTwoNode.size(); slot++) {
+        std::copy_n(&_landmarkLength[_levelTwoNode[slot] * NUMBER_LANDMARKS], NUMBER_LANDMARKS,
+                    &_landmarkLength[(_nodeCell.size() + slot) * NUMBER_LANDMARKS]);
+    }
+}
+
+/**
+ * Size the buffers of a node search for the graph
+ * @param scratch the search state
+ */
+void HierarchicalGraph::PrepareNodeScratch(NodeScratch& scratch) const {
+    scratch.cost.resize(_nodeCell.size());
+    scratch.stamp.assign(_nodeCell.size(), 0);
+    scratch.epoch = 0;
+}
+
+/**
+ * Dijkstra over the first level from a node, optionally without leaving a super cluster
+ * @param source node to measure from
+ * @param super super cluster to stay in, or NO_NODE to search the whole graph
+ * @param scratch receives the distance to each node reached, which has its
+ *        stamp equal to the epoch
+ */
+void HierarchicalGraph::MeasureFrom(uint32_t source, uint32_t super, NodeScratch& scratch) const {
+    if (++scratch.epoch == 0) {
+        std::fill(scratch.stamp.begin(), scratch.stamp.end(), 0);
+        scratch.epoch = 1;
+    }
+
+    auto reach = [&scratch](uint32_t node, uint32_t cost) {
+        if (scratch.stamp[node] != scratch.epoch || cost < scratch.cost[node]) {
+            scratch.stamp[node] = scratch.epoch;
+            scratch.cost[node] = cost;
+            scratch.open.Push(cost, node);
+        }
+    };
+
+    scratch.open.Clear();
+    reach(source, 0);
+    while (!scratch.open.Empty()) {
+        uint32_t cost;
+        uint32_t node = scratch.open.Pop(cost);
+
+        if (cost != scratch.cost[node]) {
+            continue;
+        }
+
+        uint32_t cluster = _nodeCluster[node];
+        uint32_t begin = _clusterBegin[cluster];
+        uint32_t k = _clusterBegin[cluster + 1] - begin;
+        const uint32_t* row = _intraLength.data() + _matrixBegin[cluster] + (node - begin) * k;
+
+        for (uint32_t j = 0; j < k; j++) {
+            if (row[j] != UNREACHABLE) {
+                reach(begin + j, cost + row[j]);
+            }
+        }
+        for (uint32_t edge = _interBegin[node]; edge < _interBegin[node + 1]; edge++) {
+            if (super == NO_NODE || _nodeSuper[_interTarget[edge]] == super) {
+                reach(_interTarget[edge], cost + 1);
+            }
+        }
+    }
+}
+
+/**
+ * Return the number of bytes the abstract graph and the query state take up,
+ * not counting the maze itself
+ * @return number of bytes
+ */
+size_t HierarchicalGraph::MemoryBytes() const {
+    return sizeof(uint32_t) * (_nodeCell.capacity() + _clusterBegin.capacity() + _intraLength.capacity()
+                               + _nodeCluster.capacity() + _nodeRow.capacity() + _nodeCol.capacity()
+                               + _interBegin.capacity() + _interTarget.capacity() + _nodeComponent.capacity()
+                               + _startLength.capacity() + _goalLength.capacity() + _cost.capacity() + _estimate.capacity()
+                               + _parent.capacity() + _stamp.capacity() + _path.capacity() + _hops.capacity()
+                               + _scratch.distance.capacity() + _scratch.queue.capacity()
+                               + _nodeSuper.capacity() + _levelTwoSlot.capacity() + _levelTwoNode.capacity()
+                               + _superBegin.capacity() + _superLength.capacity() + _crossingBegin.capacity()
+                               + _crossingTarget.capacity())
+           + sizeof(size_t) * (_matrixBegin.capacity() + _superMatrixBegin.capacity())
+           + sizeof(uint16_t) * _landmarkLength.capacity() + sizeof(GridLocation) * _route.capacity()
+           + sizeof(uint32_t) * (_scratch.now.capacity() + _scratch.later.capacity())
+           + sizeof(uint64_t) * _scratch.rows.capacity() + _scratch.open.capacity() + _scratch.came.capacity();
+}
+
+/**
+ * Return the cluster a cell belongs to
+ * @param cell linear index of the cell, row * cols + col
+ * @return cluster number, cluster row * cluster columns + cluster column
+ */
+inline uint32_t HierarchicalGraph::ClusterOf(uint32_t cell) const {
+    size_t nCols = _maze.NumberCols();
+
+    return (uint32_t) ((cell / nCols / _clusterSize) * _clusterCols + (cell % nCols) / _clusterSize);
+}
+
+/**
+ * Return the super cluster a cluster belongs to
+ * @param cluster cluster number
+ * @return super cluster number, super cluster row * super cluster columns + super cluster column
+ */
+inline uint32_t HierarchicalGraph::SuperOf(uint32_t cluster) const {
+    return (uint32_t) ((cluster / _clusterCols / SUPER_CLUSTER_SIZE) * _superCols + (cluster % _clusterCols) / SUPER_CLUSTER_SIZE);
+}
+
+/**
+ * Return the cells a cluster covers
+ * @param cluster cluster number
+ * @param row receives the top row
+ * @param col receives the left column
+ * @param height receives the number of rows
+ * @param width receives the number of columns
+ */
+inline void HierarchicalGraph::ClusterBounds(uint32_t cluster, size_t& row, size_t& col, size_t& height, size_t& width) const {
+    row = (cluster / _clusterCols) * _clusterSize;
+    col = (cluster % _clusterCols) * _clusterSize;
+    height = std::min(_clusterSize, _maze.NumberRows() - row);
+    width = std::min(_clusterSize, _maze.NumberCols() - col);
+}
+
+/**
+ * Return the position of a cell within the bordered copy of its cluster
+ * @param cluster the cluster holding the cell
+ * @param cell linear index of the cell
+ * @return (row within the cluster + 1) * (cluster width + 2) + column within the cluster + 1
+ */
+inline uint32_t HierarchicalGraph::LocalIndex(uint32_t cluster, uint32_t cell) const {
+    size_t nCols = _maze.NumberCols();
+    size_t row, col, height, width;
+
+    ClusterBounds(cluster, row, col, height, width);
+    return (uint32_t) ((cell / nCols - row + 1) * (width + 2) + (cell % nCols - col + 1));
+}
+
+/**
+ * Return the number a query's start node is searched under, the goal's being
+ * the next; the numbers before are the first level nodes and then the second
+ * level nodes by slot
+ * @return start node number
+ */
+inline uint32_t HierarchicalGraph::StartNode() const {
+    return (uint32_t) (_nodeCell.size() + _levelTwoNode.size());
+}
+
+/**
+ * Return the cell of a node, counting second level and the query's start and goal nodes
+ * @param node node number
+ * @return linear index of the cell
+ */
+inline uint32_t HierarchicalGraph::NodeCell(uint32_t node) const {
+    if (node < _nodeCell.size()) {
+        return _nodeCell[node];
+    }
+    if (node < StartNode()) {
+        return _nodeCell[_levelTwoNode[node - _nodeCell.size()]];
+    }
+    return node == StartNode() ? _startCell : _goalCell;
+}
+
+/**
+ * Make a node the target the searches estimate distances to
+ * The goal's distance from a landmark is the least over the nodes of its
+ * cluster of theirs plus the goal's distance from them, which is exact since
+ * the goal is only joined to the graph through those nodes.
+ * @param node node number, of either level, or the goal node
+ */
+void HierarchicalGraph::SetTarget(uint32_t node) {
+    _targetRow = _nodeRow[node];
+    _targetCol = _nodeCol[node];
+    if (node < StartNode()) {
+        std::copy(&_landmarkLength[node * NUMBER_LANDMARKS], &_landmarkLength[node * NUMBER_LANDMARKS] + NUMBER_LANDMARKS, _targetLandmark);
+        return;
+    }
+
+    uint32_t begin = _clusterBegin[ClusterOf(_goalCell)];
+    for (unsigned i = 0; i < NUMBER_LANDMARKS; i++) {
+        uint32_t least = UINT16_MAX;
+
+        for (uint32_t j = 0; j < _goalLength.size(); j++) {
+            if (_goalLength[j] != UNREACHABLE) {
+                least = std::min(least, _landmarkLength[(begin + j) * NUMBER_LANDMARKS + i] + _goalLength[j]);
+            }
+        }
+        _targetLandmark[i] = (uint16_t) least;
+    }
+}
+
+/**
+ * Estimate the moves left from a node to the target: the Manhattan distance,
+ * which no edge can beat, or more if a landmark's distances show it.  Each is
+ * consistent, and so is the larger of them.
+ * @param node node number
+ * @return lower bound on the moves to the target
+ */
+inline uint32_t HierarchicalGraph::Heuristic(uint32_t node) const {
+    uint32_t estimate = (_nodeRow[node] > _targetRow ? _nodeRow[node] - _targetRow : _targetRow - _nodeRow[node])
+                        + (_nodeCol[node] > _targetCol ? _nodeCol[node] - _targetCol : _targetCol - _nodeCol[node]);
+
+    if (node < StartNode()) {
+        const uint16_t* lengths = _landmarkLength.data() + node * NUMBER_LANDMARKS;
+
+        for (unsigned i = 0; i < NUMBER_LANDMARKS; i++) {
+            uint32_t bound = (lengths[i] > _targetLandmark[i]) ? lengths[i] - _targetLandmark[i] : _targetLandmark[i] - lengths[i];
+            estimate = std::max(estimate, bound);
+        }
+    }
+    return estimate;
+}
+
+/**
+ * Start a new search over the nodes, forgetting every node reached before
+ */
+inline void HierarchicalGraph::NextEpoch() {
+    if (++_epoch == 0) {
+        // Stamps from 2^32 searches ago would look current again
+        std::fill(_stamp.begin(), _stamp.end(), 0);
+        _epoch = 1;
+    }
+    _open.Clear();
+}
+
+/**
+ * Size the buffers of a cluster search for the largest cluster
+ * @param scratch the search state, which holds no cluster afterwards
+ */
+void HierarchicalGraph::PrepareScratch(ClusterScratch& scratch) const {
+    size_t padded = (_clusterSize + 2) * (_clusterSize + 2);
+
+    scratch.cluster = NO_NODE;
+    scratch.open.resize(padded);
+    scratch.distance.resize(padded);
+    scratch.queue.resize(padded);
+    scratch.rows.resize(_clusterSize * ((_clusterSize + 63) / 64));
+    scratch.came.resize(_clusterSize * _clusterSize);
+}
+
+/**
+ * Copy the cells of a cluster into a search's buffer, inside a border of walls,
+ * taking 64 cells at a time from the maze
+ * @param cluster the cluster to copy
+ * @param scratch the search state, which holds that cluster afterwards
+ */
+void HierarchicalGraph::LoadCluster(uint32_t cluster, ClusterScratch& scratch) const {
+    size_t top, left, height, width;
+
+    ClusterBounds(cluster, top, left, height, width);
+    std::fill(scratch.open.begin(), scratch.open.begin() + (height + 2) * (width + 2), 0);
+    for (size_t row = 0; row < height; row++) {
+        unsigned char* open = scratch.open.data() + (row + 1) * (width + 2) + 1;
+
+        for (size_t col = 0; col < width; col += 64) {
+            size_t word = (left + col) / 64;
+            unsigned shift = (left + col) % 64;
+            uint64_t bits = _maze.RowWord(top + row, word) >> shift;
+
+            if (shift != 0 && word + 1 < _maze.WordsPerRow()) {
+                bits |= _maze.RowWord(top + row, word + 1) << (64 - shift);
+            }
+            for (size_t i = 0; i < 64 && col + i < width; i++) {
+                open[col + i] = (bits >> i) & 1;
+            }
+        }
+    }
+    scratch.cluster = cluster;
+}
+
+/**
+ * Breadth first search from a cell to every cell it reaches without leaving its cluster
+ * @param cluster the cluster to search, copied into scratch first unless it is already there
+ * @param from linear index of an open cell of the cluster to search from
+ * @param scratch receives the distance of each cell of the cluster, UNREACHABLE
+ *        if not reached, by local index
+ */
+void HierarchicalGraph::SearchCluster(uint32_t cluster, uint32_t from, ClusterScratch& scratch) const {
+    size_t top, left, height, width;
+    size_t head = 0;
+    size_t tail = 0;
+
+    if (scratch.cluster != cluster) {
+        LoadCluster(cluster, scratch);
+    }
+    ClusterBounds(cluster, top, left, height, width);
+    std::fill(scratch.distance.begin(), scratch.distance.begin() + (height + 2) * (width + 2), UNREACHABLE);
+
+    // The border walls stop every step off the cluster, in all four directions
+    const uint32_t offsets[4] = { (uint32_t) -(width + 2), 1, (uint32_t) (width + 2), (uint32_t) -1 };
+    uint32_t first = LocalIndex(cluster, from);
+    scratch.distance[first] = 0;
+    scratch.queue[tail++] = first;
+    while (head < tail) {
+        uint32_t current = scratch.queue[head++];
+        uint32_t next = scratch.distance[current] + 1;
+
+        for (uint32_t offset : offsets) {
+            uint32_t neighbor = current + offset;
+
+            if (scratch.open[neighbor] && scratch.distance[neighbor] == UNREACHABLE) {
+                scratch.distance[neighbor] = next;
+                scratch.queue[tail++] = neighbor;
+            }
+        }
+    }
+}
+
+/**
+ * Copy the distances of the last cluster search out to the nodes of the cluster
+ * @param cluster the cluster searched
+ * @param lengths receives the distance to each node of the cluster, in node order
+ */
+void HierarchicalGraph::CollectLengths(uint32_t cluster, vector<uint32_t>& lengths) const {
+    lengths.clear();
+    for (uint32_t node = _clusterBegin[cluster]; node < _clusterBegin[cluster + 1]; node++) {
+        lengths.push_back(_scratch.distance[LocalIndex(cluster, _nodeCell[node])]);
+    }
+}
+
+/**
+ * Can the query's start and goal be connected?  True if they reach each other
+ * within their cluster, or reach nodes in the same component of the graph.
+ * @return false only if there is certainly no route
+ */
+bool HierarchicalGraph::MayConnect() const {
+    uint32_t startBegin = _clusterBegin[ClusterOf(_startCell)];
+    uint32_t goalBegin = _clusterBegin[ClusterOf(_goalCell)];
+
+    if (_direct != UNREACHABLE) {
+        return true;
+    }
+    for (size_t i = 0; i < _startLength.size(); i++) {
+        for (size_t j = 0; j < _goalLength.size(); j++) {
+            if (_startLength[i] != UNREACHABLE && _goalLength[j] != UNREACHABLE
+                && _nodeComponent[startBegin + i] == _nodeComponent[goalBegin + j]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Reach a node at a cost, unless the search has reached it more cheaply already
+ * The node's estimate is worked out the first time the search reaches it.
+ * @param node node number
+ * @param cost moves from the start
+ * @param from node it is reached from
+ */
+inline void HierarchicalGraph::Reach(uint32_t node, uint32_t cost, uint32_t from) {
+    if (_stamp[node] != _epoch) {
+        _stamp[node] = _epoch;
+        _estimate[node] = Heuristic(node);
+    }
+    else if (cost >= _cost[node]) {
+        return;
+    }
+    _cost[node] = cost;
+    _parent[node] = from;
+    _open.Push(cost + _estimate[node], node);
+}
+
+/**
+ * A* over the abstract graph from the start node to the goal node
+ * The super clusters of the start and the goal are searched on the first
+ * level, and every other super cluster on the second, under the second level
+ * node numbers: the only edges followed into those super clusters are the
+ * crossings kept for the second level, which end at second level nodes.
+ * @return number of nodes expanded, with the goal's parents set if it was reached
+ */
+size_t HierarchicalGraph::SearchAbstract() {
+    uint32_t firstSlot = (uint32_t) _nodeCell.size();
+    uint32_t startNode = StartNode();
+    uint32_t goalNode = startNode + 1;
+    uint32_t startCluster = ClusterOf(_startCell);
+    uint32_t goalCluster = ClusterOf(_goalCell);
+    size_t expanded = 0;
+
+    NextEpoch();
+    SetTarget(goalNode);
+    Reach(startNode, 0, startNode);
+    while (!_open.Empty()) {
+        uint32_t key;
+        uint32_t node = _open.Pop(key);
+        uint32_t cost = _cost[node];
+
+        if (key != cost + _estimate[node]) {
+            continue;
+        }
+        expanded++;
+        if (node == goalNode) {
+            break;
+        }
+        if (node == startNode) {
+            for (uint32_t i = 0; i < _startLength.size(); i++) {
+                if (_startLength[i] != UNREACHABLE) {
+                    Reach(_clusterBegin[startCluster] + i, _startLength[i], node);
+                }
+            }
+            if (_direct != UNREACHABLE) {
+                Reach(goalNode, _direct, node);
+            }
+            continue;
+        }
+
+        if (node >= firstSlot) {
+            uint32_t slot = node - firstSlot;
+            uint32_t super = _nodeSuper[_levelTwoNode[slot]];
+            uint32_t begin = _superBegin[super];
+            uint32_t k = _superBegin[super + 1] - begin;
+            const uint32_t* row = _superLength.data() + _superMatrixBegin[super] + (slot - begin) * k;
+
+            for (uint32_t j = 0; j < k; j++) {
+                if (row[j] != UNREACHABLE && begin + j != slot) {
+                    Reach(firstSlot + begin + j, cost + row[j], node);
+                }
+            }
+            for (uint32_t edge = _crossingBegin[slot]; edge < _crossingBegin[slot + 1]; edge++) {
+                uint32_t target = _crossingTarget[edge];
+
+                if (_nodeSuper[target] == _startSuper || _nodeSuper[target] == _goalSuper) {
+                    Reach(target, cost + 1, node);
+                }
+                else {
+                    Reach(firstSlot + _levelTwoSlot[target], cost + 1, node);
+                }
+            }
+            continue;
+        }
+
+        uint32_t cluster = _nodeCluster[node];
+        uint32_t begin = _clusterBegin[cluster];
+        uint32_t k = _clusterBegin[cluster + 1] - begin;
+        const uint32_t* row = _intraLength.data() + _matrixBegin[cluster] + (node - begin) * k;
+
+        for (uint32_t j = 0; j < k; j++) {
+            if (row[j] != UNREACHABLE && begin + j != node) {
+                Reach(begin + j, cost + row[j], node);
+            }
+        }
+        for (uint32_t edge = _interBegin[node]; edge < _interBegin[node + 1]; edge++) {
+            uint32_t target = _interTarget[edge];
+
+            if (_nodeSuper[target] == _startSuper || _nodeSuper[target] == _goalSuper) {
+                Reach(target, cost + 1, node);
+            }
+            else if (_levelTwoSlot[target] != NO_NODE) {
+                Reach(firstSlot + _levelTwoSlot[target], cost + 1, node);
+            }
+        }
+        if (cluster == goalCluster && _goalLength[node - begin] != UNREACHABLE) {
+            Reach(goalNode, cost + _goalLength[node - begin], node);
+        }
+    }
+    return expanded;
+}
+
+/**
+ * Append the route of a hop between two second level nodes of one super
+ * cluster: A* over the first level without leaving the super cluster, each of
+ * its hops then filled in cell by cell
+ * @param from node the route is at, already on it
+ * @param to node to go to
+ * @param route receives every cell after from's up to and including to's
+ */
+void HierarchicalGraph::RefineLevelTwo(uint32_t from, uint32_t to, vector<GridLocation>& route) {
+    uint32_t super = _nodeSuper[from];
+    size_t nCols = _maze.NumberCols();
+
+    NextEpoch();
+    SetTarget(to);
+    Reach(from, 0, from);
+    while (!_open.Empty()) {
+        uint32_t key;
+        uint32_t node = _open.Pop(key);
+        uint32_t cost = _cost[node];
+
+        if (key != cost + _estimate[node]) {
+            continue;
+        }
+        if (node == to) {
+            break;
+        }
+
+        uint32_t cluster = _nodeCluster[node];
+        uint32_t begin = _clusterBegin[cluster];
+        uint32_t k = _clusterBegin[cluster + 1] - begin;
+        const uint32_t* row = _intraLength.data() + _matrixBegin[cluster] + (node - begin) * k;
+
+        for (uint32_t j = 0; j < k; j++) {
+            if (row[j] != UNREACHABLE && begin + j != node) {
+                Reach(begin + j, cost + row[j], node);
+            }
+        }
+        for (uint32_t edge = _interBegin[node]; edge < _interBegin[node + 1]; edge++) {
+            if (_nodeSuper[_interTarget[edge]] == super) {
+                Reach(_interTarget[edge], cost + 1, node);
+            }
+        }
+    }
+    assert(_stamp[to] == _epoch);
+
+    _hops.clear();
+    for (uint32_t node = to; node != from; node = _parent[node]) {
+        _hops.push_back(node);
+    }
+    uint32_t at = _nodeCell[from];
+    for (size_t i = _hops.size(); i > 0; i--) {
+        uint32_t next = _nodeCell[_hops[i-1]];
+
+        if (ClusterOf(at) == ClusterOf(next)) {
+            Refine(at, next, route);
+        }
+        else {
+            route.push_back(GridLocation(next / nCols, next % nCols));
+        }
+        at = next;
+    }
+}
+
+/**
+ * Append a shortest route between two cells of one cluster, confined to the
+ * cluster, found by A* over its cells with the Manhattan distance
+ * Each move changes the estimate by one either way, so a cell is reached at
+ * the bound being expanded or two above it, and two stacks make the queue:
+ * the one being worked through and the next.  Taking the newest cell first
+ * heads straight for the goal among routes equally short.
+ * @param from linear index of the cell the route is at, already on it
+ * @param to linear index of the cell to go to
+ * @param route receives every cell after "from" up to and including "to"
+ */
+void HierarchicalGraph::Refine(uint32_t from, uint32_t to, vector<GridLocation>& route) {
+    size_t nCols = _maze.NumberCols();
+    size_t top, left, height, width;
+    size_t mark = route.size();
+
+    ClusterBounds(ClusterOf(from), top, left, height, width);
+    size_t words = (width + 63) / 64;
+    uint32_t toRow = (uint32_t) (to / nCols - top);
+    uint32_t toCol = (uint32_t) (to % nCols - left);
+
+    // The cluster's rows as bits; a step off the cluster wraps to a row or
+    // column past the end, which the bounds check turns down
+    uint64_t* open = _scratch.rows.data();
+    for (size_t row = 0; row < height; row++) {
+        for (size_t word = 0; word < words; word++) {
+            size_t col = left + word * 64;
+            unsigned shift = col % 64;
+            uint64_t bits = _maze.RowWord(top + row, col / 64) >> shift;
+
+            if (shift != 0 && col / 64 + 1 < _maze.WordsPerRow()) {
+                bits |= _maze.RowWord(top + row, col / 64 + 1) << (64 - shift);
+            }
+            open[row * words + word] = bits;
+        }
+    }
+
+    const uint32_t rowStep[4] = { (uint32_t) -1, 0, 1, 0 };
+    const uint32_t colStep[4] = { 0, 1, 0, (uint32_t) -1 };
+    auto estimate = [toRow, toCol](uint32_t row, uint32_t col) {
+        return (row > toRow ? row - toRow : toRow - row) + (col > toCol ? col - toCol : toCol - col);
+    };
+    uint32_t fromRow = (uint32_t) (from / nCols - top);
+    uint32_t fromCol = (uint32_t) (from % nCols - left);
+    uint32_t bound = estimate(fromRow, fromCol);
+
+    std::fill(_scratch.distance.begin(), _scratch.distance.begin() + height * width, UNREACHABLE);
+    _scratch.distance[fromRow * width + fromCol] = 0;
+    _scratch.now.assign(1, fromRow << 16 | fromCol);
+    _scratch.later.clear();
+    for (;;) {
+        if (_scratch.now.empty()) {
+            assert(!_scratch.later.empty());
+            _scratch.now.swap(_scratch.later);
+            bound += 2;
+        }
+
+        uint32_t row = _scratch.now.back() >> 16;
+        uint32_t col = _scratch.now.back() & 0xFFFF;
+        uint32_t next = _scratch.distance[row * width + col] + 1;
+        uint32_t remaining = estimate(row, col);
+
+        _scratch.now.pop_back();
+        if (next - 1 + remaining != bound) {
+            // Reached again more cheaply since
+            continue;
+        }
+        if (remaining == 0) {
+            break;
+        }
+        for (unsigned direction = 0; direction < 4; direction++) {
+            uint32_t r = row + rowStep[direction];
+            uint32_t c = col + colStep[direction];
+
+            if (r < height && c < width && ((open[r * words + c / 64] >> (c % 64)) & 1) && next < _scratch.distance[r * width + c]) {
+                _scratch.distance[r * width + c] = next;
+                _scratch.came[r * width + c] = (unsigned char) direction;
+                (estimate(r, c) < remaining ? _scratch.now : _scratch.later).push_back(r << 16 | c);
+            }
+        }
+    }
+
+    // Walk back from "to" against the moves that reached each cell
+    for (uint32_t row = toRow, col = toCol; row != fromRow || col != fromCol; ) {
+        unsigned direction = _scratch.came[row * width + col];
+
+        route.push_back(GridLocation(top + row, left + col));
+        row -= rowStep[direction];
+        col -= colStep[direction];
+    }
+    std::reverse(route.begin() + mark, route.end());
+}
+
+/**
+ * Find a route between two cells
+ * The start and goal are linked to the nodes of their clusters by a search of
+ * each cluster, A* finds the cheapest way over the abstract graph, each hop of
+ * that across a super cluster is filled in with a search of the first level in
+ * it, and each hop within a cluster with a search of the cluster.  The route is
+ * usually within a few percent of the shortest, and is the shortest where each
+ * entrance is one cell wide.
+ * @param start where the route begins
+ * @param goal where the route ends
+ * @param route receives the route, start first; left empty if there is none
+ * @param stats if not nullptr, receives the number of abstract nodes expanded
+ * @return true if a route exists, false otherwise
+ */
+bool HierarchicalGraph::Solve(const GridLocation& start, const GridLocation& goal, vector<GridLocation>& route, SolveStats* stats) {
+    size_t nCols = _maze.NumberCols();
+    size_t expanded = 0;
+    bool found = false;
+
+    route.clear();
+    if (_maze.IsWithinGrid(start) && _maze[start] && _maze.IsWithinGrid(goal) && _maze[goal]) {
+        _startCell = (uint32_t) (start.Row() * nCols + start.Col());
+        _goalCell = (uint32_t) (goal.Row() * nCols + goal.Col());
+        _nodeRow[StartNode()] = (uint32_t) start.Row();
+        _nodeCol[StartNode()] = (uint32_t) start.Col();
+        _nodeRow.back() = (uint32_t) goal.Row();
+        _nodeCol.back() = (uint32_t) goal.Col();
+
+        uint32_t startCluster = ClusterOf(_startCell);
+        uint32_t goalCluster = ClusterOf(_goalCell);
+        _startSuper = SuperOf(startCluster);
+        _goalSuper = SuperOf(goalCluster);
+        SearchCluster(startCluster, _startCell, _scratch);
+        CollectLengths(startCluster, _startLength);
+        _direct = (startCluster == goalCluster) ? _scratch.distance[LocalIndex(goalCluster, _goalCell)] : UNREACHABLE;
+        SearchCluster(goalCluster, _goalCell, _scratch);
+        CollectLengths(goalCluster, _goalLength);
+
+        if (MayConnect()) {
+            uint32_t firstSlot = (uint32_t) _nodeCell.size();
+            uint32_t startNode = StartNode();
+            uint32_t goalNode = startNode + 1;
+
+            expanded = SearchAbstract();
+            found = (_stamp[goalNode] == _epoch);
+            assert(found);
+            if (found) {
+                _path.clear();
+                for (uint32_t node = goalNode; node != startNode; node = _parent[node]) {
+                    _path.push_back(node);
+                }
+                route.push_back(start);
+                uint32_t at = _startCell;
+                uint32_t previous = startNode;
+                for (size_t i = _path.size(); i > 0; i--) {
+                    uint32_t next = NodeCell(_path[i-1]);
+
+                    // Two second level nodes of the same super cluster are a hop over the second level
+                    if (previous >= firstSlot && previous < startNode && _path[i-1] >= firstSlot && _path[i-1] < startNode
+                        && _nodeSuper[_levelTwoNode[previous - firstSlot]] == _nodeSuper[_levelTwoNode[_path[i-1] - firstSlot]]) {
+                        RefineLevelTwo(_levelTwoNode[previous - firstSlot], _levelTwoNode[_path[i-1] - firstSlot], route);
+                    }
+                    else if (ClusterOf(at) == ClusterOf(next)) {
+                        Refine(at, next, route);
+                    }
+                    else {
+                        route.push_back(GridLocation(next / nCols, next % nCols));
+                    }
+                    at = next;
+                    previous = _path[i-1];
+                }
+            }
+        }
+    }
+    if (stats) {
+        stats->cellsExpanded = expanded;
+    }
+    return found;
+}
+
+/**
+ * Find a route between two cells, in the form SolveMaze returns
+ * @param start where the route begins
+ * @param goal where the route ends
+ * @param solution receives the route with start at the bottom and goal on top
+ * @param stats if not nullptr, receives the number of abstract nodes expanded
+ * @return true if a route exists, false otherwise
+ */
+bool HierarchicalGraph::Solve(const GridLocation& start, const GridLocation& goal, stack<GridLocation>& solution, SolveStats* stats) {
+    if (!Solve(start, goal, _route, stats)) {
+        return false;
+    }
+    solution = stack<GridLocation>();
+    for (const GridLocation& loc : _route) {
+        solution.push(loc);
+    }
+    return true;
+}
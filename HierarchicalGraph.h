@@ -0,0 +1,231 @@
+//
+// Interface Definition for the HierarchicalGraph Class
+// Hierarchical path finding (HPA*) over a maze cut into square clusters: the
+// entrances between clusters and the distances between entrances of the same
+// cluster are worked out once, and each query searches that small abstract
+// graph and then fills in the cells of the route one cluster at a time.  A
+// second level does the same for blocks of clusters, so the middle of a long
+// route is searched a block at a time, and the distances from a few landmark
+// nodes give the searches a much closer estimate than the Manhattan distance.
+// Date: 10/18/2026
+//
+
+#ifndef HIERARCHICALGRAPH_H
+#define HIERARCHICALGRAPH_H
+
+#include <cstdint>
+#include <stack>
+#include <utility>
+#include <vector>
+using std::pair;
+using std::stack;
+using std::vector;
+
+#include "Grid.h"
+#include "RadixHeap.h"
+#include "Solver.h"
+
+class HierarchicalGraph {
+public:
+    static const size_t DEFAULT_CLUSTER_SIZE = 32;
+    static const size_t SUPER_CLUSTER_SIZE = 8;
+    static const unsigned NUMBER_LANDMARKS = 8;
+
+    explicit HierarchicalGraph(Grid maze, size_t clusterSize = DEFAULT_CLUSTER_SIZE, unsigned nThreads = 0);
+
+    HierarchicalGraph(const HierarchicalGraph&) = delete;
+    HierarchicalGraph& operator=(const HierarchicalGraph&) = delete;
+
+    const Grid& Maze() const;
+    size_t ClusterSize() const;
+    size_t NumberClusters() const;
+    size_t NumberNodes() const;
+    size_t NumberEdges() const;
+    size_t NumberLevelTwoNodes() const;
+    size_t MemoryBytes() const;
+
+    bool Solve(const GridLocation& start, const GridLocation& goal, vector<GridLocation>& route, SolveStats* stats = nullptr);
+    bool Solve(const GridLocation& start, const GridLocation& goal, stack<GridLocation>& solution, SolveStats* stats = nullptr);
+
+private:
+    static const uint32_t NO_NODE = UINT32_MAX;
+
+    // Search state for one cluster.  The cells of the cluster are copied out
+    // with a border of walls, so a search never checks the edges, and everything
+    // is indexed by a cell's position within that bordered copy; or, to fill in
+    // a route, kept as rows of bits, everything indexed by row * width +
+    // column.  Building the graph gives each thread its own.
+    struct ClusterScratch {
+        uint32_t cluster;
+        vector<unsigned char> open;
+        vector<uint32_t> distance;
+        vector<uint32_t> queue;
+        vector<uint64_t> rows;
+        vector<unsigned char> came;
+        vector<uint32_t> now;
+        vector<uint32_t> later;
+    };
+
+    // Dijkstra state over the nodes, for measuring the second level and the
+    // landmarks.  A node has been reached when its stamp equals the epoch.
+    struct NodeScratch {
+        vector<uint32_t> cost;
+        vector<uint32_t> stamp;
+        uint32_t epoch;
+        RadixHeap<uint32_t> open;
+    };
+
+    void FindEntrances(vector<pair<uint32_t, uint32_t>>& transitions) const;
+    void AddEntrance(uint32_t first, uint32_t last, uint32_t step, uint32_t across, vector<pair<uint32_t, uint32_t>>& transitions) const;
+    void ComputeIntraLengths(unsigned nThreads);
+    void LabelComponents();
+    void BuildLevelTwo(unsigned nThreads);
+    void ComputeLandmarks(unsigned nThreads);
+    void PrepareNodeScratch(NodeScratch& scratch) const;
+    void MeasureFrom(uint32_t source, uint32_t super, NodeScratch& scratch) const;
+
+    uint32_t ClusterOf(uint32_t cell) const;
+    uint32_t SuperOf(uint32_t cluster) const;
+    void ClusterBounds(uint32_t cluster, size_t& row, size_t& col, size_t& height, size_t& width) const;
+    uint32_t LocalIndex(uint32_t cluster, uint32_t cell) const;
+    uint32_t StartNode() const;
+    uint32_t NodeCell(uint32_t node) const;
+    void SetTarget(uint32_t node);
+    uint32_t Heuristic(uint32_t node) const;
+    void NextEpoch();
+
+    void PrepareScratch(ClusterScratch& scratch) const;
+    void LoadCluster(uint32_t cluster, ClusterScratch& scratch) const;
+    void SearchCluster(uint32_t cluster, uint32_t from, ClusterScratch& scratch) const;
+    void CollectLengths(uint32_t cluster, vector<uint32_t>& lengths) const;
+    bool MayConnect() const;
+    void Reach(uint32_t node, uint32_t cost, uint32_t from);
+    size_t SearchAbstract();
+    void RefineLevelTwo(uint32_t from, uint32_t to, vector<GridLocation>& route);
+    void Refine(uint32_t from, uint32_t to, vector<GridLocation>& route);
+
+    Grid _maze;
+    size_t _clusterSize;
+    size_t _clusterRows;
+    size_t _clusterCols;
+
+    // Nodes are entrance cells, numbered cluster by cluster: the nodes of cluster
+    // c are _clusterBegin[c] .. _clusterBegin[c+1] - 1.  Each cluster keeps a
+    // k x k matrix of the moves between its k nodes without leaving the cluster,
+    // UNREACHABLE where there is no such route, starting at _matrixBegin[c].
+    // Edges between clusters are a single move, in compressed rows by node.
+    // A node's cluster, row and column are kept alongside its cell so the search
+    // never divides; the last two rows and columns are the query's start and goal.
+    vector<uint32_t> _nodeCell;
+    vector<uint32_t> _nodeCluster;
+    vector<uint32_t> _nodeRow;
+    vector<uint32_t> _nodeCol;
+    vector<uint32_t> _clusterBegin;
+    vector<size_t> _matrixBegin;
+    vector<uint32_t> _intraLength;
+    vector<uint32_t> _interBegin;
+    vector<uint32_t> _interTarget;
+    vector<uint32_t> _nodeComponent;
+    size_t _nEdges;
+
+    // The second level groups SUPER_CLUSTER_SIZE x SUPER_CLUSTER_SIZE clusters
+    // into a super cluster.  Its nodes are the nodes of some of the edges
+    // crossing between super clusters, one per entrance, numbered super cluster
+    // by super cluster: _levelTwoNode[i] is the
+    // node of the i-th, and _levelTwoSlot maps back, NO_NODE off the second
+    // level.  Each super cluster keeps a matrix of first level distances between
+    // its second level nodes without leaving it, starting at _superMatrixBegin[s];
+    // the crossing edges kept are in compressed rows by second level node.
+    size_t _superRows;
+    size_t _superCols;
+    vector<uint32_t> _nodeSuper;
+    vector<uint32_t> _levelTwoSlot;
+    vector<uint32_t> _levelTwoNode;
+    vector<uint32_t> _superBegin;
+    vector<size_t> _superMatrixBegin;
+    vector<uint32_t> _superLength;
+    vector<uint32_t> _crossingBegin;
+    vector<uint32_t> _crossingTarget;
+
+    // Distances over the first level from NUMBER_LANDMARKS nodes near the corners
+    // and the middles of the sides, NUMBER_LANDMARKS per node, capped at
+    // UINT16_MAX.  By the triangle inequality |d(L, a) - d(L, b)| never exceeds
+    // the distance between a and b, capped or not.
+    vector<uint16_t> _landmarkLength;
+
+    // Query state.  The start and goal join the graph as two extra nodes, linked
+    // to the nodes of their own clusters by _startLength and _goalLength.  A node
+    // has been reached in the current search when its _stamp equals _epoch.  The
+    // searches estimate the distance to the target's row, column and landmark
+    // distances, which are the goal's while searching the whole graph.
+    uint32_t _startCell;
+    uint32_t _goalCell;
+    uint32_t _startSuper;
+    uint32_t _goalSuper;
+    uint32_t _direct;
+    uint32_t _targetRow;
+    uint32_t _targetCol;
+    uint16_t _targetLandmark[NUMBER_LANDMARKS];
+    vector<uint32_t> _startLength;
+    vector<uint32_t> _goalLength;
+    vector<uint32_t> _cost;
+    vector<uint32_t> _estimate;
+    vector<uint32_t> _parent;
+    vector<uint32_t> _stamp;
+    uint32_t _epoch;
+    RadixHeap<uint32_t> _open;
+    ClusterScratch _scratch;
+    vector<uint32_t> _path;
+    vector<uint32_t> _hops;
+    vector<GridLocation> _route;
+};
+
+/**
+ * Return the maze the graph was built for
+ * @return the maze
+ */
+inline const Grid& HierarchicalGraph::Maze() const {
+    return _maze;
+}
+
+/**
+ * Return the width and height of a cluster (those along the far edges may be smaller)
+ * @return cluster size in cells
+ */
+inline size_t HierarchicalGraph::ClusterSize() const {
+    return _clusterSize;
+}
+
+/**
+ * Return number of clusters the maze is cut into
+ * @return number of clusters
+ */
+inline size_t HierarchicalGraph::NumberClusters() const {
+    return _clusterRows * _clusterCols;
+}
+
+/**
+ * Return number of nodes of the abstract graph, not counting a query's start and goal
+ * @return number of nodes
+ */
+inline size_t HierarchicalGraph::NumberNodes() const {
+    return _nodeCell.size();
+}
+
+/**
+ * Return number of edges of the abstract graph, counting each once in each direction
+ * @return number of edges
+ */
+inline size_t HierarchicalGraph::NumberEdges() const {
+    return _nEdges;
+}
+
+/**
+ * Return number of nodes of the second level, each of them also a node of the first
+ * @return number of second level nodes
+ */
+inline size_t HierarchicalGraph::NumberLevelTwoNodes() const {
+    return _levelTwoNode.size();
+}
+
+#endif //HIERARCHICALGRAPH_H
@@ -0,0 +1,216 @@
+//
+// Method implementation for the JumpPointSolver Class
+// Date: 10/18/2026
+//
+
+#include <cassert>
+#include "JumpPointSolver.h"
+#include "RadixHeap.h"
+#include "VisitedSet.h"
+
+// Search states are (cell, direction of arrival) pairs, numbered cell * 4 + direction
+static const unsigned NORTH = 0;
+static const unsigned EAST = 1;
+static const unsigned SOUTH = 2;
+static const unsigned WEST = 3;
+
+/**
+ * Return name of the algorithm
+ * @return "jps"
+ */
+const char* JumpPointSolver::Name() const {
+    return "jps";
+}
+
+/**
+* Manhattan distance between two cells
+* @param aRow row of the first cell
+* @param aCol column of the first cell
+* @param bRow row of the second cell
+* @param bCol column of the second cell
+* @return number of moves if there were no walls
+*/
+static uint32_t Manhattan(size_t aRow, size_t aCol, size_t bRow, size_t bCol) {
+    return (uint32_t) ((aRow > bRow ? aRow - bRow : bRow - aRow) + (aCol > bCol ? aCol - bCol : bCol - aCol));
+}
+
+/**
+* Move vertically from a cell until reaching a jump point
+* Shortest routes are taken to turn horizontally as early as they can, so a
+* vertical run only has to stop at the goal or where a horizontal neighbor is
+* open but the cell beside the previous step was a wall.
+* @param maze the maze
+* @param row row to move from
+* @param col column to move along
+* @param dRow -1 to move north, +1 to move south
+* @param goal where the route ends
+* @return linear index of the jump point, or NO_PARENT if the run hits a wall
+*/
+uint32_t JumpPointSolver::JumpVertical(const Grid& maze, size_t row, size_t col, int dRow, const GridLocation& goal) const {
+    while (true) {
+        size_t previous = row;
+
+        row += dRow;
+        if (!IsOpen(maze, GridLocation(row, col))) {
+            return NO_PARENT;
+        }
+        if (row == goal.Row() && col == goal.Col()) {
+            return (uint32_t) (row * maze.NumberCols() + col);
+        }
+        if ((IsOpen(maze, GridLocation(row, col - 1)) && !IsOpen(maze, GridLocation(previous, col - 1)))
+            || (IsOpen(maze, GridLocation(row, col + 1)) && !IsOpen(maze, GridLocation(previous, col + 1)))) {
+            return (uint32_t) (row * maze.NumberCols() + col);
+        }
+    }
+}
+
+/**
+* Move horizontally from a cell until reaching a jump point
+* A horizontal run stops at the goal, or where a vertical run from the cell
+* reaches a jump point of its own.
+* @param maze the maze
+* @param row row to move along
+* @param col column to move from
+* @param dCol -1 to move west, +1 to move east
+* @param goal where the route ends
+* @return linear index of the jump point, or NO_PARENT if the run hits a wall
+*/
+uint32_t JumpPointSolver::JumpHorizontal(const Grid& maze, size_t row, size_t col, int dCol, const GridLocation& goal) const {
+    while (true) {
+        col += dCol;
+        if (!IsOpen(maze, GridLocation(row, col))) {
+            return NO_PARENT;
+        }
+        if ((row == goal.Row() && col == goal.Col())
+            || JumpVertical(maze, row, col, -1, goal) != NO_PARENT
+            || JumpVertical(maze, row, col, +1, goal) != NO_PARENT) {
+            return (uint32_t) (row * maze.NumberCols() + col);
+        }
+    }
+}
+
+/**
+* Find a shortest route with Jump Point Search
+* A* over jump points: from each one the search jumps along straight runs to the
+* next cells where a shortest route might turn, rather than pushing every cell
+* on the open list.  Runs are straight, so the route between consecutive jump
+* points is filled back in when the path is built.
+* @param maze the maze that we want to solve
+* @param start where the route begins
+* @param goal where the route ends
+* @param solution out parameter used to return solution if it is found
+* @param stats if not nullptr, receives the amount of work done
+* @return true if solution can be found, false otherwise
+*/
+bool JumpPointSolver::Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+                            stack<GridLocation>& solution, SolveStats* stats) {
+    size_t nCols = maze.NumberCols();
+    size_t expanded = 0;
+    bool found = false;
+
+    if (IsOpen(maze, start) && IsOpen(maze, goal)) {
+        assert(maze.NumberRows() * nCols * 4 < NO_PARENT);
+
+        size_t nStates = maze.NumberRows() * nCols * 4;
+        uint32_t first = (uint32_t) (start.Row() * nCols + start.Col());
+        uint32_t last = (uint32_t) (goal.Row() * nCols + goal.Col());
+        vector<uint32_t> parent(nStates, NO_PARENT);
+        vector<uint32_t> distance(nStates, UINT32_MAX);
+        VisitedSet closed(nStates);
+        RadixHeap<uint32_t> open;
+        uint32_t goalState = NO_PARENT;
+
+        // The start may be left in any direction; mark it as a state of its own
+        uint32_t startState = first * 4 + NORTH;
+        parent[startState] = startState;
+        distance[startState] = 0;
+        open.Push(Manhattan(start.Row(), start.Col(), goal.Row(), goal.Col()), startState);
+
+        while (!open.Empty()) {
+            uint32_t key;
+            uint32_t state = open.Pop(key);
+            uint32_t cell = state / 4;
+            unsigned direction = state % 4;
+            size_t row = cell / nCols;
+            size_t col = cell % nCols;
+            uint32_t successors[4][2];
+            size_t count = 0;
+
+            if (!closed.Insert(state)) {
+                continue;
+            }
+            if (cell == last) {
+                goalState = state;
+                found = true;
+                break;
+            }
+            expanded++;
+
+            bool horizontal = (state == startState) || direction == EAST || direction == WEST;
+            bool vertical = (state == startState) || direction == NORTH || direction == SOUTH;
+            if (horizontal) {
+                // Keep going the same way (both ways from the start), and turn either way
+                if (state == startState || direction == EAST) {
+                    successors[count][0] = JumpHorizontal(maze, row, col, +1, goal);
+                    successors[count++][1] = EAST;
+                }
+                if (state == startState || direction == WEST) {
+                    successors[count][0] = JumpHorizontal(maze, row, col, -1, goal);
+                    successors[count++][1] = WEST;
+                }
+                successors[count][0] = JumpVertical(maze, row, col, -1, goal);
+                successors[count++][1] = NORTH;
+                successors[count][0] = JumpVertical(maze, row, col, +1, goal);
+                successors[count++][1] = SOUTH;
+            }
+            else if (vertical) {
+                // Keep going the same way, and turn only where forced
+                size_t previous = (direction == SOUTH) ? row - 1 : row + 1;
+
+                successors[count][0] = JumpVertical(maze, row, col, direction == SOUTH ? +1 : -1, goal);
+                successors[count++][1] = direction;
+                if (IsOpen(maze, GridLocation(row, col + 1)) && !IsOpen(maze, GridLocation(previous, col + 1))) {
+                    successors[count][0] = JumpHorizontal(maze, row, col, +1, goal);
+                    successors[count++][1] = EAST;
+                }
+                if (IsOpen(maze, GridLocation(row, col - 1)) && !IsOpen(maze, GridLocation(previous, col - 1))) {
+                    successors[count][0] = JumpHorizontal(maze, row, col, -1, goal);
+                    successors[count++][1] = WEST;
+                }
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                uint32_t jump = successors[i][0];
+
+                if (jump != NO_PARENT) {
+                    size_t jumpRow = jump / nCols;
+                    size_t jumpCol = jump % nCols;
+                    uint32_t next = jump * 4 + successors[i][1];
+                    uint32_t nextDistance = distance[state] + Manhattan(row, col, jumpRow, jumpCol);
+
+                    if (nextDistance < distance[next]) {
+                        distance[next] = nextDistance;
+                        parent[next] = state;
+                        open.Push(nextDistance + Manhattan(jumpRow, jumpCol, goal.Row(), goal.Col()), next);
+                    }
+                }
+            }
+        }
+
+        if (found) {
+            // Turn the chain of states into a chain of jump point cells
+            vector<uint32_t> states;
+            CollectChain(parent.data(), goalState, states);
+
+            solution = stack<GridLocation>();
+            solution.push(start);
+            for (size_t i = states.size() - 1; i > 0; i--) {
+                PushSegment(maze, states[i] / 4, states[i-1] / 4, solution);
+            }
+        }
+    }
+    if (stats) {
+        stats->cellsExpanded = expanded;
+    }
+    return found;
+}
@@ -0,0 +1,24 @@
+//
+// Interface Definition for the JumpPointSolver Class
+// Jump Point Search for uniform cost, 4-connected grids: A* that only stops
+// at cells where a shortest route may have to turn
+// Date: 10/18/2026
+//
+
+#ifndef JUMPPOINTSOLVER_H
+#define JUMPPOINTSOLVER_H
+
+#include "Solver.h"
+
+class JumpPointSolver : public Solver {
+public:
+    const char* Name() const override;
+    bool Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+               stack<GridLocation>& solution, SolveStats* stats) override;
+
+private:
+    uint32_t JumpHorizontal(const Grid& maze, size_t row, size_t col, int dCol, const GridLocation& goal) const;
+    uint32_t JumpVertical(const Grid& maze, size_t row, size_t col, int dRow, const GridLocation& goal) const;
+};
+
+#endif //JUMPPOINTSOLVER_H
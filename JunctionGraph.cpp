@@ -0,0 +1,423 @@
+//
+// Method implementation for the JunctionGraph Class
+// Date: 10/18/2026
+//
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include "JunctionGraph.h"
+
+const uint32_t JunctionGraph::NO_NODE;
+
+// Cached graph files are this header followed by the node and edge arrays
+struct JunctionGraphHeader {
+    char magic[8];              // "MAZEJGR\0"
+    uint32_t version;           // 1
+    uint32_t reserved;          // zero
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t fingerprint;       // Fingerprint of the maze
+    uint32_t start;
+    uint32_t goal;
+    uint32_t startNode;
+    uint32_t goalNode;
+    uint64_t nodes;
+    uint64_t edges;
+};
+
+static const char JGR_MAGIC[8] = { 'M', 'A', 'Z', 'E', 'J', 'G', 'R', '\0' };
+static const uint32_t JGR_VERSION = 1;
+
+/**
+ * Default constructor
+ * Creates the graph of an 0x0 maze
+ */
+JunctionGraph::JunctionGraph() {
+    _nRows = 0;
+    _nCols = 0;
+    _start = 0;
+    _goal = 0;
+    _fingerprint = 0;
+    _startNode = NO_NODE;
+    _goalNode = NO_NODE;
+}
+
+/**
+ * Hash the dimensions and cells of a maze, to tell whether a cached graph fits it
+ * @param maze the maze
+ * @return fingerprint
+ */
+uint64_t JunctionGraph::Fingerprint(const Grid& maze) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+
+    hash = (hash ^ maze.NumberRows()) * 0x100000001B3ull;
+    hash = (hash ^ maze.NumberCols()) * 0x100000001B3ull;
+    for (size_t row = 0; row < maze.NumberRows(); row++) {
+        for (size_t word = 0; word < maze.WordsPerRow(); word++) {
+            hash = (hash ^ maze.RowWord(row, word)) * 0x100000001B3ull;
+        }
+    }
+    return hash;
+}
+
+/**
+ * Determine whether a move from a cell stays in the grid and lands on an open
+ * cell, as GenerateValidMoves decides
+ * @param maze the maze
+ * @param cell linear index of the cell
+ * @param dir 0 .. 3 for North, East, South, West
+ * @return true if the move is valid
+ */
+inline bool JunctionGraph::CanStep(const Grid& maze, uint32_t cell, unsigned dir) {
+    size_t nCols = maze.NumberCols();
+    size_t row = cell / nCols;
+    size_t col = cell - row * nCols;
+
+    switch (dir) {
+        case 0:
+            return row > 0 && maze[GridLocation(row - 1, col)];
+        case 1:
+            return col + 1 < nCols && maze[GridLocation(row, col + 1)];
+        case 2:
+            return row + 1 < maze.NumberRows() && maze[GridLocation(row + 1, col)];
+        default:
+            return col > 0 && maze[GridLocation(row, col - 1)];
+    }
+}
+
+/**
+ * Return the cell one move from another
+ * @param maze the maze
+ * @param cell linear index of the cell
+ * @param dir 0 .. 3 for North, East, South, West; the move must stay in the grid
+ * @return linear index of the neighbor
+ */
+inline uint32_t JunctionGraph::Step(const Grid& maze, uint32_t cell, unsigned dir) {
+    uint32_t nCols = (uint32_t) maze.NumberCols();
+
+    switch (dir) {
+        case 0:
+            return cell - nCols;
+        case 1:
+            return cell + 1;
+        case 2:
+            return cell + nCols;
+        default:
+            return cell - 1;
+    }
+}
+
+/**
+ * Contract a maze into its junction graph
+ * Every open cell that doesn't have exactly two open neighbors becomes a node,
+ * as do the start and goal.  Then from each node, each way out is followed
+ * through the corridor cells, which have only one way on, to the node at the
+ * other end.
+ * @param maze the maze
+ * @param start where routes begin
+ * @param goal where routes end
+ */
+void JunctionGraph::Build(const Grid& maze, const GridLocation& start, const GridLocation& goal) {
+    size_t nCells = maze.NumberRows() * maze.NumberCols();
+    vector<uint32_t> nodeOf(nCells, NO_NODE);
+
+    assert(nCells < NO_NODE);
+    _nRows = maze.NumberRows();
+    _nCols = maze.NumberCols();
+    _start = (uint32_t) (start.Row() * _nCols + start.Col());
+    _goal = (uint32_t) (goal.Row() * _nCols + goal.Col());
+    _fingerprint = Fingerprint(maze);
+    _nodeCell.clear();
+    _edgeBegin.clear();
+    _edgeTarget.clear();
+    _edgeLength.clear();
+    _edgeDirection.clear();
+
+    for (uint32_t cell = 0; cell < nCells; cell++) {
+        if (maze[GridLocation(cell / _nCols, cell % _nCols)]) {
+            unsigned degree = 0;
+
+            for (unsigned dir = 0; dir < 4; dir++) {
+                degree += CanStep(maze, cell, dir);
+            }
+            if (degree != 2 || cell == _start || cell == _goal) {
+                nodeOf[cell] = (uint32_t) _nodeCell.size();
+                _nodeCell.push_back(cell);
+            }
+        }
+    }
+    _startNode = (maze.IsWithinGrid(start) && maze[start]) ? nodeOf[_start] : NO_NODE;
+    _goalNode = (maze.IsWithinGrid(goal) && maze[goal]) ? nodeOf[_goal] : NO_NODE;
+
+    for (uint32_t node = 0; node < _nodeCell.size(); node++) {
+        _edgeBegin.push_back((uint32_t) _edgeTarget.size());
+        for (unsigned dir = 0; dir < 4; dir++) {
+            if (!CanStep(maze, _nodeCell[node], dir)) {
+                continue;
+            }
+
+            // Follow the corridor: each cell in it has one way on besides the way in
+            uint32_t cell = Step(maze, _nodeCell[node], dir);
+            unsigned arrived = dir;
+            uint32_t length = 1;
+            while (nodeOf[cell] == NO_NODE) {
+                unsigned back = (arrived + 2) % 4;
+                unsigned next = 0;
+
+                while (next == back || !CanStep(maze, cell, next)) {
+                    next++;
+                }
+                cell = Step(maze, cell, next);
+                arrived = next;
+                length++;
+            }
+
+            // A corridor leading back to where it started never shortens a route
+            if (nodeOf[cell] != node) {
+                _edgeTarget.push_back(nodeOf[cell]);
+                _edgeLength.push_back(length);
+                _edgeDirection.push_back((uint8_t) dir);
+            }
+        }
+    }
+    _edgeBegin.push_back((uint32_t) _edgeTarget.size());
+}
+
+/**
+ * Follow a corridor the way Build did, the first move given and every move
+ * after that along the only way on besides the way back
+ * @param maze the maze the graph was built from
+ * @param cell linear index of the cell the corridor leaves, updated to the cell it reaches
+ * @param dir 0 .. 3 for North, East, South, West, the first move
+ * @param length number of moves
+ * @param path if not nullptr, receives each cell reached, pushed in order
+ * @return true if every move stays on open cells, false if the corridor breaks off
+ */
+bool JunctionGraph::FollowCorridor(const Grid& maze, uint32_t& cell, unsigned dir, uint32_t length,
+                                   stack<GridLocation>* path) {
+    size_t nCols = maze.NumberCols();
+
+    for (uint32_t i = 0; i < length; i++) {
+        if (i > 0) {
+            unsigned back = (dir + 2) % 4;
+
+            dir = 0;
+            while (dir < 4 && (dir == back || !CanStep(maze, cell, dir))) {
+                dir++;
+            }
+        }
+        if (dir >= 4 || !CanStep(maze, cell, dir)) {
+            return false;
+        }
+        cell = Step(maze, cell, dir);
+        if (path) {
+            path->push(GridLocation(cell / nCols, cell % nCols));
+        }
+    }
+    return true;
+}
+
+/**
+ * Push the cells of an edge's corridor onto a path, excluding its first cell
+ * @param maze the maze the graph was built from
+ * @param edge the edge, from the node whose cell is on top of the path
+ * @param path path to extend
+ */
+void JunctionGraph::PushCorridor(const Grid& maze, uint32_t edge, stack<GridLocation>& path) const {
+    uint32_t cell = (uint32_t) (path.top().Row() * _nCols + path.top().Col());
+    bool followed = FollowCorridor(maze, cell, _edgeDirection[edge], _edgeLength[edge], &path);
+
+    assert(followed);
+    (void) followed;
+}
+
+/**
+ * Find a shortest route from the start to the goal
+ * Dijkstra's algorithm over the nodes, weighted by corridor length.  Only the
+ * corridors on the route found are expanded back into cells.
+ * @param maze the maze the graph was built from
+ * @param solution out parameter, receives the route with start at the bottom and goal on top
+ * @param stats if not nullptr, receives the number of nodes settled
+ * @return true if a route exists, false otherwise
+ */
+bool JunctionGraph::Solve(const Grid& maze, stack<GridLocation>& solution, SolveStats* stats) {
+    size_t settled = 0;
+    bool found = false;
+
+    assert(maze.NumberRows() == _nRows && maze.NumberCols() == _nCols);
+    if (_startNode != NO_NODE && _goalNode != NO_NODE) {
+        _distance.assign(_nodeCell.size(), UINT32_MAX);
+        _parentEdge.resize(_nodeCell.size());
+        _parentNode.resize(_nodeCell.size());
+        _open.Clear();
+
+        _distance[_startNode] = 0;
+        _parentNode[_startNode] = _startNode;
+        _open.Push(0, _startNode);
+        while (!_open.Empty() && !found) {
+            uint32_t key;
+            uint32_t node = _open.Pop(key);
+
+            if (key != _distance[node]) {
+                continue;
+            }
+            settled++;
+            found = (node == _goalNode);
+            for (uint32_t edge = _edgeBegin[node]; edge < _edgeBegin[node + 1] && !found; edge++) {
+                uint32_t target = _edgeTarget[edge];
+                uint32_t distance = key + _edgeLength[edge];
+
+                if (distance < _distance[target]) {
+                    _distance[target] = distance;
+                    _parentEdge[target] = edge;
+                    _parentNode[target] = node;
+                    _open.Push(distance, target);
+                }
+            }
+        }
+    }
+
+    if (found) {
+        vector<uint32_t> edges;
+
+        for (uint32_t node = _goalNode; node != _startNode; node = _parentNode[node]) {
+            edges.push_back(_parentEdge[node]);
+        }
+        solution = stack<GridLocation>();
+        solution.push(GridLocation(_start / _nCols, _start % _nCols));
+        for (size_t i = edges.size(); i > 0; i--) {
+            PushCorridor(maze, edges[i-1], solution);
+        }
+    }
+    if (stats) {
+        stats->cellsExpanded = settled;
+    }
+    return found;
+}
+
+/**
+ * Save the graph, to be loaded instead of rebuilt for the same maze
+ * @param path pathname of the file to write
+ * @return true if the file was written, false if not
+ */
+bool JunctionGraph::Save(const string& path) const {
+    JunctionGraphHeader header;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, JGR_MAGIC, sizeof(JGR_MAGIC));
+    header.version = JGR_VERSION;
+    header.rows = _nRows;
+    header.cols = _nCols;
+    header.fingerprint = _fingerprint;
+    header.start = _start;
+    header.goal = _goal;
+    header.startNode = _startNode;
+    header.goalNode = _goalNode;
+    header.nodes = _nodeCell.size();
+    header.edges = _edgeTarget.size();
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+                   && fwrite(_nodeCell.data(), sizeof(uint32_t), _nodeCell.size(), file) == _nodeCell.size()
+                   && fwrite(_edgeBegin.data(), sizeof(uint32_t), _edgeBegin.size(), file) == _edgeBegin.size()
+                   && fwrite(_edgeTarget.data(), sizeof(uint32_t), _edgeTarget.size(), file) == _edgeTarget.size()
+                   && fwrite(_edgeLength.data(), sizeof(uint32_t), _edgeLength.size(), file) == _edgeLength.size()
+                   && fwrite(_edgeDirection.data(), 1, _edgeDirection.size(), file) == _edgeDirection.size();
+    return fclose(file) == 0 && written;
+}
+
+/**
+ * Load a graph saved by Save, if it was built from this maze, start and goal
+ * On failure the graph is left as it was.
+ * @param path pathname of the file to read
+ * @param maze the maze the graph must have been built from
+ * @param start where routes must begin
+ * @param goal where routes must end
+ * @return true if the graph was loaded, false if the file is missing, malformed,
+ *         or was built for something else
+ */
+bool JunctionGraph::Load(const string& path, const Grid& maze, const GridLocation& start, const GridLocation& goal) {
+    JunctionGraphHeader header;
+    FILE* file = fopen(path.c_str(), "rb");
+
+    if (file == nullptr) {
+        return false;
+    }
+    bool loaded = fread(&header, sizeof(header), 1, file) == 1
+                  && memcmp(header.magic, JGR_MAGIC, sizeof(JGR_MAGIC)) == 0 && header.version == JGR_VERSION
+                  && header.rows == maze.NumberRows() && header.cols == maze.NumberCols()
+                  && header.start == start.Row() * maze.NumberCols() + start.Col()
+                  && header.goal == goal.Row() * maze.NumberCols() + goal.Col()
+                  && header.nodes <= header.rows * header.cols && header.edges <= 4 * header.nodes
+                  && header.fingerprint == Fingerprint(maze);
+
+    vector<uint32_t> nodeCell;
+    vector<uint32_t> edgeBegin;
+    vector<uint32_t> edgeTarget;
+    vector<uint32_t> edgeLength;
+    vector<uint8_t> edgeDirection;
+    if (loaded) {
+        nodeCell.resize(header.nodes);
+        edgeBegin.resize(header.nodes + 1);
+        edgeTarget.resize(header.edges);
+        edgeLength.resize(header.edges);
+        edgeDirection.resize(header.edges);
+        loaded = fread(nodeCell.data(), sizeof(uint32_t), nodeCell.size(), file) == nodeCell.size()
+                 && fread(edgeBegin.data(), sizeof(uint32_t), edgeBegin.size(), file) == edgeBegin.size()
+                 && fread(edgeTarget.data(), sizeof(uint32_t), edgeTarget.size(), file) == edgeTarget.size()
+                 && fread(edgeLength.data(), sizeof(uint32_t), edgeLength.size(), file) == edgeLength.size()
+                 && fread(edgeDirection.data(), 1, edgeDirection.size(), file) == edgeDirection.size()
+                 && edgeBegin.front() == 0 && edgeBegin.back() == header.edges
+                 && (header.startNode < header.nodes || header.startNode == NO_NODE)
+                 && (header.goalNode < header.nodes || header.goalNode == NO_NODE);
+        for (size_t node = 0; node < header.nodes && loaded; node++) {
+            loaded = edgeBegin[node] <= edgeBegin[node + 1];
+        }
+        for (size_t edge = 0; edge < header.edges && loaded; edge++) {
+            loaded = edgeTarget[edge] < header.nodes && edgeDirection[edge] < 4;
+        }
+        for (size_t node = 0; node < header.nodes && loaded; node++) {
+            loaded = nodeCell[node] < header.rows * header.cols
+                     && maze[GridLocation(nodeCell[node] / header.cols, nodeCell[node] % header.cols)];
+        }
+        loaded = loaded && (header.startNode == NO_NODE || nodeCell[header.startNode] == header.start)
+                 && (header.goalNode == NO_NODE || nodeCell[header.goalNode] == header.goal);
+
+        // Walk every corridor once, so expanding a route can't leave the maze.
+        // Each corridor cell lies on one corridor, walked once from each end, so a
+        // graph Build made never needs more moves than this.
+        uint64_t moves = 0;
+        for (uint32_t node = 0; node < header.nodes && loaded; node++) {
+            for (uint32_t edge = edgeBegin[node]; edge < edgeBegin[node + 1] && loaded; edge++) {
+                uint32_t cell = nodeCell[node];
+
+                moves += edgeLength[edge];
+                loaded = edgeLength[edge] > 0 && moves <= 2 * header.rows * header.cols + header.edges
+                         && FollowCorridor(maze, cell, edgeDirection[edge], edgeLength[edge], nullptr)
+                         && cell == nodeCell[edgeTarget[edge]];
+            }
+        }
+    }
+    fclose(file);
+    if (!loaded) {
+        return false;
+    }
+
+    _nRows = header.rows;
+    _nCols = header.cols;
+    _start = header.start;
+    _goal = header.goal;
+    _fingerprint = header.fingerprint;
+    _startNode = header.startNode;
+    _goalNode = header.goalNode;
+    _nodeCell.swap(nodeCell);
+    _edgeBegin.swap(edgeBegin);
+    _edgeTarget.swap(edgeTarget);
+    _edgeLength.swap(edgeLength);
+    _edgeDirection.swap(edgeDirection);
+    return true;
+}
@@ -0,0 +1,88 @@
+//
+// Interface Definition for the JunctionGraph Class
+// A maze contracted to a weighted graph: the nodes are junctions, dead ends, the
+// start and the goal, and each edge is a corridor of cells with one way on
+// Date: 10/18/2026
+//
+
+#ifndef JUNCTIONGRAPH_H
+#define JUNCTIONGRAPH_H
+
+#include <cstdint>
+#include <stack>
+#include <string>
+#include <vector>
+using std::stack;
+using std::string;
+using std::vector;
+
+#include "Grid.h"
+#include "RadixHeap.h"
+#include "Solver.h"
+
+class JunctionGraph {
+public:
+    JunctionGraph();
+
+    void Build(const Grid& maze, const GridLocation& start, const GridLocation& goal);
+    bool Solve(const Grid& maze, stack<GridLocation>& solution, SolveStats* stats);
+
+    bool Save(const string& path) const;
+    bool Load(const string& path, const Grid& maze, const GridLocation& start, const GridLocation& goal);
+
+    size_t NumberNodes() const;
+    size_t NumberEdges() const;
+
+private:
+    static const uint32_t NO_NODE = UINT32_MAX;
+
+    static uint64_t Fingerprint(const Grid& maze);
+    static uint32_t Step(const Grid& maze, uint32_t cell, unsigned dir);
+    static bool CanStep(const Grid& maze, uint32_t cell, unsigned dir);
+    static bool FollowCorridor(const Grid& maze, uint32_t& cell, unsigned dir, uint32_t length,
+                               stack<GridLocation>* path);
+    void PushCorridor(const Grid& maze, uint32_t edge, stack<GridLocation>& path) const;
+
+    // What the graph was built from, so a cached graph can be matched to a maze
+    size_t _nRows;
+    size_t _nCols;
+    uint32_t _start;
+    uint32_t _goal;
+    uint64_t _fingerprint;
+
+    // Nodes, each a cell, and their edges in compressed rows: the edges leaving
+    // node n are _edgeBegin[n] .. _edgeBegin[n+1] - 1.  An edge runs _edgeLength
+    // moves, the first in direction _edgeDirection (North, East, South, West as
+    // 0 .. 3), and from then on along the only way on.
+    vector<uint32_t> _nodeCell;
+    vector<uint32_t> _edgeBegin;
+    vector<uint32_t> _edgeTarget;
+    vector<uint32_t> _edgeLength;
+    vector<uint8_t> _edgeDirection;
+    uint32_t _startNode;
+    uint32_t _goalNode;
+
+    // Dijkstra's state, kept between solves
+    vector<uint32_t> _distance;
+    vector<uint32_t> _parentEdge;
+    vector<uint32_t> _parentNode;
+    RadixHeap<uint32_t> _open;
+};
+
+/**
+ * Return number of nodes: junctions, dead ends, start and goal
+ * @return number of nodes
+ */
+inline size_t JunctionGraph::NumberNodes() const {
+    return _nodeCell.size();
+}
+
+/**
+ * Return number of edges, counting each corridor once in each direction
+ * @return number of edges
+ */
+inline size_t JunctionGraph::NumberEdges() const {
+    return _edgeTarget.size();
+}
+
+#endif //JUNCTIONGRAPH_H
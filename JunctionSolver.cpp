@@ -0,0 +1,31 @@
+//
+// Method implementation for the JunctionSolver Class
+// Date: 10/18/2026
+//
+
+#include "JunctionSolver.h"
+
+/**
+ * Return name of the algorithm
+ * @return "junction"
+ */
+const char* JunctionSolver::Name() const {
+    return "junction";
+}
+
+/**
+* Find a shortest route over the maze's junction graph
+* The graph is built afresh for every call; to solve the same maze again without
+* rebuilding it, use a JunctionGraph directly and save it with Save().
+* @param maze the maze that we want to solve
+* @param start where the route begins
+* @param goal where the route ends
+* @param solution out parameter used to return solution if it is found
+* @param stats if not nullptr, receives the number of graph nodes settled
+* @return true if solution can be found, false otherwise
+*/
+bool JunctionSolver::Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+                           stack<GridLocation>& solution, SolveStats* stats) {
+    _graph.Build(maze, start, goal);
+    return _graph.Solve(maze, solution, stats);
+}
@@ -0,0 +1,24 @@
+//
+// Interface Definition for the JunctionSolver Class
+// Contracts the maze to its junction graph, then runs Dijkstra's algorithm over
+// the graph instead of walking corridors a cell at a time
+// Date: 10/18/2026
+//
+
+#ifndef JUNCTIONSOLVER_H
+#define JUNCTIONSOLVER_H
+
+#include "Solver.h"
+#include "JunctionGraph.h"
+
+class JunctionSolver : public Solver {
+public:
+    const char* Name() const override;
+    bool Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+               stack<GridLocation>& solution, SolveStats* stats) override;
+
+private:
+    JunctionGraph _graph;
+};
+
+#endif //JUNCTIONSOLVER_H
@@ -8,84 +8,140 @@
 
 #include <cassert>
 #include <stack>
-#include <queue>
-#include <set>
 using std::stack;
-using std::queue;
-using std::set;
 
 #include "Grid.h"
+#include "CellHandle.h"
 #include "CursesWindow.h"
 #include "Maze.h"
+#include "BfsSolver.h"
+#include "ConnectivityIndex.h"
+#include "VisitedSet.h"
 
 /**
 * Attempt to solve the maze using a breadth first algorithm
 * @param maze the maze that we want to solve
 * @param solution out parameter used to return solution if it is found
 * @param pwindow if not nullptr, used to animate the solution process
+* @param stats if not nullptr, receives the amount of work done
 * @return true if solution can be found, false otherwise
 */
-bool SolveMaze(const Grid& maze, stack<GridLocation>& solution, CursesWindow* pwindow) {
+bool SolveMaze(const Grid& maze, stack<GridLocation>& solution, CursesWindow* pwindow, SolveStats* stats) {
+    BfsSolver solver(pwindow);
 
-    GridLocation start = (GridLocation(0, 0));
-    if (!maze[start]) {
+    return SolveMaze(maze, solution, solver, stats);
+}
+
+/**
+* Attempt to solve the maze, from the upper left corner to the lower right corner
+* @param maze the maze that we want to solve
+* @param solution out parameter used to return solution if it is found
+* @param solver the algorithm to solve it with
+* @param stats if not nullptr, receives the amount of work done
+* @return true if solution can be found, false otherwise
+*/
+bool SolveMaze(const Grid& maze, stack<GridLocation>& solution, Solver& solver, SolveStats* stats) {
+    if (maze.NumberRows() == 0 || maze.NumberCols() == 0) {
+        if (stats) {
+            stats->cellsExpanded = 0;
+        }
         return false;
     }
+    return solver.Solve(maze, GridLocation(0, 0), GridLocation(maze.NumberRows() - 1, maze.NumberCols() - 1),
+                        solution, stats);
+}
 
-    queue<stack<GridLocation>> paths;
-    stack<GridLocation> currentPath;
-    currentPath.push(start);
-    paths.push(currentPath);
+/**
+* Attempt to find a route between any two cells using a breadth first algorithm
+* @param maze the maze that we want to solve
+* @param index connectivity index built from the maze, consulted before searching
+* @param start where the route begins
+* @param goal where the route ends
+* @param solution out parameter used to return solution if it is found
+* @param stats if not nullptr, receives the amount of work done
+* @return true if a route exists, false otherwise
+*/
+bool SolveMaze(const Grid& maze, const ConnectivityIndex& index, const GridLocation& start, const GridLocation& goal,
+               stack<GridLocation>& solution, SolveStats* stats) {
+    BfsSolver solver;
+    return SolveMaze(maze, index, start, goal, solution, solver, stats);
+}
 
-    int cur = 1;
-    vector<GridLocation> vec[50];
-    vec->push_back(start);
+/**
+* Attempt to find a route between any two cells
+* The index answers whether a route exists, so a search only starts when it will
+* succeed.
+* @param maze the maze that we want to solve
+* @param index connectivity index built from the maze, consulted before searching
+* @param start where the route begins
+* @param goal where the route ends
+* @param solution out parameter used to return solution if it is found
+* @param solver the algorithm to solve it with
+* @param stats if not nullptr, receives the amount of work done
+* @return true if a route exists, false otherwise
+*/
+bool SolveMaze(const Grid& maze, const ConnectivityIndex& index, const GridLocation& start, const GridLocation& goal,
+               stack<GridLocation>& solution, Solver& solver, SolveStats* stats) {
+    assert(index.NumberRows() == maze.NumberRows() && index.NumberCols() == maze.NumberCols());
+    if (!index.Connected(start, goal)) {
+        if (stats) {
+            stats->cellsExpanded = 0;
+            stats->levelModes.clear();
+        }
+        return false;
+    }
+    return solver.Solve(maze, start, goal, solution, stats);
+}
 
-    set<GridLocation> visited;
-    visited.insert(start);
+/**
+* Generate the valid moves out of a batch of cells at once, as masks
+* Bit (1 << Direction) of a cell's mask is set if the move that way stays
+* within the maze and lands on an open cell.  Each neighbor is tested against
+* the edge it would cross, rather than counting on a step off the top or left
+* to wrap around.
+* In bit per cell storage, a run of cells in the same row word (a row scan,
+* say) shares the four row-shifted neighbor words of that word, which hold the
+* moves of all 64 of its cells; each cell's mask is its bit of each.  A cell
+* on its own, and any cell in byte per cell storage, reads its four neighbors
+* directly, which costs less than building the words from a byte per cell.
+* @param maze the maze that we want to solve
+* @param cells grid locations that we want to move from
+* @param count number of cells
+* @param masks receives one mask per cell
+*/
+void GenerateValidMoves(const Grid& maze, const GridLocation cells[], size_t count, unsigned char masks[]) {
+    size_t lastRow = maze.NumberRows() - 1;
+    size_t lastCol = maze.NumberCols() - 1;
+    bool bits = maze.Storage() == GridStorage::Bits;
+    size_t wordRow = SIZE_MAX;
+    size_t word = SIZE_MAX;
+    uint64_t neighbors[4] = { 0, 0, 0, 0 };
 
-    while (!paths.empty()) {
-            currentPath = paths.front();
-            paths.pop();
+    for (size_t i = 0; i < count; i++) {
+        size_t row = cells[i].Row();
+        size_t col = cells[i].Col();
+        unsigned mask = 0;
 
-            if (pwindow) {
-                pwindow->ShowPath(currentPath, false);
+        if (row != wordRow || col / 64 != word) {
+            if (!bits || i + 1 == count || cells[i + 1].Row() != row || cells[i + 1].Col() / 64 != col / 64) {
+                mask |= (row > 0 && maze[GridLocation(row - 1, col)]) << (int) Direction::North;
+                mask |= (col < lastCol && maze[GridLocation(row, col + 1)]) << (int) Direction::East;
+                mask |= (row < lastRow && maze[GridLocation(row + 1, col)]) << (int) Direction::South;
+                mask |= (col > 0 && maze[GridLocation(row, col - 1)]) << (int) Direction::West;
+                masks[i] = (unsigned char) mask;
+                continue;
             }
-
-            GridLocation moves[4];
-            size_t count = 0;
-            GenerateValidMoves(maze, currentPath.top(), moves, count);
-
-            for (int i = 0; i < count; i++) {
-
-                stack<GridLocation> newPath;
-                newPath = currentPath;
-
-                int found = 0;
-                for (int p = 0; p < cur; p++) {
-                    if (moves[i] == vec->at(p)) {
-                        found = 1;
-                    }
-                }
-
-
-                if (found == 0) {
-
-                    newPath.push(moves[i]);
-                    vec->push_back(moves[i]);
-                    cur++;
-                    paths.push(newPath);
-
-                }
-                if (newPath.top() == GridLocation(maze.NumberRows() - 1, maze.NumberCols() - 1)) {
-
-                    solution = newPath;
-                    return true;
-
-                }
+            wordRow = row;
+            word = col / 64;
+            for (unsigned dir = 0; dir < 4; dir++) {
+                neighbors[dir] = maze.NeighborWord(row, word, (Direction) dir);
             }
         }
-    return false;
+        for (unsigned dir = 0; dir < 4; dir++) {
+            mask |= (unsigned) ((neighbors[dir] >> (col % 64)) & 1) << dir;
+        }
+        masks[i] = (unsigned char) mask;
+    }
 }
 
 /**
@@ -95,75 +151,112 @@ bool SolveMaze(const Grid& maze, stack<GridLocation>& solution, CursesWindow* pw
 * @return set of valid moves
 */
 void GenerateValidMoves(const Grid& maze, const GridLocation& loc, GridLocation moves[], size_t& count) {
-    GridLocation n = (GridLocation(loc.Row() - 1, loc.Col()));
-    GridLocation e = (GridLocation(loc.Row(), loc.Col() + 1));
-    GridLocation s = (GridLocation(loc.Row() + 1, loc.Col()));
-    GridLocation w = (GridLocation(loc.Row(), loc.Col() - 1));
+    unsigned char mask;
+
+    GenerateValidMoves(maze, &loc, 1, &mask);
     count = 0;
-    if (maze.IsWithinGrid(n)) {
-        if (maze[n]) {
-            moves[count] = n;
-            count++;
-        }
+    if (mask & (1 << (int) Direction::North)) {
+        moves[count++] = GridLocation(loc.Row() - 1, loc.Col());
     }
-    if (maze.IsWithinGrid(e)) {
-        if (maze[e]) {
-            moves[count] = e;
-            count++;
-        }
+    if (mask & (1 << (int) Direction::East)) {
+        moves[count++] = GridLocation(loc.Row(), loc.Col() + 1);
     }
-    if (maze.IsWithinGrid(s)) {
-        if (maze[s]) {
-            moves[count] = s;
-            count++;
-        }
+    if (mask & (1 << (int) Direction::South)) {
+        moves[count++] = GridLocation(loc.Row() + 1, loc.Col());
     }
-    if (maze.IsWithinGrid(w)) {
-        if (maze[w]) {
-            moves[count] = w;
-            count++;
-        }
+    if (mask & (1 << (int) Direction::West)) {
+        moves[count++] = GridLocation(loc.Row(), loc.Col() - 1);
     }
 }
 
+// Gives read access to the cells under a stack, so a solution can be walked in
+// place, start first, rather than copied and popped
+struct SolutionCells : stack<GridLocation> {
+    static const stack<GridLocation>::container_type& Of(const stack<GridLocation>& path) {
+        return path.*(&SolutionCells::c);
+    }
+};
+
 /**
-* Check whether a purported solution is really a solution
+* Check a route from the upper left corner to the lower right corner in one pass
+* Each cell must be within the maze and open, a single move (Manhattan distance
+* 1, which for handles means a difference of 1 or the stride) from the one
+* before it, and not visited before.  Visits are kept in a set per thread that
+* only ever grows; the cells inserted are removed again on the way out, so a
+* check costs time in proportion to the route, not the maze.
 * @param maze the maze that we want to solve
-* @param path solution to check
-* @return true it solves the maze, false it doesn't
+* @param first the route's first cell
+* @param length number of cells on the route
+* @param distance if not nullptr, distances from the upper left corner, from
+*        ComputeDistanceField, and the route must also be a shortest one
+* @return true if the route solves the maze, false if it doesn't
 */
-bool CheckSolution(const Grid& maze, stack<GridLocation> path) {
-    set<GridLocation> old;
-    size_t count = 0;
-    GridLocation current = (GridLocation(maze.NumberRows() - 1, maze.NumberCols() - 1));
-    GridLocation end = (GridLocation(0, 0));
-    if (current == path.top()) {
-        old.insert(path.top());
-        path.pop();
-        current = path.top();
-        while (!path.empty()) {
-            GridLocation valMove[4];
-            GenerateValidMoves(maze, current, valMove, count);
-            for (int i = 0; i < count; i++) {
-                if (maze[current] && maze[valMove[i]]) {
-                    if (old.count(current) == 0) {
-                        old.insert(path.top());
-                        path.pop();
-                        if (!path.empty()) {
-                            current = path.top();
-                        }
-                    } else {
-                        return false;
-                    }
-                } else {
-                    return false;
-                }
-            }
+template <typename Iterator>
+static bool CheckRoute(const Grid& maze, Iterator first, size_t length, const vector<uint32_t>* distance) {
+    static thread_local VisitedSet visited;
+    size_t nRows = maze.NumberRows();
+    size_t nCols = maze.NumberCols();
+
+    if (length == 0 || nRows == 0 || nCols == 0 || !(*first == GridLocation(0, 0))) {
+        return false;
+    }
+
+    CellLayout layout(nRows, nCols);
+    CellHandle previous;
+    Iterator cell = first;
+    size_t checked = 0;
+
+    if (visited.Capacity() < layout.NumberHandles()) {
+        visited.Configure(layout.NumberHandles());
+    }
+    for (; checked < length; checked++, ++cell) {
+        if (!maze.IsWithinGrid(*cell) || !maze[*cell]) {
+            break;
         }
-        if (current == end) {
-            return true;
+        CellHandle handle = layout.ToHandle(*cell);
+        if ((checked > 0 && !layout.AreAdjacent(previous, handle)) || !visited.Insert(handle.Index())) {
+            break;
         }
+        previous = handle;
+    }
+    bool valid = (checked == length) && previous == layout.ToHandle(GridLocation(nRows - 1, nCols - 1));
+
+    // Exactly the first "checked" cells went into the set
+    cell = first;
+    for (size_t i = 0; i < checked; i++, ++cell) {
+        visited.Remove(layout.ToHandle(*cell).Index());
+    }
+
+    if (valid && distance) {
+        assert(distance->size() == nRows * nCols);
+        valid = (*distance)[nRows * nCols - 1] == length - 1;
     }
-    return false;
+    return valid;
 }
 
+/**
+* Check whether a purported solution is really a solution
+* @param maze the maze that we want to solve
+* @param path solution to check, with the upper left corner at the bottom
+* @param distance if not nullptr, distances from the upper left corner, as
+*        ComputeDistanceField(maze, GridLocation(0, 0)) returns them, and the
+*        solution must also be a shortest one
+* @return true it solves the maze, false it doesn't
+*/
+bool CheckSolution(const Grid& maze, const stack<GridLocation>& path, const vector<uint32_t>* distance) {
+    return CheckRoute(maze, SolutionCells::Of(path).begin(), path.size(), distance);
+}
+
+/**
+* Check whether a purported solution, held in an array, is really a solution
+* @param maze the maze that we want to solve
+* @param path solution to check, upper left corner first
+* @param length number of cells in the solution
+* @param distance if not nullptr, distances from the upper left corner, as
+*        ComputeDistanceField(maze, GridLocation(0, 0)) returns them, and the
+*        solution must also be a shortest one
+* @return true it solves the maze, false it doesn't
+*/
+bool CheckSolution(const Grid& maze, const GridLocation* path, size_t length, const vector<uint32_t>* distance) {
+    return CheckRoute(maze, path, length, distance);
+}
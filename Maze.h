@@ -7,8 +7,27 @@
 #ifndef MAZE_H
 #define MAZE_H
 
-bool SolveMaze(const Grid& maze, stack<GridLocation>& solution, CursesWindow* pwindow = nullptr);
+class Solver;
+struct SolveStats;
+class ConnectivityIndex;
+
+// Distance of a cell that can't be reached
+const uint32_t UNREACHABLE = UINT32_MAX;
+
+bool SolveMaze(const Grid& maze, stack<GridLocation>& solution, CursesWindow* pwindow = nullptr, SolveStats* stats = nullptr);
+bool SolveMaze(const Grid& maze, stack<GridLocation>& solution, Solver& solver, SolveStats* stats = nullptr);
+bool SolveMaze(const Grid& maze, const ConnectivityIndex& index, const GridLocation& start, const GridLocation& goal,
+               stack<GridLocation>& solution, SolveStats* stats = nullptr);
+bool SolveMaze(const Grid& maze, const ConnectivityIndex& index, const GridLocation& start, const GridLocation& goal,
+               stack<GridLocation>& solution, Solver& solver, SolveStats* stats = nullptr);
 void GenerateValidMoves(const Grid& maze, const GridLocation& loc, GridLocation moves[], size_t& count);
-bool CheckSolution(const Grid& maze, stack<GridLocation> path);
+void GenerateValidMoves(const Grid& maze, const GridLocation cells[], size_t count, unsigned char masks[]);
+bool CheckSolution(const Grid& maze, const stack<GridLocation>& path, const vector<uint32_t>* distance = nullptr);
+bool CheckSolution(const Grid& maze, const GridLocation* path, size_t length, const vector<uint32_t>* distance = nullptr);
+bool IsSolvable(const Grid& maze);
+size_t FillDeadEnds(Grid& maze, const GridLocation& start, const GridLocation& goal);
+bool IsSolvableStream(istream& is, bool& solvable);
+vector<uint32_t> ComputeDistanceField(const Grid& maze, const GridLocation& source);
+bool SaveDistanceField(const string& path, const Grid& maze, const GridLocation& source, const vector<uint32_t>& distance);
 
 #endif //MAZE_H
@@ -0,0 +1,1235 @@
+//
+// Maze solver benchmark program
+// Date: 10/18/2026
+//
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stack>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <sys/resource.h>
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::ifstream;
+using std::setw;
+using std::stack;
+using std::string;
+using std::vector;
+
+#include "Grid.h"
+#include "CursesWindow.h"
+#include "Maze.h"
+#include "Solver.h"
+#include "BfsSolver.h"
+#include "ParallelBfsSolver.h"
+#include "MazeSolver.h"
+#include "HierarchicalGraph.h"
+#include "DynamicSolver.h"
+#include "AStarSolver.h"
+#include "BorderedGrid.h"
+
+// Forward declarations of benchmark functions
+void BenchGridLayout();
+void BenchParallel();
+void BenchMoveMasks();
+void BenchHierarchy(size_t size);
+void BenchDynamic(size_t size);
+void BenchSuite(size_t maxSize, bool json);
+
+int main(int argc, char* argv[]) {
+    // Process arguments
+    if (argc == 2 && strcmp(argv[1], "--layout") == 0) {
+        BenchGridLayout();
+        return 0;
+    }
+    else if (argc == 2 && strcmp(argv[1], "--parallel") == 0) {
+        BenchParallel();
+        return 0;
+    }
+    else if (argc == 2 && strcmp(argv[1], "--moves") == 0) {
+        BenchMoveMasks();
+        return 0;
+    }
+    else if ((argc == 2 || (argc == 3 && atoi(argv[2]) > 0)) && strcmp(argv[1], "--hierarchy") == 0) {
+        BenchHierarchy(argc == 3 ? (size_t) atoi(argv[2]) : 10000);
+        return 0;
+    }
+    else if ((argc == 2 || (argc == 3 && atoi(argv[2]) > 0)) && strcmp(argv[1], "--dynamic") == 0) {
+        BenchDynamic(argc == 3 ? (size_t) atoi(argv[2]) : 2000);
+        return 0;
+    }
+    else if (argc >= 2 && argc <= 4 && strcmp(argv[1], "--suite") == 0) {
+        bool json = argc >= 3 && strcmp(argv[2], "json") == 0;
+        bool named = argc >= 3 && (json || strcmp(argv[2], "csv") == 0);
+        int maxSize = (argc == 4 || (argc == 3 && !named)) ? atoi(argv[argc - 1]) : 1024;
+
+        if (maxSize >= 2 && (argc != 4 || named)) {
+            BenchSuite((size_t) maxSize, json);
+            return 0;
+        }
+    }
+    cout << "Ways to run:" << '\n';
+    cout << "MazeBench --layout" << '\n';
+    cout << "MazeBench --parallel" << '\n';
+    cout << "MazeBench --moves" << '\n';
+    cout << "MazeBench --hierarchy [size]" << '\n';
+    cout << "MazeBench --dynamic [size]" << '\n';
+    cout << "MazeBench --suite [csv|json] [max size]" << '\n';
+    return 1;
+}
+
+/**
+ * The grid layout used before Grid switched to one contiguous buffer: an array
+ * of row pointers with a separate allocation per row.  Kept here only so the
+ * two layouts can be compared.
+ */
+class RowPointerGrid {
+public:
+    RowPointerGrid() {
+        _array = nullptr;
+        _nRows = 0;
+        _nCols = 0;
+    }
+    ~RowPointerGrid() {
+        Release();
+    }
+
+    void Configure(size_t nRows, size_t nCols) {
+        Release();
+        _nRows = nRows;
+        _nCols = nCols;
+        _array = (bool**) malloc(nRows * sizeof(bool*));
+        for (size_t row = 0; row < nRows; row++) {
+            _array[row] = (bool*) calloc(nCols, sizeof(bool));
+        }
+    }
+
+    size_t NumberRows() const { return _nRows; }
+    size_t NumberCols() const { return _nCols; }
+    bool IsWithinGrid(const GridLocation& loc) const { return loc.Row() < _nRows && loc.Col() < _nCols; }
+    bool operator[] (const GridLocation& loc) const { return _array[loc.Row()][loc.Col()]; }
+    bool& operator[] (const GridLocation& loc) { return _array[loc.Row()][loc.Col()]; }
+
+private:
+    RowPointerGrid(const RowPointerGrid& other);
+    RowPointerGrid& operator=(const RowPointerGrid& other);
+
+    void Release() {
+        for (size_t row = 0; row < _nRows; row++) {
+            free(_array[row]);
+        }
+        free(_array);
+        _array = nullptr;
+        _nRows = 0;
+        _nCols = 0;
+    }
+
+    bool** _array;
+    size_t _nRows;
+    size_t _nCols;
+};
+
+/**
+ * Return the median of a set of timings
+ * @param samples timings, reordered on return
+ * @return median value
+ */
+double Median(vector<double>& samples) {
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+/**
+ * Copy the contents of one grid into another with a (possibly) different layout
+ * @param from source grid
+ * @param to destination grid, reconfigured to the size of the source
+ */
+template <typename FromGrid, typename ToGrid>
+void CopyCells(const FromGrid& from, ToGrid& to) {
+    to.Configure(from.NumberRows(), from.NumberCols());
+    for (size_t row = 0; row < from.NumberRows(); row++) {
+        for (size_t col = 0; col < from.NumberCols(); col++) {
+            GridLocation loc(row, col);
+
+            to[loc] = from[loc];
+        }
+    }
+}
+
+/**
+ * Visit every open cell and count its open neighbors the way GenerateValidMoves does
+ * @param grid grid to sweep
+ * @return total number of open neighbors seen, so the work can't be optimized away
+ */
+template <typename AnyGrid>
+size_t SweepNeighbors(const AnyGrid& grid) {
+    size_t total = 0;
+
+    for (size_t row = 0; row < grid.NumberRows(); row++) {
+        for (size_t col = 0; col < grid.NumberCols(); col++) {
+            if (grid[GridLocation(row, col)]) {
+                GridLocation n(row - 1, col);
+                GridLocation e(row, col + 1);
+                GridLocation s(row + 1, col);
+                GridLocation w(row, col - 1);
+
+                total += (grid.IsWithinGrid(n) && grid[n]) + (grid.IsWithinGrid(e) && grid[e])
+                       + (grid.IsWithinGrid(s) && grid[s]) + (grid.IsWithinGrid(w) && grid[w]);
+            }
+        }
+    }
+    return total;
+}
+
+/**
+ * Visit cells in a given order and count open neighbors of the open ones, the
+ * scattered access pattern a breadth first search produces on a large grid
+ * @param grid grid to probe
+ * @param order linear indices (row * cols + col) of the cells to visit
+ * @return total number of open neighbors seen
+ */
+template <typename AnyGrid>
+size_t ProbeNeighbors(const AnyGrid& grid, const vector<uint32_t>& order) {
+    size_t nCols = grid.NumberCols();
+    size_t total = 0;
+
+    for (uint32_t index : order) {
+        size_t row = index / nCols;
+        size_t col = index % nCols;
+
+        if (grid[GridLocation(row, col)]) {
+            GridLocation n(row - 1, col);
+            GridLocation e(row, col + 1);
+            GridLocation s(row + 1, col);
+            GridLocation w(row, col - 1);
+
+            total += (grid.IsWithinGrid(n) && grid[n]) + (grid.IsWithinGrid(e) && grid[e])
+                   + (grid.IsWithinGrid(s) && grid[s]) + (grid.IsWithinGrid(w) && grid[w]);
+        }
+    }
+    return total;
+}
+
+/**
+ * Time repeated neighbor sweeps over a grid
+ * @param grid grid to sweep
+ * @param repetitions number of timed sweeps
+ * @param checksum running checksum, updated upon return
+ * @return median nanoseconds per cell
+ */
+template <typename AnyGrid>
+double TimeSweep(const AnyGrid& grid, unsigned repetitions, size_t& checksum) {
+    vector<double> samples;
+    double cells = (double) grid.NumberRows() * grid.NumberCols();
+
+    checksum += SweepNeighbors(grid);   // warm up
+    for (unsigned i = 0; i < repetitions; i++) {
+        auto begin = std::chrono::steady_clock::now();
+        checksum += SweepNeighbors(grid);
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - begin).count() / cells);
+    }
+    return Median(samples);
+}
+
+/**
+ * Time repeated neighbor probes over a grid in a scattered order
+ * @param grid grid to probe
+ * @param order linear indices of the cells to visit
+ * @param repetitions number of timed runs
+ * @param checksum running checksum, updated upon return
+ * @return median nanoseconds per cell
+ */
+template <typename AnyGrid>
+double TimeProbe(const AnyGrid& grid, const vector<uint32_t>& order, unsigned repetitions, size_t& checksum) {
+    vector<double> samples;
+
+    checksum += ProbeNeighbors(grid, order);    // warm up
+    for (unsigned i = 0; i < repetitions; i++) {
+        auto begin = std::chrono::steady_clock::now();
+        checksum += ProbeNeighbors(grid, order);
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - begin).count() / order.size());
+    }
+    return Median(samples);
+}
+
+/**
+ * Time configuring (allocating and clearing) then filling a grid, and releasing it
+ * @param source contents to fill with
+ * @param repetitions number of timed runs
+ * @return median milliseconds per run
+ */
+template <typename AnyGrid>
+double TimeBuild(const Grid& source, unsigned repetitions) {
+    vector<double> samples;
+
+    for (unsigned i = 0; i < repetitions; i++) {
+        auto begin = std::chrono::steady_clock::now();
+        {
+            AnyGrid grid;
+            CopyCells(source, grid);
+        }
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::milli>(end - begin).count());
+    }
+    return Median(samples);
+}
+
+/**
+ * Print one comparison line of the layout benchmark
+ * @param name what was measured
+ * @param unit unit of the measurements
+ * @param before measurement with the row pointer layout
+ * @param after measurement with the contiguous layout
+ */
+void ReportLayout(const string& name, const char* unit, double before, double after) {
+    cout << std::left << setw(32) << name << std::right << std::fixed << std::setprecision(3)
+         << setw(12) << before << setw(12) << after << setw(9) << std::setprecision(2) << before / after << "x  " << unit << endl;
+}
+
+/**
+ * Compare the old row pointer grid layout against the contiguous Grid layout,
+ * on every maze in ../solvable/ and on a synthetic 4096x4096 grid
+ */
+void BenchGridLayout() {
+    const string directoryName = "../solvable/";
+    size_t checksum = 0;
+    DIR* dirp;
+    struct dirent * dp;
+
+    cout << std::left << setw(32) << "benchmark" << std::right << setw(12) << "row-ptr" << setw(12) << "contiguous"
+         << setw(10) << "speedup" << endl;
+
+    // Neighbor sweeps over the corpus; each maze is small, so repeat a lot
+    dirp = opendir(directoryName.c_str());
+    if (dirp == nullptr) {
+        cerr << "Can't open '" << directoryName << "'" << endl;
+    }
+    while (dirp != nullptr && (dp = readdir(dirp)) != NULL) {
+        if (strlen(dp->d_name) >= 5 && strcmp(&dp->d_name[strlen(dp->d_name)-5], ".maze") == 0) {
+            string fileName = directoryName + dp->d_name;
+            ifstream ifs(fileName);
+            Grid contiguous;
+            RowPointerGrid rowPointer;
+
+            if (!contiguous.LoadFromFile(ifs)) {
+                cerr << "Load from '" << fileName << "' failed " << endl;
+                continue;
+            }
+            CopyCells(contiguous, rowPointer);
+            ReportLayout("sweep " + string(dp->d_name), "ns/cell",
+                         TimeSweep(rowPointer, 2001, checksum), TimeSweep(contiguous, 2001, checksum));
+        }
+    }
+    if (dirp != nullptr) {
+        closedir(dirp);
+    }
+
+    // A large random grid, where the layout actually matters for the cache
+    Grid synthetic;
+    RowPointerGrid syntheticRowPointer;
+    std::mt19937 rng(4096);
+
+    synthetic.Configure(4096, 4096);
+    for (size_t row = 0; row < synthetic.NumberRows(); row++) {
+        for (size_t col = 0; col < synthetic.NumberCols(); col++) {
+            synthetic[GridLocation(row, col)] = rng() % 100 < 60;
+        }
+    }
+    CopyCells(synthetic, syntheticRowPointer);
+    ReportLayout("build 4096x4096", "ms", TimeBuild<RowPointerGrid>(synthetic, 5), TimeBuild<Grid>(synthetic, 5));
+    ReportLayout("sweep 4096x4096", "ns/cell",
+                 TimeSweep(syntheticRowPointer, 5, checksum), TimeSweep(synthetic, 5, checksum));
+
+    vector<uint32_t> order(synthetic.NumberRows() * synthetic.NumberCols());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = (uint32_t) i;
+    }
+    std::shuffle(order.begin(), order.end(), rng);
+    ReportLayout("scattered probe 4096x4096", "ns/cell",
+                 TimeProbe(syntheticRowPointer, order, 3, checksum), TimeProbe(synthetic, order, 3, checksum));
+
+    cout << "(checksum " << checksum << ")" << endl;
+}
+
+/**
+ * Time one solver corner to corner on a grid
+ * @param maze the maze to solve
+ * @param solver the solver to time
+ * @param repetitions number of timed runs
+ * @param length receives the number of cells on the path, 0 if there is none
+ * @return median milliseconds per solve
+ */
+double TimeSolve(const Grid& maze, Solver& solver, unsigned repetitions, size_t& length) {
+    vector<double> samples;
+
+    for (unsigned i = 0; i < repetitions; i++) {
+        stack<GridLocation> solution;
+        auto start = std::chrono::steady_clock::now();
+        bool found = SolveMaze(maze, solution, solver);
+        auto stop = std::chrono::steady_clock::now();
+
+        length = found ? solution.size() : 0;
+        samples.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+    }
+    return Median(samples);
+}
+
+/**
+ * Compare the serial breadth first search against the parallel one at
+ * increasing thread counts, on an open 8192x8192 floor with scattered walls
+ */
+void BenchParallel() {
+    Grid floor;
+    std::mt19937 rng(8192);
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    size_t serialLength;
+    size_t length;
+
+    floor.Configure(8192, 8192);
+    for (size_t row = 0; row < floor.NumberRows(); row++) {
+        for (size_t col = 0; col < floor.NumberCols(); col++) {
+            floor[GridLocation(row, col)] = rng() % 100 < 70;
+        }
+    }
+    // Clear the corners so a wall can't cut either end off
+    for (size_t row = 0; row < 2; row++) {
+        for (size_t col = 0; col < 2; col++) {
+            floor[GridLocation(row, col)] = true;
+            floor[GridLocation(floor.NumberRows() - 1 - row, floor.NumberCols() - 1 - col)] = true;
+        }
+    }
+
+    BfsSolver serial;
+    double serialTime = TimeSolve(floor, serial, 3, serialLength);
+
+    cout << std::left << setw(32) << "solver 8192x8192" << std::right << setw(12) << "ms" << setw(10) << "speedup" << endl;
+    cout << std::left << setw(32) << "bfs" << std::right << std::fixed << std::setprecision(3) << setw(12) << serialTime
+         << setw(9) << std::setprecision(2) << 1.0 << "x" << endl;
+    for (unsigned nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+        ParallelBfsSolver parallel(nThreads, 0);
+        double time = TimeSolve(floor, parallel, 3, length);
+
+        cout << std::left << setw(32) << "pbfs " + std::to_string(nThreads) + " threads" << std::right << std::fixed
+             << std::setprecision(3) << setw(12) << time << setw(9) << std::setprecision(2) << serialTime / time << "x"
+             << (length == serialLength ? "" : "  PATH LENGTH MISMATCH") << endl;
+        if (nThreads < maxThreads && nThreads * 2 > maxThreads) {
+            nThreads = maxThreads / 2;
+        }
+    }
+}
+
+/**
+ * The batched GenerateValidMoves as it was before it took row words: four
+ * reads per cell.  Kept here only so the two can be compared.
+ * @param maze the maze
+ * @param cells grid locations to move from
+ * @param count number of cells
+ * @param masks receives one mask per cell
+ */
+void CellByCellMasks(const Grid& maze, const GridLocation cells[], size_t count, unsigned char masks[]) {
+    size_t lastRow = maze.NumberRows() - 1;
+    size_t lastCol = maze.NumberCols() - 1;
+
+    for (size_t i = 0; i < count; i++) {
+        size_t row = cells[i].Row();
+        size_t col = cells[i].Col();
+        unsigned mask = 0;
+
+        mask |= (row > 0 && maze[GridLocation(row - 1, col)]) << (int) Direction::North;
+        mask |= (col < lastCol && maze[GridLocation(row, col + 1)]) << (int) Direction::East;
+        mask |= (row < lastRow && maze[GridLocation(row + 1, col)]) << (int) Direction::South;
+        mask |= (col > 0 && maze[GridLocation(row, col - 1)]) << (int) Direction::West;
+        masks[i] = (unsigned char) mask;
+    }
+}
+
+/**
+ * Gather 64 bytes into a mask, as Grid::RowWord does for byte per cell storage
+ * @param bytes the bytes, which need not be aligned
+ * @return mask with bit i set if byte i is nonzero
+ */
+uint64_t ByteWord(const unsigned char* bytes) {
+    uint64_t mask = 0;
+#ifdef __SSE2__
+    const __m128i zero = _mm_setzero_si128();
+    for (unsigned i = 0; i < 4; i++) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*) (bytes + 16 * i));
+        uint64_t walls = (uint64_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zero));
+        mask |= (~walls & 0xFFFF) << (16 * i);
+    }
+#else
+    for (unsigned i = 0; i < 64; i++) {
+        mask |= uint64_t(bytes[i] != 0) << i;
+    }
+#endif
+    return mask;
+}
+
+/**
+ * BorderedGrid::MoveMasks done the way the bit per cell GenerateValidMoves
+ * does it: a run of handles in one block of 64 shares the masks of the four
+ * blocks one step away.  Kept here only so the two can be compared.
+ * @param bytes the bordered grid's bytes, with a block's worth of room either side
+ * @param stride handles per row of the bordered grid
+ * @param cells handles of grid cells
+ * @param count number of cells
+ * @param masks receives one mask per cell
+ */
+void RowShiftedMasks(const unsigned char* bytes, size_t stride, const CellHandle cells[], size_t count, unsigned char masks[]) {
+    size_t block = SIZE_MAX;
+    uint64_t neighbors[4] = { 0, 0, 0, 0 };
+
+    for (size_t i = 0; i < count; i++) {
+        size_t index = cells[i].Index();
+
+        if (index / 64 != block) {
+            if (i + 1 == count || cells[i + 1].Index() / 64 != index / 64) {
+                const unsigned char* cell = bytes + index;
+
+                masks[i] = (unsigned char) ((cell[-(ptrdiff_t) stride] << (int) Direction::North)
+                                            | (cell[1] << (int) Direction::East)
+                                            | (cell[stride] << (int) Direction::South)
+                                            | (cell[-1] << (int) Direction::West));
+                continue;
+            }
+            block = index / 64;
+            neighbors[(int) Direction::North] = ByteWord(bytes + block * 64 - stride);
+            neighbors[(int) Direction::East] = ByteWord(bytes + block * 64 + 1);
+            neighbors[(int) Direction::South] = ByteWord(bytes + block * 64 + stride);
+            neighbors[(int) Direction::West] = ByteWord(bytes + block * 64 - 1);
+        }
+
+        unsigned mask = 0;
+        for (unsigned dir = 0; dir < 4; dir++) {
+            mask |= (unsigned) ((neighbors[dir] >> (index % 64)) & 1) << dir;
+        }
+        masks[i] = (unsigned char) mask;
+    }
+}
+
+/**
+ * Time filling in the move masks of a list of cells, a batch at a time
+ * @param count number of cells
+ * @param repetitions number of timed runs
+ * @param checksum running checksum, updated upon return
+ * @param batch batch(first, size, masks) fills in masks for cells first .. first + size - 1
+ * @return median nanoseconds per cell
+ */
+template <typename Batch>
+double TimeMasks(size_t count, unsigned repetitions, size_t& checksum, Batch batch) {
+    vector<unsigned char> masks(count);
+    vector<double> samples;
+
+    for (unsigned i = 0; i <= repetitions; i++) {
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t first = 0; first < count; first += BorderedGrid::BATCH) {
+            batch(first, std::min(BorderedGrid::BATCH, count - first), &masks[first]);
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        // The first run warms up
+        if (i > 0) {
+            samples.push_back(std::chrono::duration<double, std::nano>(end - begin).count() / count);
+        }
+        for (unsigned char mask : masks) {
+            checksum += mask;
+        }
+    }
+    return Median(samples);
+}
+
+/**
+ * Compare batched move masks read a cell at a time against masks picked out
+ * of row-shifted words, in both grid storage modes and for a bordered copy,
+ * on a 2048x2048 floor with scattered walls.  The cells come in row order,
+ * where runs share row words, and in the order a breadth first search
+ * reaches them, where they seldom do.
+ */
+void BenchMoveMasks() {
+    const size_t size = 2048;
+    size_t checksum = 0;
+
+    for (GridStorage storage : { GridStorage::Bytes, GridStorage::Bits }) {
+        const char* name = (storage == GridStorage::Bits) ? "bits" : "bytes";
+        Grid floor(storage);
+        std::mt19937 rng(size);
+
+        floor.Configure(size, size);
+        for (size_t row = 0; row < size; row++) {
+            for (size_t col = 0; col < size; col++) {
+                floor[GridLocation(row, col)] = rng() % 100 < 85;
+            }
+        }
+
+        CellLayout layout(size, size);
+        vector<unsigned char> bytes(layout.NumberHandles() + 2 * 64);
+        BorderedGrid bordered(floor, bytes.data() + 64);
+        vector<GridLocation> rowOrder;
+        vector<GridLocation> searchOrder;
+        vector<bool> reached(size * size);
+
+        for (size_t row = 0; row < size; row++) {
+            for (size_t col = 0; col < size; col++) {
+                if (floor[GridLocation(row, col)]) {
+                    rowOrder.push_back(GridLocation(row, col));
+                }
+            }
+        }
+        searchOrder.push_back(rowOrder[0]);
+        reached[rowOrder[0].Row() * size + rowOrder[0].Col()] = true;
+        for (size_t head = 0; head < searchOrder.size(); head++) {
+            GridLocation moves[4];
+            size_t count;
+
+            GenerateValidMoves(floor, searchOrder[head], moves, count);
+            for (size_t i = 0; i < count; i++) {
+                if (!reached[moves[i].Row() * size + moves[i].Col()]) {
+                    reached[moves[i].Row() * size + moves[i].Col()] = true;
+                    searchOrder.push_back(moves[i]);
+                }
+            }
+        }
+
+        cout << std::left << setw(32) << string("moves ") + name << std::right << setw(12) << "per cell"
+             << setw(12) << "row words" << setw(10) << "speedup" << endl;
+        for (const vector<GridLocation>* order : { &rowOrder, &searchOrder }) {
+            const vector<GridLocation>& cells = *order;
+            const char* orderName = (order == &rowOrder) ? " row order" : " search order";
+            vector<CellHandle> handles;
+            double perCell;
+            double rowWords;
+
+            for (const GridLocation& cell : cells) {
+                handles.push_back(layout.ToHandle(cell));
+            }
+            perCell = TimeMasks(cells.size(), 5, checksum, [&](size_t first, size_t count, unsigned char* masks) {
+                CellByCellMasks(floor, &cells[first], count, masks);
+            });
+            rowWords = TimeMasks(cells.size(), 5, checksum, [&](size_t first, size_t count, unsigned char* masks) {
+                GenerateValidMoves(floor, &cells[first], count, masks);
+            });
+            cout << std::left << setw(32) << string("GenerateValidMoves") + orderName << std::right << std::fixed
+                 << std::setprecision(3) << setw(12) << perCell << setw(12) << rowWords << setw(9)
+                 << std::setprecision(2) << perCell / rowWords << "x  ns/cell" << endl;
+
+            perCell = TimeMasks(cells.size(), 5, checksum, [&](size_t first, size_t count, unsigned char* masks) {
+                bordered.MoveMasks(&handles[first], count, masks);
+            });
+            rowWords = TimeMasks(cells.size(), 5, checksum, [&](size_t first, size_t count, unsigned char* masks) {
+                RowShiftedMasks(bytes.data() + 64, layout.Stride(), &handles[first], count, masks);
+            });
+            cout << std::left << setw(32) << string("MoveMasks") + orderName << std::right << std::fixed
+                 << std::setprecision(3) << setw(12) << perCell << setw(12) << rowWords << setw(9)
+                 << std::setprecision(2) << perCell / rowWords << "x  ns/cell" << endl;
+        }
+    }
+    cout << "(checksum " << checksum << ")" << endl;
+}
+
+/**
+ * Lay out a square floor plan: rooms of random sizes separated by one cell
+ * walls, a door of two to four cells in each wall of each room, and blocks of
+ * furniture scattered across the floor
+ * @param plan receives the floor plan, in bit per cell storage
+ * @param size number of rows and columns
+ * @param seed random seed
+ */
+void GenerateFloorPlan(Grid& plan, size_t size, unsigned seed) {
+    std::mt19937 rng(seed);
+    vector<size_t> walls[2];
+
+    plan = Grid(GridStorage::Bits);
+    plan.Configure(size, size);
+    for (size_t row = 0; row < size; row++) {
+        for (size_t col = 0; col < size; col++) {
+            plan[GridLocation(row, col)] = true;
+        }
+    }
+
+    // Wall lines across the whole plan, the rows in walls[0] and the columns in walls[1]
+    for (unsigned axis = 0; axis < 2; axis++) {
+        walls[axis].push_back(0);
+        for (size_t at = 24 + rng() % 48; at + 24 < size; at += 24 + rng() % 48) {
+            walls[axis].push_back(at);
+        }
+        walls[axis].push_back(size);
+    }
+    for (size_t i = 1; i + 1 < walls[0].size(); i++) {
+        for (size_t col = 0; col < size; col++) {
+            plan[GridLocation(walls[0][i], col)] = false;
+        }
+    }
+    for (size_t i = 1; i + 1 < walls[1].size(); i++) {
+        for (size_t row = 0; row < size; row++) {
+            plan[GridLocation(row, walls[1][i])] = false;
+        }
+    }
+
+    // A door in each wall segment, and furniture in each room
+    for (size_t i = 0; i + 1 < walls[0].size(); i++) {
+        for (size_t j = 0; j + 1 < walls[1].size(); j++) {
+            size_t top = walls[0][i] + 1;
+            size_t left = walls[1][j] + 1;
+            size_t height = walls[0][i + 1] - top;
+            size_t width = walls[1][j + 1] - left;
+            size_t door = 2 + rng() % 3;
+
+            if (i > 0) {
+                size_t at = left + rng() % (width - door);
+                for (size_t col = at; col < at + door; col++) {
+                    plan[GridLocation(top - 1, col)] = true;
+                }
+            }
+            if (j > 0) {
+                size_t at = top + rng() % (height - door);
+                for (size_t row = at; row < at + door; row++) {
+                    plan[GridLocation(row, left - 1)] = true;
+                }
+            }
+            for (unsigned piece = rng() % 6; piece > 0; piece--) {
+                size_t pieceHeight = 1 + rng() % 6;
+                size_t pieceWidth = 1 + rng() % 6;
+                size_t row = top + 2 + rng() % (height - pieceHeight - 3);
+                size_t col = left + 2 + rng() % (width - pieceWidth - 3);
+
+                for (size_t r = row; r < row + pieceHeight; r++) {
+                    for (size_t c = col; c < col + pieceWidth; c++) {
+                        plan[GridLocation(r, c)] = false;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Return the value below which a given fraction of a set of timings fall
+ * @param samples timings, sorted on return
+ * @param fraction fraction between 0 and 1
+ * @return percentile value
+ */
+double Percentile(vector<double>& samples, double fraction) {
+    std::sort(samples.begin(), samples.end());
+    return samples[std::min(samples.size() - 1, (size_t) (fraction * samples.size()))];
+}
+
+/**
+ * Measure hierarchical path finding on a large floor plan at several cluster
+ * sizes: the time to build the abstract graph, its size and memory, and the
+ * latency of queries between random open cells, against breadth first search
+ * @param size number of rows and columns of the floor plan
+ */
+void BenchHierarchy(size_t size) {
+    const unsigned nQueries = 1000;
+    const unsigned nReference = 5;
+    unsigned nThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::mt19937 rng(size);
+    Grid plan;
+    vector<RouteQuery> queries;
+
+    GenerateFloorPlan(plan, size, 1234);
+    while (queries.size() < nQueries) {
+        RouteQuery query;
+
+        query.start = GridLocation(rng() % size, rng() % size);
+        query.goal = GridLocation(rng() % size, rng() % size);
+        if (plan[query.start] && plan[query.goal]) {
+            queries.push_back(query);
+        }
+    }
+
+    // Breadth first search over the whole plan, on a few of the queries
+    BfsSolver bfs;
+    vector<double> bfsTimes;
+    vector<size_t> bfsLengths;
+    for (unsigned i = 0; i < nReference; i++) {
+        stack<GridLocation> solution;
+        auto begin = std::chrono::steady_clock::now();
+        bool found = bfs.Solve(plan, queries[i].start, queries[i].goal, solution, nullptr);
+        auto end = std::chrono::steady_clock::now();
+
+        bfsTimes.push_back(std::chrono::duration<double, std::milli>(end - begin).count());
+        bfsLengths.push_back(found ? solution.size() : 0);
+    }
+
+    cout << "floor plan " << size << "x" << size << ", grid " << std::fixed << std::setprecision(1)
+         << (double) size * ((size + 63) / 64 * 8) / (1 << 20) << " MB, " << nThreads << " build threads" << endl;
+    cout << "bfs: median " << std::setprecision(3) << Median(bfsTimes) << " ms per query over " << nReference << " queries" << endl;
+    cout << std::left << setw(10) << "cluster" << std::right << setw(12) << "build ms" << setw(10) << "nodes" << setw(11) << "edges"
+         << setw(10) << "MB" << setw(12) << "median ms" << setw(10) << "p95 ms" << setw(12) << "vs bfs" << setw(12) << "length" << endl;
+    for (size_t clusterSize = 16; clusterSize <= 64; clusterSize *= 2) {
+        auto begin = std::chrono::steady_clock::now();
+        HierarchicalGraph graph(plan, clusterSize, nThreads);
+        auto end = std::chrono::steady_clock::now();
+        double buildTime = std::chrono::duration<double, std::milli>(end - begin).count();
+        vector<double> times;
+        vector<GridLocation> route;
+        size_t hpaLength = 0;
+        size_t bfsLength = 0;
+
+        for (unsigned i = 0; i < nQueries; i++) {
+            auto queryBegin = std::chrono::steady_clock::now();
+            bool found = graph.Solve(queries[i].start, queries[i].goal, route);
+            auto queryEnd = std::chrono::steady_clock::now();
+
+            times.push_back(std::chrono::duration<double, std::milli>(queryEnd - queryBegin).count());
+            if (i < nReference && found == (bfsLengths[i] > 0)) {
+                hpaLength += route.size();
+                bfsLength += bfsLengths[i];
+            }
+        }
+        double median = Median(times);
+        double p95 = Percentile(times, 0.95);
+
+        cout << std::left << setw(10) << std::to_string(clusterSize) + "x" + std::to_string(clusterSize) << std::right
+             << std::fixed << std::setprecision(1) << setw(12) << buildTime << setw(10) << graph.NumberNodes()
+             << setw(11) << graph.NumberEdges() << setw(10) << (double) graph.MemoryBytes() / (1 << 20)
+             << std::setprecision(3) << setw(12) << median << setw(10) << p95
+             << std::setprecision(0) << setw(11) << Median(bfsTimes) / median << "x"
+             << std::setprecision(3) << setw(11) << (bfsLength ? (double) hpaLength / bfsLength : 0.0) << "x" << endl;
+    }
+}
+
+/**
+ * Compare repairing a route with DynamicSolver against solving from scratch,
+ * corner to corner on a floor plan, after batches of 1, 10 and 1000 random
+ * cells toggled between open and wall
+ * @param size number of rows and columns of the floor plan
+ */
+void BenchDynamic(size_t size) {
+    std::mt19937 rng((unsigned) size);
+    Grid plan;
+
+    GenerateFloorPlan(plan, size, 5678);
+    GridLocation start(0, 0);
+    GridLocation goal(size - 1, size - 1);
+
+    auto begin = std::chrono::steady_clock::now();
+    DynamicSolver dynamic(plan, start, goal);
+    vector<GridLocation> route;
+    SolveStats stats = SolveStats();
+    dynamic.Solve(route, &stats);
+    auto end = std::chrono::steady_clock::now();
+
+    cout << "floor plan " << size << "x" << size << ", first solve " << std::fixed << std::setprecision(3)
+         << std::chrono::duration<double, std::milli>(end - begin).count() << " ms, " << stats.cellsExpanded
+         << " cells expanded" << endl;
+    cout << std::left << setw(10) << "toggles" << std::right << setw(12) << "lpa* ms" << setw(12) << "cells"
+         << setw(12) << "astar ms" << setw(12) << "bfs ms" << setw(12) << "vs astar" << setw(10) << "vs bfs" << endl;
+
+    // The last batch walls off one cell of the current route each round, and opens
+    // the one walled off the round before, so the search always has repairs to make
+    const unsigned batches[] = { 1, 10, 1000, 1 };
+    GridLocation blocked = start;
+    for (size_t b = 0; b < 4; b++) {
+        unsigned batch = batches[b];
+        const unsigned rounds = 15;
+        vector<double> dynamicTimes;
+        vector<double> astarTimes;
+        vector<double> bfsTimes;
+        vector<double> expanded;
+        bool agree = true;
+
+        for (unsigned round = 0; round < rounds; round++) {
+            for (unsigned i = 0; i < batch && b < 3; i++) {
+                GridLocation loc(rng() % size, rng() % size);
+
+                plan[loc] = !plan[loc];
+                dynamic.SetCell(loc, plan[loc]);
+            }
+            if (b == 3 && route.size() > 2) {
+                plan[blocked] = true;
+                dynamic.SetCell(blocked, true);
+                blocked = route[1 + rng() % (route.size() - 2)];
+                plan[blocked] = false;
+                dynamic.SetCell(blocked, false);
+            }
+
+            begin = std::chrono::steady_clock::now();
+            bool found = dynamic.Solve(route, &stats);
+            end = std::chrono::steady_clock::now();
+            dynamicTimes.push_back(std::chrono::duration<double, std::milli>(end - begin).count());
+            expanded.push_back((double) stats.cellsExpanded);
+
+            AStarSolver astar;
+            stack<GridLocation> solution;
+            begin = std::chrono::steady_clock::now();
+            astar.Solve(plan, start, goal, solution, nullptr);
+            end = std::chrono::steady_clock::now();
+            astarTimes.push_back(std::chrono::duration<double, std::milli>(end - begin).count());
+
+            BfsSolver bfs;
+            begin = std::chrono::steady_clock::now();
+            bool bfsFound = bfs.Solve(plan, start, goal, solution, nullptr);
+            end = std::chrono::steady_clock::now();
+            bfsTimes.push_back(std::chrono::duration<double, std::milli>(end - begin).count());
+            agree = agree && found == bfsFound && (!found || route.size() == solution.size());
+        }
+
+        double dynamicTime = Median(dynamicTimes);
+        cout << std::left << setw(10) << (b < 3 ? std::to_string(batch) : "1 on route") << std::right << std::fixed << std::setprecision(3) << setw(12) << dynamicTime
+             << setw(12) << std::setprecision(0) << Median(expanded) << std::setprecision(3) << setw(12) << Median(astarTimes)
+             << setw(12) << Median(bfsTimes) << std::setprecision(1) << setw(11) << Median(astarTimes) / dynamicTime << "x"
+             << setw(9) << Median(bfsTimes) / dynamicTime << "x" << (agree ? "" : "  PATH LENGTH MISMATCH") << endl;
+    }
+}
+
+/**
+ * Carve a perfect maze, one with exactly one route between any two open cells,
+ * by a depth first walk over the cells in even rows and columns that knocks out
+ * the wall between each cell and the next
+ * @param maze receives the maze, in bit per cell storage
+ * @param size number of rows and columns
+ * @param seed random seed
+ */
+void GeneratePerfect(Grid& maze, size_t size, unsigned seed) {
+    const int rowSteps[] = { -1, 0, 1, 0 };
+    const int colSteps[] = { 0, 1, 0, -1 };
+    std::mt19937 rng(seed);
+    size_t cellsAcross = (size + 1) / 2;
+    vector<uint32_t> path;
+
+    maze = Grid(GridStorage::Bits);
+    maze.Configure(size, size);
+    maze[GridLocation(0, 0)] = true;
+    path.push_back(0);
+    while (!path.empty()) {
+        size_t row = path.back() / cellsAcross;
+        size_t col = path.back() % cellsAcross;
+        unsigned choices[4];
+        unsigned count = 0;
+
+        for (unsigned i = 0; i < 4; i++) {
+            size_t nextRow = row + rowSteps[i];
+            size_t nextCol = col + colSteps[i];
+
+            if (nextRow < cellsAcross && nextCol < cellsAcross && !maze[GridLocation(2 * nextRow, 2 * nextCol)]) {
+                choices[count++] = i;
+            }
+        }
+        if (count == 0) {
+            path.pop_back();
+            continue;
+        }
+        unsigned i = choices[rng() % count];
+        maze[GridLocation(2 * row + rowSteps[i], 2 * col + colSteps[i])] = true;
+        maze[GridLocation(2 * (row + rowSteps[i]), 2 * (col + colSteps[i]))] = true;
+        path.push_back((uint32_t) ((row + rowSteps[i]) * cellsAcross + col + colSteps[i]));
+    }
+    // With an even size the walk stops a row and a column short of the far corner
+    if (size % 2 == 0) {
+        maze[GridLocation(size - 2, size - 1)] = true;
+        maze[GridLocation(size - 1, size - 1)] = true;
+    }
+}
+
+/**
+ * Lay out a double spiral: square rings of corridor, one cell apart, each cut
+ * in two at opposite corners, with the halves joined to the halves of the next
+ * ring in, alternately at one end and the other.  The route winds in from one
+ * corner of the maze to the middle and back out to the other, along about half
+ * of the open cells.
+ * @param maze receives the maze, in bit per cell storage
+ * @param size number of rows and columns
+ */
+void GenerateSpiral(Grid& maze, size_t size) {
+    size_t deepest = (size - 1) / 2;
+    size_t innermost = deepest - deepest % 2;
+
+    maze = Grid(GridStorage::Bits);
+    maze.Configure(size, size);
+    for (size_t row = 0; row < size; row++) {
+        for (size_t col = 0; col < size; col++) {
+            size_t depth = std::min(std::min(row, col), std::min(size - 1 - row, size - 1 - col));
+
+            maze[GridLocation(row, col)] = depth % 2 == 0;
+        }
+    }
+    for (size_t depth = 0; depth < innermost; depth += 2) {
+        maze[GridLocation(depth, size - 1 - depth)] = false;
+        maze[GridLocation(size - 1 - depth, depth)] = false;
+
+        // The door through the wall ring inside, and its mirror image for the other half
+        size_t at = std::max(depth + 2, size - 4 - depth);
+        GridLocation door = (depth % 4 == 0) ? GridLocation(depth + 1, at) : GridLocation(at, depth + 1);
+        maze[door] = true;
+        maze[GridLocation(size - 1 - door.Row(), size - 1 - door.Col())] = true;
+    }
+}
+
+/**
+ * Scatter walls over an open grid at random
+ * @param maze receives the grid, in bit per cell storage
+ * @param size number of rows and columns
+ * @param percentOpen chance of each cell being open
+ * @param seed random seed
+ */
+void GenerateNoise(Grid& maze, size_t size, unsigned percentOpen, unsigned seed) {
+    std::mt19937 rng(seed);
+
+    maze = Grid(GridStorage::Bits);
+    maze.Configure(size, size);
+    for (size_t row = 0; row < size; row++) {
+        for (size_t col = 0; col < size; col++) {
+            maze[GridLocation(row, col)] = rng() % 100 < percentOpen;
+        }
+    }
+    // Clear the corners so a wall can't cut either end off
+    for (size_t row = 0; row < std::min<size_t>(size, 2); row++) {
+        for (size_t col = 0; col < std::min<size_t>(size, 2); col++) {
+            maze[GridLocation(row, col)] = true;
+            maze[GridLocation(size - 1 - row, size - 1 - col)] = true;
+        }
+    }
+}
+
+/**
+ * One line of suite output: the timings of one operation on one maze
+ */
+struct SuiteResult {
+    string maze;
+    size_t rows;
+    size_t cols;
+    string operation;
+    bool ok;
+    size_t length;
+    unsigned repetitions;
+    double medianMs;
+    double p95Ms;
+    double cellsPerSecond;
+    long peakRssKb;
+};
+
+/**
+ * Return the most memory the process has had resident so far
+ * @return kilobytes
+ */
+long PeakResidentKb() {
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return usage.ru_maxrss;
+}
+
+/**
+ * Run an operation a few times untimed, then time it
+ * @param warmup number of untimed runs
+ * @param repetitions number of timed runs
+ * @param operation what to time
+ * @param result receives the repetitions, median and 95th percentile, rate
+ *        over the maze's cells and peak memory
+ */
+template <typename Operation>
+void TimeOperation(unsigned warmup, unsigned repetitions, Operation operation, SuiteResult& result) {
+    vector<double> samples;
+
+    for (unsigned i = 0; i < warmup; i++) {
+        operation();
+    }
+    for (unsigned i = 0; i < repetitions; i++) {
+        auto start = std::chrono::steady_clock::now();
+        operation();
+        auto stop = std::chrono::steady_clock::now();
+
+        samples.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+    }
+    result.repetitions = repetitions;
+    result.medianMs = Median(samples);
+    result.p95Ms = Percentile(samples, 0.95);
+    result.cellsPerSecond = (result.medianMs > 0) ? result.rows * result.cols / (result.medianMs / 1000) : 0;
+    result.peakRssKb = PeakResidentKb();
+}
+
+/**
+ * Write one result as a CSV row or a JSON object
+ * @param result the result
+ * @param json true for JSON, false for CSV
+ * @param first true for the first result, updated upon return
+ */
+void EmitResult(const SuiteResult& result, bool json, bool& first) {
+    if (json) {
+        cout << (first ? "[\n" : ",\n") << "  {\"maze\": \"" << result.maze << "\", \"rows\": " << result.rows
+             << ", \"cols\": " << result.cols << ", \"operation\": \"" << result.operation << "\", \"ok\": "
+             << (result.ok ? "true" : "false") << ", \"length\": " << result.length << ", \"repetitions\": "
+             << result.repetitions << std::fixed << std::setprecision(6) << ", \"median_ms\": " << result.medianMs
+             << ", \"p95_ms\": " << result.p95Ms << std::setprecision(0) << ", \"cells_per_sec\": "
+             << result.cellsPerSecond << ", \"peak_rss_kb\": " << result.peakRssKb << "}";
+    }
+    else {
+        if (first) {
+            cout << "maze,rows,cols,operation,ok,length,repetitions,median_ms,p95_ms,cells_per_sec,peak_rss_kb" << '\n';
+        }
+        cout << result.maze << ',' << result.rows << ',' << result.cols << ',' << result.operation << ','
+             << (result.ok ? 1 : 0) << ',' << result.length << ',' << result.repetitions << std::fixed
+             << std::setprecision(6) << ',' << result.medianMs << ',' << result.p95Ms << std::setprecision(0)
+             << ',' << result.cellsPerSecond << ',' << result.peakRssKb << '\n';
+    }
+    cout.flush();
+    first = false;
+}
+
+/**
+ * Time loading a maze from its text with LoadFromFile, solving it corner to
+ * corner with each solver engine, and checking the route with CheckSolution
+ * Small mazes get more timed runs, so each operation takes long enough to measure.
+ * @param label name of the maze in the results
+ * @param text the maze in the format LoadFromFile reads
+ * @param json true for JSON output, false for CSV
+ * @param first true if nothing has been written yet, updated upon return
+ */
+void BenchSuiteMaze(const string& label, const string& text, bool json, bool& first) {
+    std::istringstream is(text);
+    Grid maze;
+    SuiteResult result = SuiteResult();
+
+    // The first load, untimed, finds the size
+    result.maze = label;
+    result.operation = "load";
+    result.ok = maze.LoadFromFile(is);
+    result.rows = maze.NumberRows();
+    result.cols = maze.NumberCols();
+    if (!result.ok) {
+        result.peakRssKb = PeakResidentKb();
+        EmitResult(result, json, first);
+        return;
+    }
+    size_t cells = result.rows * result.cols;
+    unsigned repetitions = (unsigned) std::max<size_t>(3, std::min<size_t>(1000, (1 << 22) / cells));
+    TimeOperation(0, repetitions, [&]() {
+        is.clear();
+        is.seekg(0);
+        result.ok = maze.LoadFromFile(is);
+    }, result);
+    EmitResult(result, json, first);
+
+    stack<GridLocation> route;
+    bool solvable = false;
+    for (const string& name : Solver::Names()) {
+        unique_ptr<Solver> solver = Solver::Create(name);
+        stack<GridLocation> solution;
+        bool found = false;
+
+        result.operation = name;
+        TimeOperation(1, repetitions, [&]() {
+            solution = stack<GridLocation>();
+            found = SolveMaze(maze, solution, *solver);
+        }, result);
+        if (name == "bfs") {
+            solvable = found;
+            route = solution;
+        }
+        // Every engine finds a shortest route, so they all agree with the first
+        result.ok = found == solvable && solution.size() == route.size();
+        result.length = solution.size();
+        if (!result.ok) {
+            cerr << label << ": " << name << " found a route of " << solution.size() << " cells, bfs one of "
+                 << route.size() << endl;
+        }
+        EmitResult(result, json, first);
+    }
+
+    if (solvable) {
+        result.operation = "check";
+        TimeOperation(1, repetitions, [&]() {
+            result.ok = CheckSolution(maze, route);
+        }, result);
+        result.length = route.size();
+        EmitResult(result, json, first);
+    }
+}
+
+/**
+ * Lists the maze files in a directory, in name order
+ * @param directoryName directory to search, ending with '/'
+ * @return pathnames of the files ending in ".maze"
+ */
+vector<string> ListMazeFiles(const string& directoryName) {
+    vector<string> fileNames;
+    DIR* dirp;
+    struct dirent * dp;
+
+    dirp = opendir(directoryName.c_str());
+    if (dirp == nullptr) {
+        cerr << "Can't open '" << directoryName << "'" << endl;
+        return fileNames;
+    }
+    while ((dp = readdir(dirp)) != NULL) {
+        if (strlen(dp->d_name) >= 5 && strcmp(&dp->d_name[strlen(dp->d_name)-5], ".maze") == 0) {
+            fileNames.push_back(directoryName + dp->d_name);
+        }
+    }
+    closedir(dirp);
+    std::sort(fileNames.begin(), fileNames.end());
+    return fileNames;
+}
+
+/**
+ * Benchmark suite: perfect mazes, floor plans of rooms, double spirals and
+ * random noise at every power of two size from 2x2 up, then the mazes in the
+ * solvable and unsolvable directories.  Every maze is loaded, solved by each
+ * engine and its route checked; see BenchSuiteMaze.  The mazes are the same
+ * from run to run.
+ * @param maxSize largest number of rows and columns; 16384 needs several gigabytes
+ * @param json true for JSON output, false for CSV
+ */
+void BenchSuite(size_t maxSize, bool json) {
+    const char* kinds[] = { "perfect", "rooms", "spiral", "noise" };
+    const char* directories[] = { "../solvable/", "../unsolvable/" };
+    bool first = true;
+
+    for (size_t size = 2; size <= maxSize; size = (size * 2 > maxSize && size < maxSize) ? maxSize : size * 2) {
+        for (const char* kind : kinds) {
+            std::ostringstream text;
+            Grid maze;
+
+            if (strcmp(kind, "perfect") == 0) {
+                GeneratePerfect(maze, size, (unsigned) size);
+            }
+            else if (strcmp(kind, "rooms") == 0) {
+                // Too small for walls between rooms, the plan is one empty room
+                if (size >= 16) {
+                    GenerateFloorPlan(maze, size, (unsigned) size);
+                }
+                else {
+                    GenerateNoise(maze, size, 100, (unsigned) size);
+                }
+            }
+            else if (strcmp(kind, "spiral") == 0) {
+                GenerateSpiral(maze, size);
+            }
+            else {
+                GenerateNoise(maze, size, 70, (unsigned) size);
+            }
+            text << size << ' ' << size << '\n' << maze;
+            BenchSuiteMaze(string(kind) + "-" + std::to_string(size), text.str(), json, first);
+        }
+    }
+
+    for (const char* directory : directories) {
+        for (const string& fileName : ListMazeFiles(directory)) {
+            ifstream ifs(fileName);
+            std::ostringstream text;
+
+            text << ifs.rdbuf();
+            BenchSuiteMaze(fileName.substr(3), text.str(), json, first);
+        }
+    }
+    if (json) {
+        cout << (first ? "[]" : "\n]") << endl;
+    }
+}
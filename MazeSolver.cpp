@@ -0,0 +1,197 @@
+//
+// Method implementation for the MazeSolver Class
+// Date: 10/18/2026
+//
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include "MazeSolver.h"
+
+/**
+ * Constructor
+ * Takes over a maze, labels its components, makes its bordered copy and sizes
+ * the search buffers
+ * @param maze the maze to answer queries on
+ */
+MazeSolver::MazeSolver(Grid maze)
+    : _maze(std::move(maze)), _index(_maze), _cells(CellLayout(_maze.NumberRows(), _maze.NumberCols()).NumberHandles()),
+      _grid(_maze, _cells.data()) {
+    size_t nHandles = _cells.size();
+
+    assert(nHandles < UINT32_MAX);
+    _parent.resize(nHandles);
+    _reached.assign(nHandles, 0);
+    _frontier.resize(_maze.NumberRows() * _maze.NumberCols());
+    _wanted.assign(nHandles, 0);
+    _head = 0;
+    _tail = 0;
+    _epoch = 0;
+}
+
+/**
+ * Return the handle of a cell
+ * @param loc grid location, within the maze
+ * @return handle in the bordered copy
+ */
+inline CellHandle MazeSolver::Handle(const GridLocation& loc) const {
+    return _grid.Layout().ToHandle(loc);
+}
+
+/**
+ * Start a new breadth first search, forgetting every cell the last one reached
+ * @param first handle of the start, which becomes its own parent
+ */
+void MazeSolver::BeginSearch(CellHandle first) {
+    if (++_epoch == 0) {
+        // Stamps from 2^32 searches ago would look current again
+        std::fill(_reached.begin(), _reached.end(), 0);
+        std::fill(_wanted.begin(), _wanted.end(), 0);
+        _epoch = 1;
+    }
+    _head = 0;
+    _tail = 0;
+    _reached[first.Index()] = _epoch;
+    _parent[first.Index()] = first;
+    _frontier[_tail++] = first;
+}
+
+/**
+ * Carry on the current search until it has reached the goals still wanted
+ * @param remaining number of goals still wanted
+ * @return number of cells expanded
+ */
+size_t MazeSolver::Search(unsigned remaining) {
+    auto reach = [&](CellHandle next, CellHandle from) {
+        if (_reached[next.Index()] == _epoch) {
+            return false;
+        }
+        _reached[next.Index()] = _epoch;
+        _parent[next.Index()] = from;
+        remaining -= (_wanted[next.Index()] == _epoch);
+        return true;
+    };
+
+    return _grid.BreadthFirst(_frontier.data(), _head, _tail, reach, [&]() { return remaining == 0; });
+}
+
+/**
+ * Follow parent links from a cell the current search reached back to its start
+ * @param last handle of the cell
+ * @param route receives the route, start first
+ */
+void MazeSolver::TraceRoute(CellHandle last, vector<GridLocation>& route) const {
+    const CellLayout& layout = _grid.Layout();
+    CellHandle cell = last;
+
+    route.clear();
+    route.push_back(layout.ToLocation(cell));
+    while (_parent[cell.Index()] != cell) {
+        cell = _parent[cell.Index()];
+        route.push_back(layout.ToLocation(cell));
+    }
+    std::reverse(route.begin(), route.end());
+}
+
+/**
+ * Find a shortest route between two cells
+ * The connectivity index rules out unreachable goals before any search, and a
+ * search reuses the buffers of the last, so a caller that reuses "route" causes
+ * no allocation at all.
+ * @param start where the route begins
+ * @param goal where the route ends
+ * @param route receives the route, start first; left empty if there is none
+ * @param stats if not nullptr, receives the amount of work done
+ * @return true if a route exists, false otherwise
+ */
+bool MazeSolver::Solve(const GridLocation& start, const GridLocation& goal, vector<GridLocation>& route, SolveStats* stats) {
+    size_t expanded = 0;
+    bool found = _index.Connected(start, goal);
+
+    route.clear();
+    if (found) {
+        CellHandle first = Handle(start);
+        CellHandle last = Handle(goal);
+
+        BeginSearch(first);
+        _wanted[last.Index()] = _epoch;
+        expanded = Search((first == last) ? 0 : 1);
+        TraceRoute(last, route);
+    }
+    if (stats) {
+        stats->cellsExpanded = expanded;
+    }
+    return found;
+}
+
+/**
+ * Find a shortest route between two cells, in the form SolveMaze returns
+ * @param start where the route begins
+ * @param goal where the route ends
+ * @param solution receives the route with start at the bottom and goal on top
+ * @param stats if not nullptr, receives the amount of work done
+ * @return true if a route exists, false otherwise
+ */
+bool MazeSolver::Solve(const GridLocation& start, const GridLocation& goal, stack<GridLocation>& solution, SolveStats* stats) {
+    if (!Solve(start, goal, _route, stats)) {
+        return false;
+    }
+    solution = stack<GridLocation>();
+    for (const GridLocation& loc : _route) {
+        solution.push(loc);
+    }
+    return true;
+}
+
+/**
+ * Answer a batch of queries
+ * Queries that share a start are answered from a single search, which runs until
+ * it has reached every goal of the group.  Queries whose cells aren't connected
+ * never join a group.
+ * @param queries routes wanted
+ * @param routes receives one route per query, start first, or an empty route
+ *        where there is none.  Reusing it from batch to batch keeps its storage.
+ * @param stats if not nullptr, receives the amount of work done over the batch
+ * @return number of queries with a route
+ */
+size_t MazeSolver::SolveMany(const vector<RouteQuery>& queries, vector<vector<GridLocation>>& routes, SolveStats* stats) {
+    size_t expanded = 0;
+    size_t nFound = 0;
+
+    routes.resize(queries.size());
+    _order.clear();
+    for (size_t i = 0; i < queries.size(); i++) {
+        routes[i].clear();
+        if (_index.Connected(queries[i].start, queries[i].goal)) {
+            _order.push_back(i);
+        }
+    }
+    std::sort(_order.begin(), _order.end(), [&](size_t a, size_t b) {
+        return Handle(queries[a].start).Index() < Handle(queries[b].start).Index();
+    });
+
+    for (size_t group = 0; group < _order.size(); ) {
+        CellHandle first = Handle(queries[_order[group]].start);
+        size_t end = group;
+        unsigned remaining = 0;
+
+        BeginSearch(first);
+        for (; end < _order.size() && Handle(queries[_order[end]].start) == first; end++) {
+            CellHandle last = Handle(queries[_order[end]].goal);
+
+            if (last != first && _wanted[last.Index()] != _epoch) {
+                _wanted[last.Index()] = _epoch;
+                remaining++;
+            }
+        }
+        expanded += Search(remaining);
+        for (; group < end; group++) {
+            TraceRoute(Handle(queries[_order[group]].goal), routes[_order[group]]);
+            nFound++;
+        }
+    }
+    if (stats) {
+        stats->cellsExpanded = expanded;
+    }
+    return nFound;
+}
@@ -0,0 +1,90 @@
+//
+// Interface Definition for the MazeSolver Class
+// Answers many route queries against one maze, keeping its search buffers from
+// one query to the next
+// Date: 10/18/2026
+//
+
+#ifndef MAZESOLVER_H
+#define MAZESOLVER_H
+
+#include <cstdint>
+#include <stack>
+#include <vector>
+using std::stack;
+using std::vector;
+
+#include "Grid.h"
+#include "BorderedGrid.h"
+#include "ConnectivityIndex.h"
+#include "Solver.h"
+
+// One route wanted from SolveMany
+struct RouteQuery {
+    GridLocation start;
+    GridLocation goal;
+};
+
+class MazeSolver {
+public:
+    explicit MazeSolver(Grid maze);
+
+    MazeSolver(const MazeSolver&) = delete;
+    MazeSolver& operator=(const MazeSolver&) = delete;
+
+    const Grid& Maze() const;
+    const ConnectivityIndex& Index() const;
+
+    bool Solve(const GridLocation& start, const GridLocation& goal, vector<GridLocation>& route, SolveStats* stats = nullptr);
+    bool Solve(const GridLocation& start, const GridLocation& goal, stack<GridLocation>& solution, SolveStats* stats = nullptr);
+    size_t SolveMany(const vector<RouteQuery>& queries, vector<vector<GridLocation>>& routes, SolveStats* stats = nullptr);
+
+private:
+    CellHandle Handle(const GridLocation& loc) const;
+    void BeginSearch(CellHandle first);
+    size_t Search(unsigned remaining);
+    void TraceRoute(CellHandle last, vector<GridLocation>& route) const;
+
+    Grid _maze;
+    ConnectivityIndex _index;
+
+    // Bordered copy of the maze the searches step through, never closed
+    vector<unsigned char> _cells;
+    BorderedGrid _grid;
+
+    // Search state indexed by handle, sized for the whole maze once.  A cell
+    // has been reached in the current search when its _reached entry equals
+    // _epoch, so starting a search only bumps _epoch instead of clearing anything.
+    vector<CellHandle> _parent;
+    vector<uint32_t> _reached;
+    vector<CellHandle> _frontier;
+    size_t _head;
+    size_t _tail;
+    uint32_t _epoch;
+
+    // A cell is a goal the current search still has to reach when its _wanted
+    // entry equals _epoch.  _order holds SolveMany's queries grouped by start.
+    vector<uint32_t> _wanted;
+    vector<size_t> _order;
+
+    // Route handed back through the stack form of Solve
+    vector<GridLocation> _route;
+};
+
+/**
+ * Return the maze the solver answers queries on
+ * @return the maze
+ */
+inline const Grid& MazeSolver::Maze() const {
+    return _maze;
+}
+
+/**
+ * Return the connectivity index of the maze, consulted before every search
+ * @return the index
+ */
+inline const ConnectivityIndex& MazeSolver::Index() const {
+    return _index;
+}
+
+#endif //MAZESOLVER_H
@@ -0,0 +1,199 @@
+//
+// Method implementation for the ParallelBfsSolver Class
+// Date: 10/18/2026
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include "ParallelBfsSolver.h"
+#include "BfsSolver.h"
+#include "BorderedGrid.h"
+
+// Most cells a thread claims from the frontier at once
+static const size_t MAX_CHUNK = 1024;
+
+// Parent entry of a cell no thread has claimed yet, the same value as Solver::NO_PARENT
+static const uint32_t UNCLAIMED = UINT32_MAX;
+
+/**
+ * Constructor
+ * The solver starts a pool of its own on the first large search.  Solvers
+ * that run side by side, such as BatchRunner's workers, should each be given
+ * a share of the hardware threads rather than 0.
+ * @param nThreads number of threads to search with, 0 for one per hardware thread
+ * @param minGridCells grids with fewer cells than this are searched serially
+ * @param minFrontier frontier levels with fewer cells than this are expanded by one thread
+ */
+ParallelBfsSolver::ParallelBfsSolver(unsigned nThreads, size_t minGridCells, size_t minFrontier) {
+    _nThreads = (nThreads == 0) ? std::thread::hardware_concurrency() : nThreads;
+    _minGridCells = minGridCells;
+    _minFrontier = minFrontier;
+}
+
+/**
+ * Return name of the algorithm
+ * @return "pbfs"
+ */
+const char* ParallelBfsSolver::Name() const {
+    return "pbfs";
+}
+
+/**
+* Expand part of a frontier level
+* The open neighbors of BorderedGrid::BATCH frontier cells are found at once,
+* and each is claimed with a compare and swap on its parent entry, so a cell
+* reached by several threads at once lands in exactly one next frontier.
+* @param grid bordered copy of the maze being solved
+* @param parent predecessor handle of every cell, UNCLAIMED until claimed
+* @param frontier cells of the current level
+* @param begin first frontier entry to expand
+* @param end one past the last frontier entry to expand
+* @param next receives the cells claimed, appended
+*/
+static void ExpandCells(const BorderedGrid& grid, std::atomic<uint32_t>* parent, const vector<CellHandle>& frontier,
+                        size_t begin, size_t end, vector<CellHandle>& next) {
+    const int32_t* offsets = grid.Layout().Offsets();
+    unsigned char masks[BorderedGrid::BATCH];
+
+    for (size_t batch = begin; batch < end; batch += BorderedGrid::BATCH) {
+        size_t size = std::min(BorderedGrid::BATCH, end - batch);
+
+        grid.MoveMasks(&frontier[batch], size, masks);
+        for (size_t f = 0; f < size; f++) {
+            CellHandle current = frontier[batch + f];
+
+            for (unsigned mask = masks[f]; mask != 0; mask &= mask - 1) {
+                CellHandle cell = current + offsets[__builtin_ctz(mask)];
+                uint32_t expected = UNCLAIMED;
+
+                // Plain load first: most neighbors were claimed long ago, and a failed
+                // compare and swap would still take the cache line exclusive
+                if (parent[cell.Index()].load(std::memory_order_relaxed) == UNCLAIMED
+                    && parent[cell.Index()].compare_exchange_strong(expected, current.Index(), std::memory_order_relaxed)) {
+                    next.push_back(cell);
+                }
+            }
+        }
+    }
+}
+
+/**
+* Find a shortest route with a breadth first search, one level at a time
+* Threads take chunks of the current level from a shared cursor and collect
+* the cells they claim in buffers of their own; the buffers are then copied
+* side by side into the next level, each thread copying its own.  Cells are
+* handles into a bordered copy of the maze, so expansion needs no bounds
+* checks.  Small grids go to the serial BfsSolver, and small levels are
+* expanded by the calling thread alone, since waking the pool costs more than
+* they do.
+* @param maze the maze that we want to solve
+* @param start where the route begins
+* @param goal where the route ends
+* @param solution out parameter used to return solution if it is found
+* @param stats if not nullptr, receives the amount of work done
+* @return true if solution can be found, false otherwise
+*/
+bool ParallelBfsSolver::Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+                              stack<GridLocation>& solution, SolveStats* stats) {
+    size_t nCells = maze.NumberRows() * maze.NumberCols();
+
+    if (nCells < _minGridCells || _nThreads <= 1) {
+        BfsSolver serial;
+        return serial.Solve(maze, start, goal, solution, stats);
+    }
+
+    size_t expanded = 0;
+    bool found = false;
+
+    if (IsOpen(maze, start) && IsOpen(maze, goal)) {
+        if (!_pool) {
+            _pool.reset(new ThreadPool(_nThreads));
+        }
+
+        unsigned nThreads = _pool->NumberThreads();
+        CellLayout layout(maze.NumberRows(), maze.NumberCols());
+        size_t nHandles = layout.NumberHandles();
+        vector<unsigned char> cells(nHandles);
+        BorderedGrid grid(maze, cells.data());
+        CellHandle first = layout.ToHandle(start);
+        CellHandle last = layout.ToHandle(goal);
+        unique_ptr<std::atomic<uint32_t>[]> parent(new std::atomic<uint32_t>[nHandles]);
+        vector<vector<CellHandle>> local(nThreads);
+        vector<size_t> offset(nThreads + 1);
+        vector<CellHandle> frontier;
+        vector<CellHandle> next;
+        std::atomic<size_t> cursor;
+
+        // Clearing the parent array touches every cell, so share it out too
+        _pool->Run([&](unsigned thread) {
+            size_t begin = nHandles * thread / nThreads;
+            size_t end = nHandles * (thread + 1) / nThreads;
+
+            for (size_t i = begin; i < end; i++) {
+                parent[i].store(NO_PARENT, std::memory_order_relaxed);
+            }
+        });
+
+        // The start is its own parent, which ends reconstruction
+        parent[first.Index()].store(first.Index(), std::memory_order_relaxed);
+        frontier.push_back(first);
+        found = (first == last);
+
+        while (!found && !frontier.empty()) {
+            expanded += frontier.size();
+            if (frontier.size() < _minFrontier) {
+                next.clear();
+                ExpandCells(grid, parent.get(), frontier, 0, frontier.size(), next);
+            }
+            else {
+                size_t chunk = std::max<size_t>(1, std::min(MAX_CHUNK, frontier.size() / (4 * nThreads)));
+
+                cursor.store(0, std::memory_order_relaxed);
+                _pool->Run([&](unsigned thread) {
+                    local[thread].clear();
+                    while (true) {
+                        size_t begin = cursor.fetch_add(chunk, std::memory_order_relaxed);
+                        if (begin >= frontier.size()) {
+                            break;
+                        }
+                        ExpandCells(grid, parent.get(), frontier, begin, std::min(begin + chunk, frontier.size()), local[thread]);
+                    }
+                });
+
+                offset[0] = 0;
+                for (unsigned thread = 0; thread < nThreads; thread++) {
+                    offset[thread + 1] = offset[thread] + local[thread].size();
+                }
+                next.resize(offset[nThreads]);
+                _pool->Run([&](unsigned thread) {
+                    std::copy(local[thread].begin(), local[thread].end(), next.begin() + offset[thread]);
+                });
+            }
+            frontier.swap(next);
+            found = parent[last.Index()].load(std::memory_order_relaxed) != NO_PARENT;
+        }
+
+        if (found) {
+            vector<CellHandle> route;
+            CellHandle cell = last;
+
+            while (true) {
+                route.push_back(cell);
+                CellHandle previous(parent[cell.Index()].load(std::memory_order_relaxed));
+                if (previous == cell) {
+                    break;
+                }
+                cell = previous;
+            }
+            solution = stack<GridLocation>();
+            for (size_t i = route.size(); i > 0; i--) {
+                solution.push(layout.ToLocation(route[i-1]));
+            }
+        }
+    }
+    if (stats) {
+        stats->cellsExpanded = expanded;
+    }
+    return found;
+}
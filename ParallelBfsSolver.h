@@ -0,0 +1,29 @@
+//
+// Interface Definition for the ParallelBfsSolver Class
+// Level synchronous breadth first search that expands each frontier level
+// across a pool of threads
+// Date: 10/18/2026
+//
+
+#ifndef PARALLELBFSSOLVER_H
+#define PARALLELBFSSOLVER_H
+
+#include "Solver.h"
+#include "ThreadPool.h"
+
+class ParallelBfsSolver : public Solver {
+public:
+    explicit ParallelBfsSolver(unsigned nThreads = 0, size_t minGridCells = 1 << 20, size_t minFrontier = 4096);
+
+    const char* Name() const override;
+    bool Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+               stack<GridLocation>& solution, SolveStats* stats) override;
+
+private:
+    unique_ptr<ThreadPool> _pool;
+    unsigned _nThreads;
+    size_t _minGridCells;       // smaller grids are handed to the serial BfsSolver
+    size_t _minFrontier;        // smaller levels are expanded by the calling thread alone
+};
+
+#endif //PARALLELBFSSOLVER_H
@@ -0,0 +1,141 @@
+//
+// Interface Definition and implementation for the RadixHeap Class
+// A priority queue for searches whose keys never drop below the last key popped,
+// as with A* and a consistent heuristic.  Push is O(1) and pop is amortized
+// O(log of the key range), with no comparisons between entries.
+// Date: 10/18/2026
+//
+
+#ifndef RADIXHEAP_H
+#define RADIXHEAP_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+using std::pair;
+using std::vector;
+
+template <typename Value>
+class RadixHeap {
+public:
+    RadixHeap();
+
+    void Clear();
+    bool Empty() const;
+    size_t Size() const;
+
+    void Push(uint32_t key, const Value& value);
+    Value Pop(uint32_t& key);
+
+private:
+    static unsigned Bucket(uint32_t key, uint32_t last);
+
+    // Bucket 0 holds keys equal to _last; bucket b > 0 holds keys whose highest
+    // bit differing from _last is bit b-1
+    vector<pair<uint32_t, Value>> _buckets[33];
+    uint32_t _last;
+    size_t _size;
+};
+
+/**
+ * Default constructor
+ * Creates an empty heap
+ */
+template <typename Value>
+RadixHeap<Value>::RadixHeap() {
+    _last = 0;
+    _size = 0;
+}
+
+/**
+ * Remove every entry, keeping the bucket storage for reuse
+ */
+template <typename Value>
+void RadixHeap<Value>::Clear() {
+    for (auto& bucket : _buckets) {
+        bucket.clear();
+    }
+    _last = 0;
+    _size = 0;
+}
+
+/**
+ * Is the heap empty?
+ * @return true if empty
+ */
+template <typename Value>
+bool RadixHeap<Value>::Empty() const {
+    return _size == 0;
+}
+
+/**
+ * Return number of entries
+ * @return number of entries
+ */
+template <typename Value>
+size_t RadixHeap<Value>::Size() const {
+    return _size;
+}
+
+/**
+ * Choose the bucket for a key
+ * @param key key to place
+ * @param last last key popped
+ * @return bucket number
+ */
+template <typename Value>
+unsigned RadixHeap<Value>::Bucket(uint32_t key, uint32_t last) {
+    return key == last ? 0 : 32 - __builtin_clz(key ^ last);
+}
+
+/**
+ * Add an entry
+ * @param key priority, smallest first; must not be less than the last key popped
+ * @param value value to store
+ */
+template <typename Value>
+void RadixHeap<Value>::Push(uint32_t key, const Value& value) {
+    assert(key >= _last);
+    _buckets[Bucket(key, _last)].push_back(std::make_pair(key, value));
+    _size++;
+}
+
+/**
+ * Remove an entry with the smallest key
+ * @param key receives the key of the entry removed
+ * @return value of the entry removed
+ */
+template <typename Value>
+Value RadixHeap<Value>::Pop(uint32_t& key) {
+    assert(_size > 0);
+    if (_buckets[0].empty()) {
+        unsigned b = 1;
+
+        while (_buckets[b].empty()) {
+            b++;
+        }
+
+        // The new minimum splits its bucket into strictly lower buckets
+        uint32_t smallest = _buckets[b][0].first;
+        for (const auto& entry : _buckets[b]) {
+            if (entry.first < smallest) {
+                smallest = entry.first;
+            }
+        }
+        _last = smallest;
+        for (const auto& entry : _buckets[b]) {
+            _buckets[Bucket(entry.first, _last)].push_back(entry);
+        }
+        _buckets[b].clear();
+    }
+
+    pair<uint32_t, Value> entry = _buckets[0].back();
+    _buckets[0].pop_back();
+    _size--;
+    key = entry.first;
+    return entry.second;
+}
+
+#endif //RADIXHEAP_H
@@ -0,0 +1,153 @@
+//
+// Method implementation for the Solver Class
+// Date: 10/18/2026
+//
+
+#include <cassert>
+#include "Solver.h"
+#include "BfsSolver.h"
+#include "BidirectionalSolver.h"
+#include "AStarSolver.h"
+#include "JumpPointSolver.h"
+#include "ParallelBfsSolver.h"
+#include "DirectionOptimizingSolver.h"
+#include "JunctionSolver.h"
+#include "DeadEndFillingSolver.h"
+
+const uint32_t Solver::NO_PARENT;
+
+/**
+ * Destructor
+ */
+Solver::~Solver() {
+}
+
+/**
+ * Create a solver by name
+ * @param name one of the names returned by Names(), which may be prefixed with
+ *        "fill+" to fill in the maze's dead ends before that solver runs
+ * @param nThreads threads a parallel solver may search with, 0 for one per
+ *        hardware thread; callers that already run solvers side by side should
+ *        share the hardware out rather than leave this 0
+ * @return the solver, or nullptr if the name is unknown
+ */
+unique_ptr<Solver> Solver::Create(const string& name, unsigned nThreads) {
+    const string fill = "fill+";
+
+    if (name.compare(0, fill.size(), fill) == 0) {
+        unique_ptr<Solver> solver = Create(name.substr(fill.size()), nThreads);
+        return solver ? unique_ptr<Solver>(new DeadEndFillingSolver(std::move(solver))) : nullptr;
+    }
+    else if (name == "bfs") {
+        return unique_ptr<Solver>(new BfsSolver());
+    }
+    else if (name == "bibfs") {
+        return unique_ptr<Solver>(new BidirectionalSolver());
+    }
+    else if (name == "astar") {
+        return unique_ptr<Solver>(new AStarSolver());
+    }
+    else if (name == "jps") {
+        return unique_ptr<Solver>(new JumpPointSolver());
+    }
+    else if (name == "pbfs") {
+        return unique_ptr<Solver>(new ParallelBfsSolver(nThreads));
+    }
+    else if (name == "dobfs") {
+        return unique_ptr<Solver>(new DirectionOptimizingSolver());
+    }
+    else if (name == "junction") {
+        return unique_ptr<Solver>(new JunctionSolver());
+    }
+    return nullptr;
+}
+
+/**
+ * Return names of all the solvers Create() knows about
+ * @return solver names
+ */
+vector<string> Solver::Names() {
+    return { "bfs", "bibfs", "astar", "jps", "pbfs", "dobfs", "junction" };
+}
+
+/**
+ * Follow predecessor links from a cell back to the root of its search
+ * The root of a search is its own parent
+ * @param parent predecessor index of every visited cell
+ * @param index linear index (row * cols + col) of the cell to start from
+ * @param cells receives index, its parent, and so on up to the root, appended in that order
+ */
+void Solver::CollectChain(const uint32_t* parent, uint32_t index, vector<uint32_t>& cells) {
+    while (index != NO_PARENT) {
+        cells.push_back(index);
+        index = (parent[index] == index) ? NO_PARENT : parent[index];
+    }
+}
+
+/**
+ * Push the cells of a straight segment onto a path, excluding its first cell
+ * @param maze the maze being solved
+ * @param from linear index of the cell already on top of the path
+ * @param to linear index of the last cell of the segment, in the same row or column
+ * @param path path to extend
+ */
+void Solver::PushSegment(const Grid& maze, uint32_t from, uint32_t to, stack<GridLocation>& path) {
+    size_t nCols = maze.NumberCols();
+    size_t row = from / nCols;
+    size_t col = from % nCols;
+    size_t toRow = to / nCols;
+    size_t toCol = to % nCols;
+
+    assert(row == toRow || col == toCol);
+    while (row != toRow || col != toCol) {
+        if (row != toRow) {
+            row = (row < toRow) ? row + 1 : row - 1;
+        }
+        else {
+            col = (col < toCol) ? col + 1 : col - 1;
+        }
+        path.push(GridLocation(row, col));
+    }
+}
+
+/**
+ * Rebuild the path ending at "index" by following predecessor links back to the start
+ * Consecutive links may be whole straight segments apart, as with jump points
+ * @param maze the maze being solved
+ * @param parent predecessor index of every visited cell
+ * @param index linear index of the last cell on the path
+ * @param path out parameter, receives the path with the start at the bottom
+ */
+void Solver::BuildPath(const Grid& maze, const uint32_t* parent, uint32_t index, stack<GridLocation>& path) {
+    vector<uint32_t> cells;
+    size_t nCols = maze.NumberCols();
+
+    CollectChain(parent, index, cells);
+    path = stack<GridLocation>();
+    path.push(GridLocation(cells.back() / nCols, cells.back() % nCols));
+    for (size_t i = cells.size() - 1; i > 0; i--) {
+        PushSegment(maze, cells[i], cells[i-1], path);
+    }
+}
+
+/**
+ * Rebuild the path ending at a cell by following predecessor handles back to
+ * the start, which is its own parent
+ * @param layout layout of the handles
+ * @param parent predecessor of every cell reached, indexed by handle
+ * @param cell handle of the last cell on the path
+ * @param path out parameter, receives the path with the start at the bottom
+ */
+void Solver::BuildPath(const CellLayout& layout, const CellHandle* parent, CellHandle cell, stack<GridLocation>& path) {
+    vector<CellHandle> cells;
+
+    cells.push_back(cell);
+    while (parent[cell.Index()] != cell) {
+        cell = parent[cell.Index()];
+        cells.push_back(cell);
+    }
+    path = stack<GridLocation>();
+    for (size_t i = cells.size(); i > 0; i--) {
+        path.push(layout.ToLocation(cells[i-1]));
+    }
+}
@@ -0,0 +1,73 @@
+//
+// Interface Definition for the Solver Class
+// Common interface of the maze solving algorithms, so SolveMaze and the
+// command line can pick one by name
+// Date: 10/18/2026
+//
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <cstdint>
+#include <memory>
+#include <stack>
+#include <string>
+#include <vector>
+using std::stack;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+#include "CellHandle.h"
+#include "Grid.h"
+
+// Work done by a solver, reported when the caller asks for it
+struct SolveStats {
+    size_t cellsExpanded;       // number of cells (or jump points) whose moves were generated
+    string levelModes;          // for level by level searches, 'T' (top down) or 'B' (bottom up) per level
+    size_t cellsPruned;         // cells walled off before the search, by dead-end filling
+};
+
+class Solver {
+public:
+    virtual ~Solver();
+
+    virtual const char* Name() const = 0;
+
+    /**
+    * Find a shortest route between two cells
+    * @param maze the maze that we want to solve
+    * @param start where the route begins
+    * @param goal where the route ends
+    * @param solution out parameter, receives the route with start at the bottom and goal on top
+    * @param stats if not nullptr, receives the amount of work done
+    * @return true if a route exists, false otherwise
+    */
+    virtual bool Solve(const Grid& maze, const GridLocation& start, const GridLocation& goal,
+                       stack<GridLocation>& solution, SolveStats* stats) = 0;
+
+    static unique_ptr<Solver> Create(const string& name, unsigned nThreads = 0);
+    static vector<string> Names();
+
+protected:
+    // Marks a cell that has not been reached by the search
+    static const uint32_t NO_PARENT = UINT32_MAX;
+
+    static bool IsOpen(const Grid& maze, const GridLocation& loc);
+    static void CollectChain(const uint32_t* parent, uint32_t index, vector<uint32_t>& cells);
+    static void PushSegment(const Grid& maze, uint32_t from, uint32_t to, stack<GridLocation>& path);
+    static void BuildPath(const Grid& maze, const uint32_t* parent, uint32_t index, stack<GridLocation>& path);
+    static void BuildPath(const CellLayout& layout, const CellHandle* parent, CellHandle cell, stack<GridLocation>& path);
+};
+
+/**
+* Can a route pass through this location?  The same test GenerateValidMoves applies
+* @param maze the maze
+* @param loc grid location, possibly outside the grid
+* @return true if within the grid and not a wall
+*/
+inline bool Solver::IsOpen(const Grid& maze, const GridLocation& loc) {
+    return maze.IsWithinGrid(loc) && maze[loc];
+}
+
+#endif //SOLVER_H
@@ -0,0 +1,106 @@
+//
+// Method implementation for the SolverWorkspace Class
+// Date: 10/18/2026
+//
+
+#include <cstdlib>
+#include <new>
+#include "SolverWorkspace.h"
+
+const size_t SolverWorkspace::ALIGNMENT;
+
+/**
+ * Default constructor
+ * Creates an empty workspace; the first solve sizes it
+ */
+SolverWorkspace::SolverWorkspace() {
+    _block = nullptr;
+    _capacity = 0;
+    _used = 0;
+    _overflow = nullptr;
+    _overflowBytes = 0;
+    _blocksAllocated = 0;
+}
+
+/**
+ * Destructor
+ */
+SolverWorkspace::~SolverWorkspace() {
+    Reset();
+    free(_block);
+}
+
+/**
+ * Return the workspace of the calling thread, for solvers that aren't given one
+ * @return the thread's workspace
+ */
+SolverWorkspace& SolverWorkspace::ForThisThread() {
+    static thread_local SolverWorkspace workspace;
+
+    return workspace;
+}
+
+/**
+ * Take back everything handed out, keeping the memory for the next solve.  If
+ * the last solve needed overflow blocks, they are replaced by one main block
+ * big enough for all of it.
+ */
+void SolverWorkspace::Reset() {
+    size_t needed = _capacity + _overflowBytes;
+
+    while (_overflow) {
+        unsigned char* next = *(unsigned char**) _overflow;
+
+        free(_overflow);
+        _overflow = next;
+    }
+    _overflowBytes = 0;
+    _used = 0;
+    Reserve(needed);
+}
+
+/**
+ * Make sure the main block holds at least this much; call right after Reset,
+ * before anything is handed out
+ * @param bytes number of bytes wanted
+ */
+void SolverWorkspace::Reserve(size_t bytes) {
+    assert(_used == 0 && _overflow == nullptr);
+    if (bytes > _capacity) {
+        free(_block);
+        _block = nullptr;
+        _capacity = 0;
+        _block = NewBlock(RoundUp(bytes));
+        _capacity = RoundUp(bytes);
+    }
+}
+
+/**
+ * Take a cache line aligned block from the heap
+ * @param bytes size, a multiple of the alignment
+ * @return the block
+ */
+unsigned char* SolverWorkspace::NewBlock(size_t bytes) {
+    void* block = nullptr;
+
+    if (posix_memalign(&block, ALIGNMENT, bytes) != 0) {
+        throw std::bad_alloc();
+    }
+    _blocksAllocated++;
+    return (unsigned char*) block;
+}
+
+/**
+ * Hand out a piece from a block of its own, when the main block is full; the
+ * block's first cache line links it to the previous overflow block
+ * @param bytes size, a multiple of the alignment
+ * @return the piece
+ */
+void* SolverWorkspace::Overflow(size_t bytes) {
+    unsigned char* block = NewBlock(ALIGNMENT + bytes);
+
+    *(unsigned char**) block = _overflow;
+    _overflow = block;
+    _overflowBytes += bytes;
+    return block + ALIGNMENT;
+}
@@ -0,0 +1,106 @@
+//
+// Interface Definition for the SolverWorkspace Class
+// A bump allocator for the scratch memory of a search: one block, sized for
+// the largest maze seen so far, handed out in pieces during a solve and taken
+// back all at once before the next
+// Date: 10/18/2026
+//
+
+#ifndef SOLVERWORKSPACE_H
+#define SOLVERWORKSPACE_H
+
+#include <cassert>
+#include <cstddef>
+
+class SolverWorkspace {
+public:
+    SolverWorkspace();
+    ~SolverWorkspace();
+
+    SolverWorkspace(const SolverWorkspace&) = delete;
+    SolverWorkspace& operator=(const SolverWorkspace&) = delete;
+
+    static SolverWorkspace& ForThisThread();
+
+    void Reset();
+    void Reserve(size_t bytes);
+    template <typename T> T* Allocate(size_t count);
+
+    size_t Capacity() const;
+    size_t Used() const;
+    size_t BlocksAllocated() const;
+
+private:
+    static const size_t ALIGNMENT = 64;
+
+    static size_t RoundUp(size_t bytes);
+    unsigned char* NewBlock(size_t bytes);
+    void* Overflow(size_t bytes);
+
+    // Pieces come from _block while it lasts.  A solve that outgrows it gets
+    // extra blocks, which Reset folds into one bigger _block for next time.
+    // The extra blocks are chained through their first cache line, so keeping
+    // track of them needs no memory of its own.
+    unsigned char* _block;
+    size_t _capacity;
+    size_t _used;
+    unsigned char* _overflow;
+    size_t _overflowBytes;
+
+    // Number of blocks ever taken from the heap
+    size_t _blocksAllocated;
+};
+
+/**
+ * Return the size of the main block
+ * @return number of bytes
+ */
+inline size_t SolverWorkspace::Capacity() const {
+    return _capacity;
+}
+
+/**
+ * Return how much has been handed out since the last Reset
+ * @return number of bytes, counting alignment padding and any overflow blocks
+ */
+inline size_t SolverWorkspace::Used() const {
+    return _used + _overflowBytes;
+}
+
+/**
+ * Return the number of blocks the workspace has taken from the heap; once it
+ * has grown to fit the work, solves leave this unchanged.  Memory the solvers
+ * get elsewhere, such as the containers they return routes in, isn't counted.
+ * @return number of blocks allocated
+ */
+inline size_t SolverWorkspace::BlocksAllocated() const {
+    return _blocksAllocated;
+}
+
+/**
+ * Round a size up to a whole number of cache lines
+ * @param bytes size
+ * @return rounded size
+ */
+inline size_t SolverWorkspace::RoundUp(size_t bytes) {
+    return (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+/**
+ * Hand out uninitialized, cache line aligned room for an array, valid until the next Reset
+ * @param count number of elements
+ * @return pointer to the first element
+ */
+template <typename T>
+T* SolverWorkspace::Allocate(size_t count) {
+    size_t bytes = RoundUp(count * sizeof(T));
+
+    if (_used + bytes > _capacity) {
+        return (T*) Overflow(bytes);
+    }
+    T* piece = (T*) (_block + _used);
+    _used += bytes;
+    return piece;
+}
+
+#endif //SOLVERWORKSPACE_H
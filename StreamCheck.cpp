@@ -0,0 +1,221 @@
+//
+// Streaming solvability check for mazes too large to load as a Grid
+// Date: 10/18/2026
+//
+
+#include <cstdint>
+#include <stack>
+#include <string>
+#include <vector>
+using std::stack;
+using std::string;
+using std::vector;
+
+#include "Grid.h"
+#include "CursesWindow.h"
+#include "Maze.h"
+
+static const uint32_t NO_LABEL = UINT32_MAX;
+
+/**
+* Find the root of a union-find node, halving the path on the way
+* @param parent union-find parent of each node
+* @param node node to look up
+* @return root of the node's set
+*/
+static uint32_t FindRoot(vector<uint32_t>& parent, uint32_t node) {
+    while (parent[node] != node) {
+        parent[node] = parent[parent[node]];
+        node = parent[node];
+    }
+    return node;
+}
+
+/**
+* Read one maze row and convert it to open cell bits, 64 columns to a word
+* Walls and columns past the end of the row are zero bits.  The conversion is
+* branch free, since the characters of a random maze defeat branch prediction.
+* @param is stream to read from
+* @param line buffer for the row's text
+* @param nCols number of columns the row must have
+* @param open receives the row's open cell bits, (nCols + 63) / 64 words
+* @return true if the row has exactly nCols '-' and '@' characters
+*/
+static bool ReadRow(istream& is, string& line, size_t nCols, vector<uint64_t>& open) {
+    if (!getline(is, line)) {
+        return false;
+    }
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    if (line.length() != nCols) {
+        return false;
+    }
+
+    unsigned bad = 0;
+    for (size_t w = 0; w < open.size(); w++) {
+        const char* text = line.data() + 64 * w;
+        size_t count = (nCols - 64 * w < 64) ? nCols - 64 * w : 64;
+        uint64_t bits = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            bits |= uint64_t(text[i] == '-') << i;
+            bad |= (text[i] != '-') & (text[i] != '@');
+        }
+        open[w] = bits;
+    }
+    return bad == 0;
+}
+
+/**
+* Find the runs of open cells in a row
+* @param open the row's open cell bits
+* @param nCols number of columns
+* @param begin receives the first column of each run
+* @param end receives one past the last column of each run
+*/
+static void FindRuns(const vector<uint64_t>& open, size_t nCols, vector<uint32_t>& begin, vector<uint32_t>& end) {
+    uint64_t carry = 0;
+
+    begin.clear();
+    end.clear();
+    for (size_t w = 0; w < open.size(); w++) {
+        uint64_t shifted = (open[w] << 1) | carry;
+        uint64_t starts = open[w] & ~shifted;
+        uint64_t stops = ~open[w] & shifted;
+
+        // Starts and stops alternate along the row, so each list stays in order
+        while (starts != 0) {
+            begin.push_back((uint32_t) (64 * w + __builtin_ctzll(starts)));
+            starts &= starts - 1;
+        }
+        while (stops != 0) {
+            end.push_back((uint32_t) (64 * w + __builtin_ctzll(stops)));
+            stops &= stops - 1;
+        }
+        carry = open[w] >> 63;
+    }
+    if (end.size() < begin.size()) {
+        end.push_back((uint32_t) nCols);
+    }
+}
+
+/**
+* Determine whether a maze file can be solved, reading it a row at a time
+* Only two rows are ever held, each as a list of runs of open cells.  Each run
+* of the previous row carries a label naming its connected component within the
+* rows read so far, and a union-find over those components and the runs of the
+* new row merges whatever the new row joins together.  A component is marked
+* once it holds the upper left corner, so the maze is solvable if the lower
+* right corner ends up in a marked component.  Memory is proportional to the
+* number of columns.
+* @param is stream holding a maze in the format Grid::LoadFromFile reads
+* @param solvable receives true if a route exists, false otherwise
+* @return true if the stream held a well formed maze, false if not
+*/
+bool IsSolvableStream(istream& is, bool& solvable) {
+    size_t nRows;
+    size_t nCols;
+    string line;
+
+    solvable = false;
+    if (!(is >> nRows >> nCols)) {
+        return false;
+    }
+    getline(is, line);  // Discard remainder of line number of columns is on
+    if (nRows == 0 || nCols == 0 || nCols >= NO_LABEL) {
+        return false;
+    }
+
+    // Runs of the previous row, the label of each run's component, and whether
+    // each labelled component reaches the start
+    vector<uint32_t> prevBegin;
+    vector<uint32_t> prevEnd;
+    vector<uint32_t> prevLabel;
+    vector<bool> marked;
+    size_t nLabels = 0;
+
+    // Union-find nodes: the previous row's components, then the new row's runs
+    vector<uint64_t> open((nCols + 63) / 64);
+    vector<uint32_t> runBegin;
+    vector<uint32_t> runEnd;
+    vector<uint32_t> runLabel;
+    vector<uint32_t> parent;
+    vector<bool> rootMarked;
+    vector<uint32_t> newLabel;
+    bool startAlive = true;
+
+    for (size_t row = 0; row < nRows; row++) {
+        if (!ReadRow(is, line, nCols, open)) {
+            return false;
+        }
+        if (!startAlive) {
+            // Nothing below can reach the start any more; just check the format
+            continue;
+        }
+        FindRuns(open, nCols, runBegin, runEnd);
+
+        size_t nNodes = nLabels + runBegin.size();
+        parent.resize(nNodes);
+        for (size_t node = 0; node < nNodes; node++) {
+            parent[node] = (uint32_t) node;
+        }
+
+        // Join each run to the components of the runs it overlaps in the row above.
+        // Both lists are in column order, so one pass over each does it.
+        size_t first = 0;
+        for (size_t run = 0; run < runBegin.size(); run++) {
+            uint32_t node = (uint32_t) (nLabels + run);
+            uint32_t last = NO_LABEL;
+
+            while (first < prevBegin.size() && prevEnd[first] <= runBegin[run]) {
+                first++;
+            }
+            for (size_t above = first; above < prevBegin.size() && prevBegin[above] < runEnd[run]; above++) {
+                if (prevLabel[above] != last) {
+                    uint32_t a = FindRoot(parent, node);
+                    uint32_t b = FindRoot(parent, prevLabel[above]);
+
+                    if (a != b) {
+                        parent[a] = b;
+                    }
+                    last = prevLabel[above];
+                }
+            }
+        }
+
+        // Marks gather at the roots
+        rootMarked.assign(nNodes, false);
+        for (size_t label = 0; label < nLabels; label++) {
+            if (marked[label]) {
+                rootMarked[FindRoot(parent, (uint32_t) label)] = true;
+            }
+        }
+        if (row == 0 && !runBegin.empty() && runBegin[0] == 0) {
+            rootMarked[FindRoot(parent, (uint32_t) nLabels)] = true;
+        }
+
+        // Relabel the new row's runs by root, numbering the roots from zero
+        newLabel.assign(nNodes, NO_LABEL);
+        runLabel.resize(runBegin.size());
+        marked.clear();
+        startAlive = false;
+        for (size_t run = 0; run < runBegin.size(); run++) {
+            uint32_t root = FindRoot(parent, (uint32_t) (nLabels + run));
+
+            if (newLabel[root] == NO_LABEL) {
+                newLabel[root] = (uint32_t) marked.size();
+                marked.push_back(rootMarked[root]);
+                startAlive = startAlive || rootMarked[root];
+            }
+            runLabel[run] = newLabel[root];
+        }
+        nLabels = marked.size();
+        prevBegin.swap(runBegin);
+        prevEnd.swap(runEnd);
+        prevLabel.swap(runLabel);
+    }
+
+    solvable = startAlive && !prevEnd.empty() && prevEnd.back() == nCols && marked[prevLabel.back()];
+    return true;
+}
@@ -0,0 +1,103 @@
+//
+// Method implementation for the ThreadPool Class
+// Date: 10/18/2026
+//
+
+#include "ThreadPool.h"
+
+/**
+ * Constructor, starts the worker threads
+ * @param nThreads number of threads to run tasks on, counting the thread that calls
+ *        Run(); 0 means one per hardware thread
+ */
+ThreadPool::ThreadPool(unsigned nThreads) {
+    if (nThreads == 0) {
+        nThreads = std::thread::hardware_concurrency();
+    }
+    if (nThreads == 0) {
+        nThreads = 1;
+    }
+    _task = nullptr;
+    _generation = 0;
+    _running = 0;
+    _stopping = false;
+    for (unsigned worker = 1; worker < nThreads; worker++) {
+        _workers.emplace_back(&ThreadPool::WorkerLoop, this, worker);
+    }
+}
+
+/**
+ * Destructor, stops and joins the worker threads
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _start.notify_all();
+    for (std::thread& thread : _workers) {
+        thread.join();
+    }
+}
+
+/**
+ * Return number of threads a task runs on, counting the caller
+ * @return number of threads
+ */
+unsigned ThreadPool::NumberThreads() const {
+    return (unsigned) _workers.size() + 1;
+}
+
+/**
+ * Run a task on every thread at once, and wait for all of them to finish
+ * The calling thread takes part as thread 0, so a pool of one thread simply
+ * calls the task.
+ * @param task called once per thread with the thread's number, 0 .. NumberThreads() - 1
+ */
+void ThreadPool::Run(const function<void(unsigned)>& task) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = &task;
+        _running = (unsigned) _workers.size();
+        _generation++;
+    }
+    _start.notify_all();
+
+    task(0);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this] { return _running == 0; });
+    _task = nullptr;
+}
+
+/**
+ * Body of each worker thread: wait for a task, run it, report back, repeat
+ * @param worker the thread's number
+ */
+void ThreadPool::WorkerLoop(unsigned worker) {
+    unsigned long seen = 0;
+
+    while (true) {
+        const function<void(unsigned)>* task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _start.wait(lock, [this, seen] { return _stopping || _generation != seen; });
+            if (_stopping) {
+                return;
+            }
+            seen = _generation;
+            task = _task;
+        }
+
+        (*task)(worker);
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            last = (--_running == 0);
+        }
+        if (last) {
+            _done.notify_one();
+        }
+    }
+}
@@ -0,0 +1,43 @@
+//
+// Interface Definition for the ThreadPool Class
+// A fixed set of worker threads that all run the same task together, for
+// searches that split each step of their work across threads
+// Date: 10/18/2026
+//
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+using std::function;
+using std::vector;
+
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned nThreads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned NumberThreads() const;
+    void Run(const function<void(unsigned)>& task);
+
+private:
+    void WorkerLoop(unsigned worker);
+
+    vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _start;
+    std::condition_variable _done;
+    const function<void(unsigned)>* _task;
+    unsigned long _generation;
+    unsigned _running;
+    bool _stopping;
+};
+
+#endif //THREADPOOL_H
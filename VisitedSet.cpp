@@ -0,0 +1,63 @@
+//
+// Method implementation for the VisitedSet Class
+// Date: 10/18/2026
+//
+
+#include <algorithm>
+#include "VisitedSet.h"
+
+/**
+ * Default constructor
+ * Creates a set that can hold no cells
+ */
+VisitedSet::VisitedSet() {
+    _nCells = 0;
+}
+
+/**
+ * Constructor
+ * Creates an empty set able to hold cells 0 .. nCells-1
+ * @param nCells number of cells in the grid
+ */
+VisitedSet::VisitedSet(size_t nCells) {
+    _nCells = 0;
+    Configure(nCells);
+}
+
+/**
+ * Resize the set to hold cells 0 .. nCells-1 and empty it
+ * Storage is reused when the set shrinks or stays the same size
+ * @param nCells number of cells in the grid
+ */
+void VisitedSet::Configure(size_t nCells) {
+    _nCells = nCells;
+    _words.assign((nCells + 63) / 64, 0);
+}
+
+/**
+ * Empty the set, touching one 64-bit word per 64 cells
+ */
+void VisitedSet::Reset() {
+    std::fill(_words.begin(), _words.end(), 0);
+}
+
+/**
+ * Return number of cells the set can hold
+ * @return capacity in cells
+ */
+size_t VisitedSet::Capacity() const {
+    return _nCells;
+}
+
+/**
+ * Return number of cells currently in the set
+ * @return population count
+ */
+size_t VisitedSet::Count() const {
+    size_t count = 0;
+
+    for (uint64_t word : _words) {
+        count += __builtin_popcountll(word);
+    }
+    return count;
+}
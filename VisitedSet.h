@@ -0,0 +1,72 @@
+//
+// Interface Definition for the VisitedSet Class
+// A dense, bit-packed set keyed by a small integer index: CellHandle indices
+// in the solution checker, and (cell, direction) search states in jump point
+// search
+// Date: 10/18/2026
+//
+
+#ifndef VISITEDSET_H
+#define VISITEDSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+using std::vector;
+
+class VisitedSet {
+public:
+    VisitedSet();
+    explicit VisitedSet(size_t nCells);
+
+    void Configure(size_t nCells);
+    void Reset();
+
+    size_t Capacity() const;
+    size_t Count() const;
+
+    bool Contains(size_t index) const;
+    bool Insert(size_t index);
+    void Remove(size_t index);
+
+private:
+    vector<uint64_t> _words;
+    size_t _nCells;
+};
+
+// Membership tests sit on the solver's inner loop, so they are defined inline
+
+/**
+ * Is the cell with this linear index in the set?
+ * @param index linear cell index, must be less than Capacity()
+ * @return true if present, false if not
+ */
+inline bool VisitedSet::Contains(size_t index) const {
+    return (_words[index >> 6] >> (index & 63)) & 1;
+}
+
+/**
+ * Add the cell with this linear index to the set
+ * @param index linear cell index, must be less than Capacity()
+ * @return true if the cell was newly added, false if it was already present
+ */
+inline bool VisitedSet::Insert(size_t index) {
+    uint64_t bit = uint64_t(1) << (index & 63);
+    uint64_t& word = _words[index >> 6];
+
+    if (word & bit) {
+        return false;
+    }
+    word |= bit;
+    return true;
+}
+
+/**
+ * Remove the cell with this linear index from the set
+ * @param index linear cell index, must be less than Capacity()
+ */
+inline void VisitedSet::Remove(size_t index) {
+    _words[index >> 6] &= ~(uint64_t(1) << (index & 63));
+}
+
+#endif //VISITEDSET_H
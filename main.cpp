@@ -3,20 +3,32 @@
 // Author: Max Benson
 // Last Update: 08/17/2022
 //
+#ifdef COUNT_HEAP_ALLOCATIONS
+#include <atomic>
+#endif
 #include <cassert>
+#include <chrono>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <new>
 #include <stack>
+#include <vector>
 #include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
 using std::cout;
 using std::cerr;
 using std::endl;
+using std::fstream;
 using std::ifstream;
+using std::ofstream;
 using std::stringstream;
 using std::stack;
+using std::vector;
 using std::cout;
 using std::endl;
 using std::left;
@@ -25,15 +37,73 @@ using std::setw;
 #include "Grid.h"
 #include "CursesWindow.h"
 #include "Maze.h"
+#include "Solver.h"
+#include "BfsSolver.h"
+#include "ParallelBfsSolver.h"
+#include "DirectionOptimizingSolver.h"
+#include "BatchRunner.h"
+#include "ConnectivityIndex.h"
+#include "MazeSolver.h"
+#include "JunctionGraph.h"
+#include "HierarchicalGraph.h"
+#include "DynamicSolver.h"
+#include "SolverWorkspace.h"
+#include "BorderedGrid.h"
+#include "VisitedSet.h"
+
+#ifdef COUNT_HEAP_ALLOCATIONS
+// In the MazeSolverTests build every operator new in the program goes through
+// here and is counted, so tests can check that a piece of code doesn't touch
+// the heap.  MazeSolver itself keeps the library's allocator.
+static std::atomic<size_t> heapAllocations(0);
+
+void* operator new(size_t size) {
+    void* block = malloc(size ? size : 1);
+
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    heapAllocations++;
+    return block;
+}
+
+void operator delete(void* block) noexcept {
+    free(block);
+}
+
+void operator delete(void* block, size_t) noexcept {
+    free(block);
+}
+#endif
 
 // Forward declarations of test functions
 void TestGridLocationClass(unsigned& testsPassed, unsigned& testsFailed);
 void TestGridClass(unsigned& testsPassed, unsigned& testsFailed);
+void TestVisitedSetClass(unsigned& testsPassed, unsigned& testsFailed);
 void TestGenerateValidMoves(unsigned& testsPassed, unsigned& testsFailed);
 void TestSolve(unsigned& testsPassed, unsigned& testsFailed);
+void TestIsSolvable(unsigned& testsPassed, unsigned& testsFailed);
 void TestCheckSolution(unsigned& testsPassed, unsigned& testsFailed);
+void TestBatch(unsigned& testsPassed, unsigned& testsFailed);
+void TestConnectivityIndex(unsigned& testsPassed, unsigned& testsFailed);
+void TestMazeSolver(unsigned& testsPassed, unsigned& testsFailed);
+void TestDistanceField(unsigned& testsPassed, unsigned& testsFailed);
+void TestHierarchicalGraph(unsigned& testsPassed, unsigned& testsFailed);
+void TestDynamicSolver(unsigned& testsPassed, unsigned& testsFailed);
+void TestSolverWorkspace(unsigned& testsPassed, unsigned& testsFailed);
+void TestCellHandles(unsigned& testsPassed, unsigned& testsFailed);
 void Test(bool condition, const char* message, unsigned& testsPassed, unsigned& testsFailed);
-void DoSolve(string fileName, bool fVisualize);
+void DoSolve(string fileName, bool fVisualize, const string& algorithm, bool fStats);
+void PrintLevelModes(const string& modes);
+void DoCheck(string fileName);
+void DoStreamCheck(const string& fileName);
+void DoConvert(const string& inName, const string& outName);
+void DoDistanceField(const string& inName, const string& outName);
+void DoBatch(const string& source, const string& algorithm, unsigned nThreads);
+vector<string> ListMazeFiles(const string& directoryName);
+bool IsValidRoute(const Grid& maze, const vector<GridLocation>& route, const GridLocation& start, const GridLocation& goal);
+bool RunSolver(const string& algorithm, const Grid& maze, stack<GridLocation>& solution, CursesWindow* pwindow, SolveStats& stats);
+bool SolveWithGraphCache(const string& fileName, const Grid& maze, stack<GridLocation>& solution, SolveStats& stats);
 
 
 int main(int argc, char* argv[]) {
@@ -64,6 +134,17 @@ int main(int argc, char* argv[]) {
         cout << "=================================================" << endl;
         return 0;
     }
+    else if (argc == 2 && strcmp(argv[1], "--test:visited") == 0) {
+        unsigned testsPassed = 0;
+        unsigned testsFailed = 0;
+
+        TestVisitedSetClass(testsPassed, testsFailed);
+
+        cout << endl << "TEST SUMMARY: " << 100. * testsPassed / (testsPassed + testsFailed) << "%, PASS = "
+             << testsPassed << ", FAIL = " << testsFailed << endl;
+
+        return 0;
+    }
     else if (argc == 2 && strcmp(argv[1], "--test:moves") == 0) {
         unsigned testsPassed = 0;
         unsigned testsFailed = 0;
@@ -97,33 +178,239 @@ int main(int argc, char* argv[]) {
 
         return 0;
     }
-    else {
-        if (argc == 2) {
-            DoSolve(argv[1], false);
+    else if (argc == 2 && strcmp(argv[1], "--test:issolvable") == 0) {
+        unsigned testsPassed = 0;
+        unsigned testsFailed = 0;
+
+        TestIsSolvable(testsPassed, testsFailed);
+
+        cout << endl << "TEST SUMMARY: " << 100. * testsPassed / (testsPassed + testsFailed) << "%, PASS = "
+             << testsPassed << ", FAIL = " << testsFailed << endl;
+
+        return 0;
+    }
+    else if (argc == 2 && strcmp(argv[1], "--test:batch") == 0) {
+        unsigned testsPassed = 0;
+        unsigned testsFailed = 0;
+
+        TestBatch(testsPassed, testsFailed);
+
+        cout << endl << "TEST SUMMARY: " << 100. * testsPassed / (testsPassed + testsFailed) << "%, PASS = "
+             << testsPassed << ", FAIL = " << testsFailed << endl;
+
+        return 0;
+    }
+    else if (argc == 2 && strcmp(argv[1], "--test:connectivity") == 0) {
+        unsigned testsPassed = 0;
+        unsigned testsFailed = 0;
+
+        TestConnectivityIndex(testsPassed, testsFailed);
+
+        cout << endl << "TEST SUMMARY: " << 100. * testsPassed / (testsPassed + testsFailed) << "%, PASS = "
+             << testsPassed << ", FAIL = " << testsFailed << endl;
+
+        return 0;
+    }
+    else if (argc == 2 && strcmp(argv[1], "--test:queries") == 0) {
+        unsigned testsPassed = 0;
+        unsigned testsFailed = 0;
+
+        TestMazeSolver(testsPassed, testsFailed);
+
+        cout << endl << "TEST SUMMARY: " << 100. * testsPassed / (testsPassed + testsFailed) << "%, PASS = "
+             << testsPassed << ", FAIL = " << testsFailed << endl;
+
+        return 0;
+    }
+    else if (argc == 2 && strcmp(argv[1], "--test:distance") == 0) {
+        unsigned testsPassed = 0;
+        unsigned testsFailed = 0;
+
+        TestDistanceField(testsPassed, testsFailed);
+
+        cout << endl << "TEST SUMMARY: " << 100. * testsPassed / (testsPassed + testsFailed) << "%, PASS = "
+             << testsPassed << ", FAIL = " << testsFailed << endl;
+
+        return 0;
+    }
+    else if (argc == 2 && strcmp(argv[1], "--test:hierarchy") == 0) {
+        unsigned testsPassed = 0;
+        unsigned testsFailed = 0;
+
+        TestHierarchicalGraph(testsPassed, testsFailed);
+
+        cout << endl << "TEST SUMMARY: " << 100. * testsPassed / (testsPassed + testsFailed) << "%, PASS = "
+             << testsPassed << ", FAIL = " << testsFailed << endl;
+
+        return 0;
+    }
+    else if (argc == 2 && strcmp(argv[1], "--test:dynamic") == 0) {
+        unsigned testsPassed = 0;
+        unsigned testsFailed = 0;
+
+        TestDynamicSolver(testsPassed, testsFailed);
+
+        cout << endl << "TEST SUMMARY: " << 100. * testsPassed / (testsPassed + testsFailed) << "%, PASS = "
+             << testsPassed << ", FAIL = " << testsFailed << endl;
+
+        return 0;
+    }
+    else if (argc == 2 && strcmp(argv[1], "--test:workspace") == 0) {
+        unsigned testsPassed = 0;
+        unsigned testsFailed = 0;
+
+        TestSolverWorkspace(testsPassed, testsFailed);
+
+        cout << endl << "TEST SUMMARY: " << 100. * testsPassed / (testsPassed + testsFailed) << "%, PASS = "
+             << testsPassed << ", FAIL = " << testsFailed << endl;
+
+        return 0;
+    }
+    else if (argc == 2 && strcmp(argv[1], "--test:handles") == 0) {
+        unsigned testsPassed = 0;
+        unsigned testsFailed = 0;
+
+        TestCellHandles(testsPassed, testsFailed);
+
+        cout << endl << "TEST SUMMARY: " << 100. * testsPassed / (testsPassed + testsFailed) << "%, PASS = "
+             << testsPassed << ", FAIL = " << testsFailed << endl;
+
+        return 0;
+    }
+    else if (argc == 3 && strcmp(argv[1], "--check-only") == 0) {
+        DoCheck(argv[2]);
+        return 0;
+    }
+    else if (argc == 3 && strcmp(argv[1], "--stream-check") == 0) {
+        DoStreamCheck(argv[2]);
+        return 0;
+    }
+    else if (argc == 4 && strcmp(argv[1], "--convert") == 0) {
+        DoConvert(argv[2], argv[3]);
+        return 0;
+    }
+    else if (argc == 4 && strcmp(argv[1], "--distance-field") == 0) {
+        DoDistanceField(argv[2], argv[3]);
+        return 0;
+    }
+    else if (argc >= 2 && argv[argc-1][0] != '-') {
+        bool fVisualize = false;
+        bool fStats = false;
+        bool fBatch = false;
+        bool fValid = true;
+        unsigned nThreads = 0;
+        string algorithm = "bfs";
+
+        // Options come before the file name
+        for (int i = 1; i < argc - 1; i++) {
+            if (strcmp(argv[i], "--visualize") == 0) {
+                fVisualize = true;
+            }
+            else if (strcmp(argv[i], "--stats") == 0) {
+                fStats = true;
+            }
+            else if (strcmp(argv[i], "--batch") == 0 && i == argc - 2) {
+                fBatch = true;
+            }
+            else if (strncmp(argv[i], "--threads=", strlen("--threads=")) == 0 && atoi(argv[i] + strlen("--threads=")) > 0) {
+                nThreads = (unsigned) atoi(argv[i] + strlen("--threads="));
+            }
+            else if (strncmp(argv[i], "--algo=", strlen("--algo=")) == 0 && Solver::Create(argv[i] + strlen("--algo="))) {
+                algorithm = argv[i] + strlen("--algo=");
+            }
+            else {
+                fValid = false;
+            }
+        }
+        if (fValid && fBatch) {
+            DoBatch(argv[argc-1], algorithm, nThreads);
             return 0;
         }
-        else if (argc == 3 && strcmp(argv[1], "--visualize") == 0) {
-            DoSolve(argv[2], true);
+        else if (fValid) {
+            DoSolve(argv[argc-1], fVisualize, algorithm, fStats);
             return 0;
         }
     }
     cout << "Ways to run:" << '\n';
     cout << "MazeSolver --test:location" << '\n';
     cout << "MazeSolver --test:grid" << '\n';
+    cout << "MazeSolver --test:visited" << '\n';
     cout << "MazeSolver --test:moves" << '\n';
     cout << "MazeSolver --test:checksolution" << '\n';
     cout << "MazeSolver --test:solve" << "\n";
-    cerr << "MazeSolver [--visualize] <filename>" << "\n";
+    cout << "MazeSolver --test:issolvable" << "\n";
+    cout << "MazeSolver --test:batch" << "\n";
+    cout << "MazeSolver --test:connectivity" << "\n";
+    cout << "MazeSolver --test:queries" << "\n";
+    cout << "MazeSolver --test:distance" << "\n";
+    cout << "MazeSolver --test:hierarchy" << "\n";
+    cout << "MazeSolver --test:dynamic" << "\n";
+    cout << "MazeSolver --test:workspace" << "\n";
+    cout << "MazeSolver --test:handles" << "\n";
+    cerr << "MazeSolver [--visualize] [--stats] [--algo=bfs|bibfs|astar|jps|pbfs|dobfs|junction] <filename>" << "\n";
+    cerr << "    (prefix an algorithm with fill+, as in --algo=fill+astar, to fill dead ends first)" << "\n";
+    cerr << "MazeSolver --check-only <filename>" << "\n";
+    cerr << "MazeSolver --stream-check <filename>" << "\n";
+    cerr << "MazeSolver --convert <in.maze> <out.mzb>" << "\n";
+    cerr << "MazeSolver --distance-field <filename> <out>" << "\n";
+    cerr << "MazeSolver [--algo=...] [--threads=N] --batch <directory|list-file>" << "\n";
     return 1;
 }
 
+/**  Runs one of the solvers
+ * @param algorithm one of the names from Solver::Names()
+ * @param maze the maze to solve
+ * @param solution out parameter used to return solution if it is found
+ * @param pwindow if not nullptr, used to animate the solution process (bfs only)
+ * @param stats receives the amount of work done
+ * @return true if solution can be found, false otherwise
+ */
+bool RunSolver(const string& algorithm, const Grid& maze, stack<GridLocation>& solution, CursesWindow* pwindow, SolveStats& stats) {
+    if (algorithm == "bfs") {
+        return SolveMaze(maze, solution, pwindow, &stats);
+    }
+
+    unique_ptr<Solver> solver = Solver::Create(algorithm);
+    assert(solver);
+    return SolveMaze(maze, solution, *solver, &stats);
+}
+
+/**  Solves a maze over its junction graph, cached in a file next to the maze file
+ * The cached graph is used if it was built from this maze; otherwise the graph
+ * is built and the cache (re)written.
+ * @param fileName pathname of the maze file; the cache is this with ".jgraph" added
+ * @param maze the maze to solve
+ * @param solution out parameter used to return solution if it is found
+ * @param stats receives the amount of work done
+ * @return true if solution can be found, false otherwise
+ */
+bool SolveWithGraphCache(const string& fileName, const Grid& maze, stack<GridLocation>& solution, SolveStats& stats) {
+    JunctionGraph graph;
+    string cacheName = fileName + ".jgraph";
+    GridLocation start(0, 0);
+    GridLocation goal(maze.NumberRows() - 1, maze.NumberCols() - 1);
+
+    if (graph.Load(cacheName, maze, start, goal)) {
+        cerr << "Junction graph: " << graph.NumberNodes() << " nodes, loaded from '" << cacheName << "'" << endl;
+    }
+    else {
+        graph.Build(maze, start, goal);
+        cerr << "Junction graph: " << graph.NumberNodes() << " nodes, built"
+             << (graph.Save(cacheName) ? ", saved to '" + cacheName + "'" : string()) << endl;
+    }
+    return graph.Solve(maze, solution, &stats);
+}
+
 /**  Tries to solve a maze
  * @param fileName  pathname of maze file
  * @param fVisualize whether to graphically display maze and its solution
+ * @param algorithm which solver to use, one of the names from Solver::Names()
+ * @param fStats whether to report details of the search, such as the mode of each level
  */
-void DoSolve(string fileName, bool fVisualize) {
+void DoSolve(string fileName, bool fVisualize, const string& algorithm, bool fStats) {
     Grid maze;
     stack<GridLocation> solution;
+    SolveStats stats = SolveStats();
     CursesWindow window;
     ifstream ifs;
 
@@ -133,7 +420,8 @@ void DoSolve(string fileName, bool fVisualize) {
         cerr << "Can't open '" << fileName << "'" << endl;
         exit(2);
     }
-    if (!maze.LoadFromFile(ifs)) {
+    ifs.close();
+    if (!maze.LoadFromPath(fileName)) {
         cerr << "Load from '" << fileName << "' failed " << endl;
         exit(3);
     }
@@ -142,7 +430,7 @@ void DoSolve(string fileName, bool fVisualize) {
     if (fVisualize) {
         window.InitGraphics();
         window.ShowGrid(maze);
-        if (SolveMaze(maze, solution, &window)) {
+        if (RunSolver(algorithm, maze, solution, &window, stats)) {
             window.ShowPath(solution, true);
         }
         getch();
@@ -150,26 +438,39 @@ void DoSolve(string fileName, bool fVisualize) {
     else {
         cerr << "Maze:" << endl;
         cerr << maze;
-        if (SolveMaze(maze, solution)) {
+
+        auto begin = std::chrono::steady_clock::now();
+        bool found = (algorithm == "junction") ? SolveWithGraphCache(fileName, maze, solution, stats)
+                                               : RunSolver(algorithm, maze, solution, nullptr, stats);
+        auto end = std::chrono::steady_clock::now();
+
+        cerr << "Algorithm: " << algorithm << ", cells expanded: " << stats.cellsExpanded << ", time: "
+             << std::chrono::duration<double, std::milli>(end - begin).count() << " ms" << endl;
+        if (stats.cellsPruned > 0) {
+            cerr << "Dead ends filled: " << stats.cellsPruned << " cells" << endl;
+        }
+        if (fStats) {
+            PrintLevelModes(stats.levelModes);
+        }
+        if (found) {
             bool correct;
-            bool firstItem;
-            string s;
+            vector<GridLocation> path;
+            stringstream ss;
 
             correct = CheckSolution(maze, solution);
             cerr << "Solution:" << endl;
-            s += "]";
-            firstItem = true;
+
+            // The stack has the end of the path on top; print from the start
             while (!solution.empty()) {
-                if (!firstItem) {
-                    s = "," + s;
-                } else {
-                    firstItem = false;
-                }
-                s = solution.top().ToString() + s;
+                path.push_back(solution.top());
                 solution.pop();
             }
-            s = "[" + s;
-            cout << s << endl;
+            ss << "[";
+            for (size_t i = path.size(); i > 0; i--) {
+                ss << path[i-1].ToString() << (i > 1 ? "," : "");
+            }
+            ss << "]";
+            cout << ss.str() << endl;
             if (correct) {
                 cerr << "Solution is correct" << endl;
             }
@@ -181,18 +482,197 @@ void DoSolve(string fileName, bool fVisualize) {
             cerr << "Couldn't find solution to maze." << endl;
         }
     }
+}
+
+/**  Prints which mode each level of a search used, as runs of the same mode
+ * @param modes one character per level, 'T' for top down and 'B' for bottom up
+ */
+void PrintLevelModes(const string& modes) {
+    if (modes.empty()) {
+        cerr << "Level modes: not recorded by this algorithm" << endl;
+        return;
+    }
+
+    size_t bottomUp = 0;
+    stringstream ss;
+    for (size_t i = 0; i < modes.size(); ) {
+        size_t run = 1;
+
+        while (i + run < modes.size() && modes[i + run] == modes[i]) {
+            run++;
+        }
+        ss << (i > 0 ? ", " : "") << (modes[i] == 'B' ? "bottom up" : "top down") << " x" << run;
+        if (modes[i] == 'B') {
+            bottomUp += run;
+        }
+        i += run;
+    }
+    cerr << "Levels: " << modes.size() << " (top down " << modes.size() - bottomUp << ", bottom up " << bottomUp << ")" << endl;
+    cerr << "Level modes: " << ss.str() << endl;
+}
+
+/**  Checks whether a maze can be solved, without finding the route
+ * Prints "solvable" or "unsolvable"
+ * @param fileName  pathname of maze file
+ */
+void DoCheck(string fileName) {
+    Grid maze(GridStorage::Bits);
+    ifstream ifs;
+
+    // Load maze file
+    ifs.open(fileName, ifstream::in);
+    if (!ifs.good()) {
+        cerr << "Can't open '" << fileName << "'" << endl;
+        exit(2);
+    }
     ifs.close();
+    if (!maze.LoadFromPath(fileName)) {
+        cerr << "Load from '" << fileName << "' failed " << endl;
+        exit(3);
+    }
+
+    cout << (IsSolvable(maze) ? "solvable" : "unsolvable") << endl;
+}
+
+/**  Checks whether a maze can be solved, reading it a row at a time rather than loading it
+ * @param fileName  pathname of maze file
+ */
+void DoStreamCheck(const string& fileName) {
+    ifstream ifs;
+    bool solvable;
+
+    ifs.open(fileName, ifstream::in);
+    if (!ifs.good()) {
+        cerr << "Can't open '" << fileName << "'" << endl;
+        exit(2);
+    }
+    if (!IsSolvableStream(ifs, solvable)) {
+        cerr << "Load from '" << fileName << "' failed " << endl;
+        exit(3);
+    }
+    cout << (solvable ? "solvable" : "unsolvable") << endl;
+}
+
+/**  Writes the distance of every cell from the upper left corner, in binary
+ * @param inName  pathname of maze file
+ * @param outName  pathname of distance file to write
+ */
+void DoDistanceField(const string& inName, const string& outName) {
+    Grid maze(GridStorage::Bits);
+    GridLocation source(0, 0);
+
+    if (!maze.LoadFromPath(inName)) {
+        cerr << "Load from '" << inName << "' failed " << endl;
+        exit(3);
+    }
+
+    vector<uint32_t> distance = ComputeDistanceField(maze, source);
+    size_t reached = 0;
+    uint32_t farthest = 0;
+    for (uint32_t d : distance) {
+        if (d != UNREACHABLE) {
+            reached++;
+            farthest = (d > farthest) ? d : farthest;
+        }
+    }
+    if (!SaveDistanceField(outName, maze, source, distance)) {
+        cerr << "Can't write '" << outName << "'" << endl;
+        exit(2);
+    }
+    cout << "Reached " << reached << " cells, farthest " << farthest << " moves away" << endl;
+}
+
+/**  Converts a maze file to the binary format, which loads without parsing
+ * @param inName  pathname of maze file, text or binary
+ * @param outName  pathname of binary maze file to write
+ */
+void DoConvert(const string& inName, const string& outName) {
+    Grid maze(GridStorage::Bits);
+
+    if (!maze.LoadFromPath(inName, true)) {
+        cerr << "Load from '" << inName << "' failed " << endl;
+        exit(3);
+    }
+    if (!maze.SaveBinary(outName)) {
+        cerr << "Can't write '" << outName << "'" << endl;
+        exit(2);
+    }
+    cout << "Converted " << maze.NumberRows() << "x" << maze.NumberCols() << " maze to '" << outName << "'" << endl;
+}
+
+/**  Solves every maze in a directory, or listed one per line in a file
+ * Writes one result line per maze to standard output, then throughput totals
+ * @param source directory of ".maze" files, or file of maze pathnames
+ * @param algorithm which solver to use, one of the names from Solver::Names()
+ * @param nThreads number of worker threads, 0 for one per hardware thread
+ */
+void DoBatch(const string& source, const string& algorithm, unsigned nThreads) {
+    vector<string> fileNames;
+    struct stat info;
+
+    if (stat(source.c_str(), &info) != 0) {
+        cerr << "Can't open '" << source << "'" << endl;
+        exit(2);
+    }
+    if (S_ISDIR(info.st_mode)) {
+        fileNames = ListMazeFiles(source.back() == '/' ? source : source + "/");
+    }
+    else {
+        ifstream ifs(source);
+        string line;
+
+        while (std::getline(ifs, line)) {
+            if (!line.empty()) {
+                fileNames.push_back(line);
+            }
+        }
+    }
+
+    BatchRunner runner(algorithm, nThreads);
+    BatchSummary summary = runner.Run(fileNames, cout);
+
+    cerr << "Batch: " << summary.mazes << " mazes (" << summary.solved << " solved, " << summary.unsolvable
+         << " unsolvable, " << summary.errors << " errors) in " << summary.seconds << " s" << endl;
+    cerr << "Throughput: " << summary.mazes / summary.seconds << " mazes/sec, "
+         << summary.cells / summary.seconds << " cells/sec, "
+         << summary.cellsExpanded / summary.seconds << " cells expanded/sec" << endl;
+}
+
+/**
+ * Lists the maze files in a directory
+ * @param directoryName directory to search, ending with '/'
+ * @return pathnames of the files ending in ".maze"
+ */
+vector<string> ListMazeFiles(const string& directoryName) {
+    vector<string> fileNames;
+    DIR* dirp;
+    struct dirent * dp;
+
+    dirp = opendir(directoryName.c_str());
+    if (dirp == nullptr) {
+        return fileNames;
+    }
+    while ((dp = readdir(dirp)) != NULL) {
+        if (strlen(dp->d_name) >= 5 && strcmp(&dp->d_name[strlen(dp->d_name)-5], ".maze") == 0) {
+            fileNames.push_back(directoryName + dp->d_name);
+        }
+    }
+    closedir(dirp);
+    return fileNames;
 }
 
 /**  Tests solving one maze
  * @param fileName  pathname of maze file
  * @param fSolvable whether the maze file is solvable
+ * @param algorithm which solver to use, one of the names from Solver::Names()
  * @param testsPassed running total of number of tests passed, updated upon return
  * @param testsFailed running total of number of tests failed, updated upon return
  */
-void TestMaze(const string& fileName, bool fSolvable, unsigned& testsPassed, unsigned& testsFailed) {
+void TestMaze(const string& fileName, bool fSolvable, const string& algorithm, unsigned& testsPassed, unsigned& testsFailed) {
     ifstream ifs;
     stack<GridLocation> solution;
+    SolveStats stats;
+    string suffix = (algorithm == "bfs") ? "" : " with " + algorithm;
     Grid maze;
     string message;
     bool success = true;
@@ -204,40 +684,40 @@ void TestMaze(const string& fileName, bool fSolvable, unsigned& testsPassed, uns
         Test(false, message.c_str(), testsPassed, testsFailed  );
         success = false;
     }
-    else if (!maze.LoadFromFile(ifs)) {
+    ifs.close();
+    if (success && !maze.LoadFromPath(fileName)) {
         message = "Load from '" + fileName + "' failed";
         Test(false, message.c_str(), testsPassed, testsFailed  );
         success = false;
     }
-    ifs.close();
 
     // Display maze and solve
     if (success) {
-        if (SolveMaze(maze, solution, nullptr)) {
+        if (RunSolver(algorithm, maze, solution, nullptr, stats)) {
             bool correct;
 
             if (!fSolvable) {
-                message = "Maze '" + fileName + "' is unsolvable, but solution found";
+                message = "Maze '" + fileName + "' is unsolvable, but solution found" + suffix;
                 Test(false, message.c_str(), testsPassed, testsFailed  );
             }
             else {
                 correct = CheckSolution(maze, solution);
                 if (correct) {
-                    message = "Maze '" + fileName + "' correctly solved";
+                    message = "Maze '" + fileName + "' correctly solved" + suffix;
                     Test(true, message.c_str(), testsPassed, testsFailed);
                 }
                 else {
-                    message = "Incorrect solution to  maze '" + fileName + "'";
+                    message = "Incorrect solution to  maze '" + fileName + "'" + suffix;
                     Test(false, message.c_str(), testsPassed, testsFailed);
                 }
             }
         }
         else if (fSolvable) {
-            message = "Solution not found to  maze '" + fileName + "'";
+            message = "Solution not found to  maze '" + fileName + "'" + suffix;
             Test(false, message.c_str(), testsPassed, testsFailed);
         }
         else {
-            message = "As expected, solution not found to maze '" + fileName + "'";
+            message = "As expected, solution not found to maze '" + fileName + "'" + suffix;
             Test(true, message.c_str(), testsPassed, testsFailed);
         }
     }
@@ -249,33 +729,1091 @@ void TestMaze(const string& fileName, bool fSolvable, unsigned& testsPassed, uns
  * @param testsFailed running total of number of tests failed, updated upon return
  */
 void TestSolve(unsigned& testsPassed, unsigned& testsFailed) {
-    DIR* dirp;
-    struct dirent * dp;
-    string directoryName;
+    vector<string> algorithms = Solver::Names();
 
-    // Check the solvable mazes
-    directoryName = "../solvable/";
-    dirp = opendir(directoryName.c_str());
-    while ((dp = readdir(dirp)) != NULL) {
-        if (strlen(dp->d_name) >= 5 && strcmp(&dp->d_name[strlen(dp->d_name)-5], ".maze") == 0) {
-            string fileName = directoryName + dp->d_name;
+    for (const string& algorithm : algorithms) {
+        // Check the solvable mazes
+        for (const string& fileName : ListMazeFiles("../solvable/")) {
+            TestMaze(fileName,true,algorithm,testsPassed, testsFailed);
+        }
 
-            TestMaze(fileName,true,testsPassed, testsFailed);
+        // Check the unsolvable mazes
+        for (const string& fileName : ListMazeFiles("../unsolvable/")) {
+            TestMaze(fileName,false,algorithm,testsPassed, testsFailed);
         }
     }
-    closedir(dirp);
 
-    // Check the unsolvable mazes
-    directoryName = "../unsolvable/";
-    dirp = opendir(directoryName.c_str());
-    while ((dp = readdir(dirp)) != NULL) {
-        if (strlen(dp->d_name) >= 5 && strcmp(&dp->d_name[strlen(dp->d_name)-5], ".maze") == 0) {
-            string fileName = directoryName + dp->d_name;
+    // Breadth first search finds shortest paths; the other solvers must match its lengths
+    unsigned seed = 777;
+    bool sameLength = true;
+    for (unsigned trial = 0; trial < 200; trial++) {
+        Grid random;
+        stack<GridLocation> shortest;
+        SolveStats stats;
+
+        random.Configure(2 + trial % 31, 2 + (trial * 11) % 47);
+        for (size_t row = 0; row < random.NumberRows(); row++) {
+            for (size_t col = 0; col < random.NumberCols(); col++) {
+                seed = seed * 1103515245 + 12345;
+                random[GridLocation(row, col)] = (seed >> 16) % 100 < 70;
+            }
+        }
+        bool found = RunSolver("bfs", random, shortest, nullptr, stats);
+        for (size_t i = 1; i < algorithms.size(); i++) {
+            stack<GridLocation> solution;
 
-            TestMaze(fileName,false,testsPassed, testsFailed);
+            if (RunSolver(algorithms[i], random, solution, nullptr, stats) != found
+                || (found && (solution.size() != shortest.size() || !CheckSolution(random, solution)))) {
+                sameLength = false;
+            }
+        }
+
+        // The same, between two arbitrary cells
+        GridLocation start((seed >> 8) % random.NumberRows(), (seed >> 12) % random.NumberCols());
+        GridLocation goal((seed >> 16) % random.NumberRows(), (seed >> 20) % random.NumberCols());
+        BfsSolver bfs;
+        found = bfs.Solve(random, start, goal, shortest, nullptr);
+        for (size_t i = 1; i < algorithms.size(); i++) {
+            stack<GridLocation> solution;
+
+            if (Solver::Create(algorithms[i])->Solve(random, start, goal, solution, nullptr) != found
+                || (found && (solution.size() != shortest.size() || !(solution.top() == goal)))) {
+                sameLength = false;
+            }
         }
     }
-    closedir(dirp);
+    Test(sameLength, "Test all solvers find shortest paths on random grids", testsPassed, testsFailed);
+
+    // The parallel search only goes parallel on big grids and levels; force it to on small ones
+    ParallelBfsSolver parallel(4, 0, 1);
+    sameLength = true;
+    for (unsigned trial = 0; trial < 100; trial++) {
+        Grid random;
+        stack<GridLocation> shortest;
+        stack<GridLocation> solution;
+
+        random.Configure(2 + (trial * 7) % 97, 2 + (trial * 13) % 89);
+        for (size_t row = 0; row < random.NumberRows(); row++) {
+            for (size_t col = 0; col < random.NumberCols(); col++) {
+                seed = seed * 1103515245 + 12345;
+                random[GridLocation(row, col)] = (seed >> 16) % 100 < 75;
+            }
+        }
+        bool found = SolveMaze(random, shortest);
+        if (SolveMaze(random, solution, parallel) != found
+            || (found && (solution.size() != shortest.size() || !CheckSolution(random, solution)))) {
+            sameLength = false;
+        }
+    }
+    Test(sameLength, "Test parallel search finds shortest paths across threads", testsPassed, testsFailed);
+
+    // An open floor with a few walls, crossed corner to corner: the frontier
+    // stays small next to what is left of the floor, which favors top down,
+    // until it nears the far corner, which favors bottom up
+    Grid floor;
+    GridLocation start(0, 0);
+    GridLocation goal(399, 399);
+    stack<GridLocation> shortest;
+    stack<GridLocation> solution;
+    SolveStats stats;
+    BfsSolver bfs;
+    DirectionOptimizingSolver directionOptimizing;
+    floor.Configure(400, 400);
+    for (size_t row = 0; row < floor.NumberRows(); row++) {
+        for (size_t col = 0; col < floor.NumberCols(); col++) {
+            seed = seed * 1103515245 + 12345;
+            floor[GridLocation(row, col)] = (seed >> 16) % 100 < 85;
+        }
+    }
+    floor[start] = true;
+    floor[goal] = true;
+    bool found = bfs.Solve(floor, start, goal, shortest, nullptr);
+    Test(found && directionOptimizing.Solve(floor, start, goal, solution, &stats) && solution.size() == shortest.size(),
+         "Test direction optimizing search across an open floor", testsPassed, testsFailed);
+    Test(stats.levelModes.find('T') != string::npos && stats.levelModes.find('B') != string::npos,
+         "Test direction optimizing search goes both ways on an open floor", testsPassed, testsFailed);
+
+    // The same sort of floor in a room, left by a corridor from its far corner:
+    // the search turns bottom up as it sweeps the last of the room, then back
+    // top down along the corridor, where the frontier is a single cell
+    shortest = stack<GridLocation>();
+    solution = stack<GridLocation>();
+    start = GridLocation(0, 0);
+    goal = GridLocation(199, 299);
+    floor.Configure(200, 300);
+    for (size_t row = 0; row < floor.NumberRows(); row++) {
+        for (size_t col = 0; col < floor.NumberCols(); col++) {
+            seed = seed * 1103515245 + 12345;
+            floor[GridLocation(row, col)] = (col < 200) ? (seed >> 16) % 100 < 85 : row == 199;
+        }
+    }
+    floor[start] = true;
+    floor[GridLocation(199, 199)] = true;
+    found = bfs.Solve(floor, start, goal, shortest, nullptr);
+    Test(found && directionOptimizing.Solve(floor, start, goal, solution, &stats) && solution.size() == shortest.size(),
+         "Test direction optimizing search across a room and a corridor", testsPassed, testsFailed);
+    Test(stats.levelModes.find("TB") != string::npos && stats.levelModes.find("BT") != string::npos,
+         "Test direction optimizing search switches both ways", testsPassed, testsFailed);
+
+    // Junction graphs: corridors contract to edges, and a saved graph only loads
+    // for the maze, start and goal it was built from
+    Grid corridors;
+    stack<GridLocation> expected;
+    size_t openCells = 0;
+    corridors.LoadFromPath("../solvable/13x39.maze");
+    SolveMaze(corridors, expected);
+    for (size_t row = 0; row < corridors.NumberRows(); row++) {
+        for (size_t col = 0; col < corridors.NumberCols(); col++) {
+            openCells += corridors[GridLocation(row, col)];
+        }
+    }
+    GridLocation corner(0, 0);
+    GridLocation farCorner(corridors.NumberRows() - 1, corridors.NumberCols() - 1);
+    JunctionGraph graph;
+    graph.Build(corridors, corner, farCorner);
+    Test(graph.NumberNodes() > 2 && graph.NumberNodes() < openCells / 2, "Test junction graph is smaller than the maze", testsPassed, testsFailed);
+
+    const char* tempName = "junction-test.tmp";
+    JunctionGraph loaded;
+    Test(graph.Save(tempName) && loaded.Load(tempName, corridors, corner, farCorner)
+         && loaded.NumberNodes() == graph.NumberNodes() && loaded.NumberEdges() == graph.NumberEdges(),
+         "Test junction graph save and load", testsPassed, testsFailed);
+    Test(loaded.Solve(corridors, solution, &stats) && CheckSolution(corridors, solution) && solution.size() == expected.size(),
+         "Test solving with a loaded junction graph", testsPassed, testsFailed);
+    Grid changed = corridors;
+    changed[GridLocation(1, 1)] = !changed[GridLocation(1, 1)];
+    Test(!loaded.Load(tempName, corridors, corner, GridLocation(0, 1)) && !loaded.Load(tempName, changed, corner, farCorner),
+         "Test junction graph cache rejected for another goal or maze", testsPassed, testsFailed);
+
+    // Corrupt a node's cell, then an edge's length: the fingerprint still matches,
+    // but walking the corridors on load catches both
+    fstream cache(tempName, fstream::in | fstream::out | fstream::binary);
+    cache.seekg(0, fstream::end);
+    size_t nodes = graph.NumberNodes();
+    size_t edges = graph.NumberEdges();
+    size_t headerSize = (size_t) cache.tellg() - (8 * nodes + 4 + 9 * edges);
+    size_t lengthOffset = headerSize + 8 * nodes + 4 + 4 * edges;
+    uint32_t original;
+    uint32_t corrupt = UINT32_MAX - 1;
+    cache.seekg(headerSize);
+    cache.read((char*) &original, sizeof(original));
+    cache.seekp(headerSize);
+    cache.write((const char*) &corrupt, sizeof(corrupt));
+    cache.flush();
+    bool rejected = !loaded.Load(tempName, corridors, corner, farCorner);
+    cache.seekp(headerSize);
+    cache.write((const char*) &original, sizeof(original));
+    cache.seekg(lengthOffset);
+    cache.read((char*) &original, sizeof(original));
+    corrupt = original + 1;
+    cache.seekp(lengthOffset);
+    cache.write((const char*) &corrupt, sizeof(corrupt));
+    cache.flush();
+    rejected = rejected && !loaded.Load(tempName, corridors, corner, farCorner);
+    cache.seekp(lengthOffset);
+    cache.write((const char*) &original, sizeof(original));
+    cache.close();
+    Test(rejected && loaded.Load(tempName, corridors, corner, farCorner),
+         "Test corrupt junction graph cache rejected", testsPassed, testsFailed);
+    Test(truncate(tempName, 100) == 0 && !loaded.Load(tempName, corridors, corner, farCorner)
+         && loaded.Solve(corridors, solution, nullptr) && solution.size() == expected.size(),
+         "Test truncated junction graph cache rejected", testsPassed, testsFailed);
+    remove(tempName);
+
+    // Dead-end filling: on a maze without loops only the route is left open, and
+    // every solver gives the same length after filling
+    for (const string& fileName : ListMazeFiles("../solvable/")) {
+        Grid maze;
+        Grid filled;
+        stack<GridLocation> shortest;
+        size_t openCells = 0;
+        size_t links = 0;
+
+        maze.LoadFromPath(fileName);
+        SolveMaze(maze, shortest);
+        for (size_t row = 0; row < maze.NumberRows(); row++) {
+            for (size_t col = 0; col < maze.NumberCols(); col++) {
+                if (maze[GridLocation(row, col)]) {
+                    openCells++;
+                    links += (col + 1 < maze.NumberCols() && maze[GridLocation(row, col + 1)])
+                             + (row + 1 < maze.NumberRows() && maze[GridLocation(row + 1, col)]);
+                }
+            }
+        }
+        string message;
+        filled = maze;
+        size_t pruned = FillDeadEnds(filled, GridLocation(0, 0), GridLocation(maze.NumberRows() - 1, maze.NumberCols() - 1));
+        bool perfect = (links + 1 == openCells);
+        message = "Dead-end filling leaves " + string(perfect ? "only the route" : "the route") + " in '" + fileName + "'";
+        Test(SolveMaze(filled, solution) && solution.size() == shortest.size()
+             && (!perfect || openCells - pruned == shortest.size()), message.c_str(), testsPassed, testsFailed);
+
+        bool agree = true;
+        for (const string& algorithm : algorithms) {
+            unique_ptr<Solver> solver = Solver::Create("fill+" + algorithm);
+
+            stats = SolveStats();
+            agree = agree && solver && string(solver->Name()) == "fill+" + algorithm
+                    && SolveMaze(maze, solution, *solver, &stats) && CheckSolution(maze, solution)
+                    && solution.size() == shortest.size() && stats.cellsPruned == pruned;
+        }
+        message = "Every solver after dead-end filling on '" + fileName + "'";
+        Test(agree, message.c_str(), testsPassed, testsFailed);
+    }
+}
+
+/**
+ * Performs tests on the BatchRunner class, over the maze directories
+ * @param testsPassed running total of number of tests passed, updated upon return
+ * @param testsFailed running total of number of tests failed, updated upon return
+ */
+void TestBatch(unsigned& testsPassed, unsigned& testsFailed) {
+    vector<string> solvable = ListMazeFiles("../solvable/");
+    vector<string> unsolvable = ListMazeFiles("../unsolvable/");
+    vector<string> fileNames = solvable;
+
+    fileNames.insert(fileNames.end(), unsolvable.begin(), unsolvable.end());
+    fileNames.push_back("../solvable/no-such-file.maze");
+
+    for (unsigned nThreads : { 1u, 3u, 8u }) {
+        BatchRunner runner("bfs", nThreads);
+        stringstream out;
+        BatchSummary summary = runner.Run(fileNames, out);
+        string line;
+        size_t lines = 0;
+        bool allListed = true;
+
+        while (std::getline(out, line)) {
+            lines++;
+        }
+        for (const string& fileName : fileNames) {
+            if (out.str().find(fileName + "\t") == string::npos) {
+                allListed = false;
+            }
+        }
+        string suffix = " with " + std::to_string(nThreads) + " threads";
+        Test(summary.mazes == fileNames.size() && lines == fileNames.size() && allListed,
+             ("Test batch writes one line per maze" + suffix).c_str(), testsPassed, testsFailed);
+        Test(summary.solved == solvable.size() && summary.unsolvable == unsolvable.size() && summary.errors == 1,
+             ("Test batch totals" + suffix).c_str(), testsPassed, testsFailed);
+    }
+
+    // More workers than files leaves some with nothing of their own to start on
+    BatchRunner runner("astar", 16);
+    stringstream out;
+    BatchSummary summary = runner.Run(solvable, out);
+    Test(summary.solved == solvable.size(), "Test batch with more workers than mazes", testsPassed, testsFailed);
+}
+
+/**
+ * Performs tests on the ConnectivityIndex class and the SolveMaze overloads that
+ * consult it, against the maze directories and against BFS on generated grids
+ * @param testsPassed running total of number of tests passed, updated upon return
+ * @param testsFailed running total of number of tests failed, updated upon return
+ */
+void TestConnectivityIndex(unsigned& testsPassed, unsigned& testsFailed) {
+    const char* directories[] = { "../solvable/", "../unsolvable/" };
+    string message;
+
+    for (size_t i = 0; i < 2; i++) {
+        for (const string& fileName : ListMazeFiles(directories[i])) {
+            Grid maze;
+            bool loaded = maze.LoadFromPath(fileName);
+            ConnectivityIndex index(maze);
+
+            message = "Connected corners of '" + fileName + "'";
+            Test(loaded && index.Connected(GridLocation(0, 0), GridLocation(maze.NumberRows() - 1, maze.NumberCols() - 1)) == (i == 0),
+                 message.c_str(), testsPassed, testsFailed);
+        }
+    }
+
+    // Two pockets and a U: the arms of the U are separate components until the
+    // bottom row joins them
+    Grid grid(GridStorage::Bits);
+    stringstream text("5 5\n-@-@-\n-@-@@\n-@-@-\n-@-@-\n---@-\n");
+    grid.LoadFromFile(text);
+    ConnectivityIndex index(grid);
+    Test(index.NumberComponents() == 3, "Test number of components", testsPassed, testsFailed);
+    Test(index.Connected(GridLocation(0, 0), GridLocation(0, 2)) && index.Connected(GridLocation(0, 2), GridLocation(4, 1)),
+         "Test U joined at the bottom", testsPassed, testsFailed);
+    Test(!index.Connected(GridLocation(0, 0), GridLocation(0, 4)) && !index.Connected(GridLocation(0, 4), GridLocation(2, 4)),
+         "Test separate components", testsPassed, testsFailed);
+    Test(index.Component(GridLocation(0, 1)) == ConnectivityIndex::NO_COMPONENT
+         && index.Component(GridLocation(5, 0)) == ConnectivityIndex::NO_COMPONENT
+         && !index.Connected(GridLocation(0, 1), GridLocation(0, 1)),
+         "Test walls and outside the grid have no component", testsPassed, testsFailed);
+
+    stack<GridLocation> solution;
+    SolveStats stats = SolveStats();
+    stats.cellsExpanded = 99;
+    Test(!SolveMaze(grid, index, GridLocation(0, 0), GridLocation(4, 4), solution, &stats) && stats.cellsExpanded == 0,
+         "Test unreachable goal never starts a search", testsPassed, testsFailed);
+    Test(SolveMaze(grid, index, GridLocation(4, 2), GridLocation(0, 0), solution, &stats)
+         && solution.size() == 7 && solution.top() == GridLocation(0, 0),
+         "Test route between arbitrary cells", testsPassed, testsFailed);
+
+    // Random grids, with rows wider than a word: every pair of cells agrees with BFS
+    unsigned seed = 777;
+    bool agree = true;
+    for (unsigned trial = 0; trial < 100 && agree; trial++) {
+        Grid random(trial % 2 ? GridStorage::Bits : GridStorage::Bytes);
+        random.Configure(3 + trial % 17, 2 + (trial * 13) % 150);
+        for (size_t row = 0; row < random.NumberRows(); row++) {
+            for (size_t col = 0; col < random.NumberCols(); col++) {
+                seed = seed * 1103515245 + 12345;
+                random[GridLocation(row, col)] = (seed >> 16) % 100 < 60;
+            }
+        }
+        ConnectivityIndex randomIndex(random);
+        BfsSolver bfs;
+        for (unsigned pair = 0; pair < 20; pair++) {
+            stack<GridLocation> route;
+            seed = seed * 1103515245 + 12345;
+            GridLocation a((seed >> 8) % random.NumberRows(), (seed >> 16) % random.NumberCols());
+            seed = seed * 1103515245 + 12345;
+            GridLocation b((seed >> 8) % random.NumberRows(), (seed >> 16) % random.NumberCols());
+            bool found = random[a] && random[b] && bfs.Solve(random, a, b, route, nullptr);
+
+            agree = agree && randomIndex.Connected(a, b) == found
+                    && SolveMaze(random, randomIndex, a, b, route) == found;
+        }
+    }
+    Test(agree, "Test agreement with BFS between random cells", testsPassed, testsFailed);
+}
+
+/**
+ * Performs tests on ComputeDistanceField and SaveDistanceField, against the
+ * routes SolveMaze and BfsSolver find
+ * @param testsPassed running total of number of tests passed, updated upon return
+ * @param testsFailed running total of number of tests failed, updated upon return
+ */
+void TestDistanceField(unsigned& testsPassed, unsigned& testsFailed) {
+    const char* directories[] = { "../solvable/", "../unsolvable/" };
+    string message;
+
+    for (size_t i = 0; i < 2; i++) {
+        for (const string& fileName : ListMazeFiles(directories[i])) {
+            Grid maze;
+            stack<GridLocation> solution;
+
+            maze.LoadFromPath(fileName);
+            vector<uint32_t> distance = ComputeDistanceField(maze, GridLocation(0, 0));
+            uint32_t toGoal = distance.back();
+            bool found = SolveMaze(maze, solution);
+
+            message = "Distance to the goal of '" + fileName + "'";
+            Test(distance.size() == maze.NumberRows() * maze.NumberCols()
+                 && (found ? toGoal == solution.size() - 1 : toGoal == UNREACHABLE), message.c_str(), testsPassed, testsFailed);
+        }
+    }
+
+    Grid grid;
+    stringstream text("3 4\n--@-\n@-@-\n----\n");
+    grid.LoadFromFile(text);
+    vector<uint32_t> expected = { 0, 1, UNREACHABLE, 7,
+                                  UNREACHABLE, 2, UNREACHABLE, 6,
+                                  4, 3, 4, 5 };
+    Test(ComputeDistanceField(grid, GridLocation(0, 0)) == expected, "Test distances around a wall", testsPassed, testsFailed);
+    vector<uint32_t> fromWall = ComputeDistanceField(grid, GridLocation(0, 2));
+    vector<uint32_t> fromOutside = ComputeDistanceField(grid, GridLocation(3, 0));
+    Test(fromWall == vector<uint32_t>(12, UNREACHABLE) && fromOutside == fromWall,
+         "Test source a wall or outside the grid", testsPassed, testsFailed);
+
+    // Random grids: the distance to a cell is the length of BfsSolver's route to it
+    unsigned seed = 31337;
+    bool agree = true;
+    for (unsigned trial = 0; trial < 40 && agree; trial++) {
+        Grid random(trial % 2 ? GridStorage::Bits : GridStorage::Bytes);
+        BfsSolver bfs;
+
+        random.Configure(3 + trial % 21, 2 + (trial * 17) % 120);
+        for (size_t row = 0; row < random.NumberRows(); row++) {
+            for (size_t col = 0; col < random.NumberCols(); col++) {
+                seed = seed * 1103515245 + 12345;
+                random[GridLocation(row, col)] = (seed >> 16) % 100 < 65;
+            }
+        }
+        seed = seed * 1103515245 + 12345;
+        GridLocation source((seed >> 8) % random.NumberRows(), (seed >> 16) % random.NumberCols());
+        vector<uint32_t> distance = ComputeDistanceField(random, source);
+        for (size_t row = 0; row < random.NumberRows(); row++) {
+            for (size_t col = 0; col < random.NumberCols(); col++) {
+                stack<GridLocation> route;
+                bool found = random[source] && random[GridLocation(row, col)]
+                             && bfs.Solve(random, source, GridLocation(row, col), route, nullptr);
+                uint32_t d = distance[row * random.NumberCols() + col];
+
+                agree = agree && (found ? d == route.size() - 1 : d == UNREACHABLE);
+            }
+        }
+    }
+    Test(agree, "Test agreement with BFS on random grids", testsPassed, testsFailed);
+
+    // The file holds a header and then the field as it is in memory
+    const char* tempName = "distance-test.tmp";
+    Test(SaveDistanceField(tempName, grid, GridLocation(0, 0), expected), "Test SaveDistanceField", testsPassed, testsFailed);
+    ifstream ifs(tempName, ifstream::in | ifstream::binary);
+    char header[64];
+    vector<uint32_t> saved(expected.size());
+    ifs.read(header, sizeof(header));
+    ifs.read((char*) saved.data(), saved.size() * sizeof(uint32_t));
+    bool complete = ifs.good() && ifs.peek() == EOF;
+    ifs.close();
+    uint64_t rows;
+    uint64_t cols;
+    memcpy(&rows, header + 16, sizeof(rows));
+    memcpy(&cols, header + 24, sizeof(cols));
+    Test(complete && memcmp(header, "MAZEDST", 8) == 0 && rows == 3 && cols == 4 && saved == expected,
+         "Test distance file contents", testsPassed, testsFailed);
+    remove(tempName);
+}
+
+/**
+ * Determine whether a route is a valid walk between two cells: every cell open
+ * and each step a move to a neighbor
+ * @param maze the maze
+ * @param route the route, start first
+ * @param start where it must begin
+ * @param goal where it must end
+ * @return true if valid
+ */
+bool IsValidRoute(const Grid& maze, const vector<GridLocation>& route, const GridLocation& start, const GridLocation& goal) {
+    if (route.empty() || !(route.front() == start) || !(route.back() == goal)) {
+        return false;
+    }
+    for (size_t i = 0; i < route.size(); i++) {
+        if (!maze.IsWithinGrid(route[i]) || !maze[route[i]]) {
+            return false;
+        }
+        if (i > 0) {
+            size_t rowStep = route[i].Row() > route[i-1].Row() ? route[i].Row() - route[i-1].Row() : route[i-1].Row() - route[i].Row();
+            size_t colStep = route[i].Col() > route[i-1].Col() ? route[i].Col() - route[i-1].Col() : route[i-1].Col() - route[i].Col();
+            if (rowStep + colStep != 1) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Performs tests on the MazeSolver class, against BfsSolver on the maze
+ * directories and on generated grids
+ * @param testsPassed running total of number of tests passed, updated upon return
+ * @param testsFailed running total of number of tests failed, updated upon return
+ */
+void TestMazeSolver(unsigned& testsPassed, unsigned& testsFailed) {
+    string message;
+
+    for (const string& fileName : ListMazeFiles("../solvable/")) {
+        Grid maze;
+        stack<GridLocation> expected;
+        stack<GridLocation> solution;
+
+        maze.LoadFromPath(fileName);
+        SolveMaze(maze, expected);
+        MazeSolver solver(maze);
+        message = "MazeSolver corner to corner on '" + fileName + "'";
+        Test(solver.Solve(GridLocation(0, 0), GridLocation(maze.NumberRows() - 1, maze.NumberCols() - 1), solution)
+             && CheckSolution(maze, solution) && solution.size() == expected.size(), message.c_str(), testsPassed, testsFailed);
+    }
+
+    Grid grid;
+    stringstream text("5 5\n-@-@-\n-@-@@\n-@-@-\n-@-@-\n---@-\n");
+    grid.LoadFromFile(text);
+    MazeSolver small(grid);
+    vector<GridLocation> route;
+    SolveStats stats = SolveStats();
+    Test(!small.Solve(GridLocation(0, 0), GridLocation(4, 4), route, &stats) && route.empty() && stats.cellsExpanded == 0,
+         "Test unreachable goal", testsPassed, testsFailed);
+    Test(small.Solve(GridLocation(2, 2), GridLocation(2, 2), route) && route.size() == 1,
+         "Test start is the goal", testsPassed, testsFailed);
+    Test(small.Solve(GridLocation(0, 2), GridLocation(0, 0), route) && route.size() == 11
+         && IsValidRoute(grid, route, GridLocation(0, 2), GridLocation(0, 0)),
+         "Test route around the U", testsPassed, testsFailed);
+    Test(!small.Solve(GridLocation(0, 1), GridLocation(0, 0), route) && !small.Solve(GridLocation(0, 0), GridLocation(9, 9), route),
+         "Test wall and outside the grid", testsPassed, testsFailed);
+
+    // Random grids: every query agrees with BfsSolver, one at a time and batched,
+    // with several queries sharing each start
+    unsigned seed = 4242;
+    bool agree = true;
+    bool batchAgrees = true;
+    for (unsigned trial = 0; trial < 60; trial++) {
+        Grid random(trial % 2 ? GridStorage::Bits : GridStorage::Bytes);
+        random.Configure(4 + trial % 19, 3 + (trial * 11) % 130);
+        for (size_t row = 0; row < random.NumberRows(); row++) {
+            for (size_t col = 0; col < random.NumberCols(); col++) {
+                seed = seed * 1103515245 + 12345;
+                random[GridLocation(row, col)] = (seed >> 16) % 100 < 65;
+            }
+        }
+
+        MazeSolver solver(random);
+        BfsSolver bfs;
+        vector<RouteQuery> queries;
+        vector<size_t> lengths;
+        for (unsigned i = 0; i < 30; i++) {
+            RouteQuery query;
+            stack<GridLocation> expected;
+
+            seed = seed * 1103515245 + 12345;
+            query.start = (i % 3 == 0 || queries.empty())
+                          ? GridLocation((seed >> 8) % random.NumberRows(), (seed >> 16) % random.NumberCols())
+                          : queries.back().start;
+            seed = seed * 1103515245 + 12345;
+            query.goal = GridLocation((seed >> 8) % random.NumberRows(), (seed >> 16) % random.NumberCols());
+            queries.push_back(query);
+
+            bool found = random[query.start] && random[query.goal] && bfs.Solve(random, query.start, query.goal, expected, nullptr);
+            lengths.push_back(found ? expected.size() : 0);
+            agree = agree && solver.Solve(query.start, query.goal, route) == found && route.size() == lengths.back()
+                    && (!found || IsValidRoute(random, route, query.start, query.goal));
+        }
+
+        vector<vector<GridLocation>> routes;
+        size_t nFound = solver.SolveMany(queries, routes);
+        size_t nExpected = 0;
+        for (size_t i = 0; i < queries.size(); i++) {
+            nExpected += (lengths[i] > 0);
+            batchAgrees = batchAgrees && routes[i].size() == lengths[i]
+                          && (lengths[i] == 0 || IsValidRoute(random, routes[i], queries[i].start, queries[i].goal));
+        }
+        batchAgrees = batchAgrees && nFound == nExpected;
+    }
+    Test(agree, "Test Solve agrees with BFS on random grids", testsPassed, testsFailed);
+    Test(batchAgrees, "Test SolveMany agrees with BFS on random grids", testsPassed, testsFailed);
+}
+
+/**
+ * Performs tests on the HierarchicalGraph class, against SolveMaze and BfsSolver
+ * on the maze directories and on generated grids
+ * @param testsPassed running total of number of tests passed, updated upon return
+ * @param testsFailed running total of number of tests failed, updated upon return
+ */
+void TestHierarchicalGraph(unsigned& testsPassed, unsigned& testsFailed) {
+    const char* directories[] = { "../solvable/", "../unsolvable/" };
+    string message;
+
+    // The corpus mazes have one cell wide corridors, so every entrance is one
+    // cell wide and the routes found are the shortest
+    for (size_t i = 0; i < 2; i++) {
+        for (const string& fileName : ListMazeFiles(directories[i])) {
+            Grid maze;
+            stack<GridLocation> expected;
+            stack<GridLocation> solution;
+
+            maze.LoadFromPath(fileName);
+            bool found = SolveMaze(maze, expected);
+            bool agree = true;
+            for (size_t clusterSize = 2; clusterSize <= 16; clusterSize *= 2) {
+                HierarchicalGraph graph(maze, clusterSize, 2);
+
+                agree = agree && graph.Solve(GridLocation(0, 0), GridLocation(maze.NumberRows() - 1, maze.NumberCols() - 1), solution) == found
+                        && (!found || (CheckSolution(maze, solution) && solution.size() == expected.size()));
+            }
+            message = "HierarchicalGraph corner to corner on '" + fileName + "'";
+            Test(agree, message.c_str(), testsPassed, testsFailed);
+        }
+    }
+
+    Grid grid;
+    stringstream text("5 5\n-@-@-\n-@-@@\n-@-@-\n-@-@-\n---@-\n");
+    grid.LoadFromFile(text);
+    HierarchicalGraph small(grid, 2);
+    vector<GridLocation> route;
+    SolveStats stats = SolveStats();
+    Test(small.NumberClusters() == 9 && small.NumberNodes() > 0 && small.NumberEdges() >= small.NumberNodes()
+         && small.MemoryBytes() > 0, "Test graph of a 5x5 grid in 2x2 clusters", testsPassed, testsFailed);
+    Test(!small.Solve(GridLocation(0, 0), GridLocation(4, 4), route, &stats) && route.empty() && stats.cellsExpanded == 0,
+         "Test unreachable goal", testsPassed, testsFailed);
+    Test(small.Solve(GridLocation(2, 2), GridLocation(2, 2), route) && route.size() == 1,
+         "Test start is the goal", testsPassed, testsFailed);
+    Test(small.Solve(GridLocation(0, 2), GridLocation(0, 0), route, &stats) && route.size() == 11 && stats.cellsExpanded > 0
+         && IsValidRoute(grid, route, GridLocation(0, 2), GridLocation(0, 0)),
+         "Test route around the U", testsPassed, testsFailed);
+    Test(!small.Solve(GridLocation(0, 1), GridLocation(0, 0), route) && !small.Solve(GridLocation(0, 0), GridLocation(9, 9), route),
+         "Test wall and outside the grid", testsPassed, testsFailed);
+
+    // Random grids: a route exactly when BfsSolver finds one, valid and never
+    // shorter than BFS's, and not much longer in total
+    unsigned seed = 2718;
+    bool agree = true;
+    size_t shortest = 0;
+    size_t total = 0;
+    for (unsigned trial = 0; trial < 60; trial++) {
+        Grid random(trial % 2 ? GridStorage::Bits : GridStorage::Bytes);
+        random.Configure(4 + (trial * 7) % 61, 3 + (trial * 11) % 130);
+        for (size_t row = 0; row < random.NumberRows(); row++) {
+            for (size_t col = 0; col < random.NumberCols(); col++) {
+                seed = seed * 1103515245 + 12345;
+                random[GridLocation(row, col)] = (seed >> 16) % 100 < 65;
+            }
+        }
+
+        HierarchicalGraph graph(random, 3 + trial % 14, 1 + trial % 3);
+        BfsSolver bfs;
+        for (unsigned i = 0; i < 30; i++) {
+            stack<GridLocation> expected;
+
+            seed = seed * 1103515245 + 12345;
+            GridLocation start((seed >> 8) % random.NumberRows(), (seed >> 16) % random.NumberCols());
+            seed = seed * 1103515245 + 12345;
+            GridLocation goal((seed >> 8) % random.NumberRows(), (seed >> 16) % random.NumberCols());
+
+            bool found = random[start] && random[goal] && bfs.Solve(random, start, goal, expected, nullptr);
+            agree = agree && graph.Solve(start, goal, route) == found
+                    && (!found || (IsValidRoute(random, route, start, goal) && route.size() >= expected.size()));
+            shortest += found ? expected.size() : 0;
+            total += found ? route.size() : 0;
+        }
+    }
+    Test(agree, "Test agreement with BFS on random grids", testsPassed, testsFailed);
+    Test(total < shortest + shortest / 10, "Test routes within 10% of the shortest overall", testsPassed, testsFailed);
+
+    // Small clusters on a larger grid, so routes cross several super clusters
+    // and get refined through the second level
+    Grid large;
+    large.Configure(180, 220);
+    for (size_t row = 0; row < large.NumberRows(); row++) {
+        for (size_t col = 0; col < large.NumberCols(); col++) {
+            seed = seed * 1103515245 + 12345;
+            large[GridLocation(row, col)] = (seed >> 16) % 100 < 70;
+        }
+    }
+    HierarchicalGraph layered(large, 3, 2);
+    BfsSolver bfs;
+    agree = layered.NumberLevelTwoNodes() > 0;
+    shortest = 0;
+    total = 0;
+    for (unsigned i = 0; i < 40; i++) {
+        stack<GridLocation> expected;
+
+        seed = seed * 1103515245 + 12345;
+        GridLocation start((seed >> 8) % large.NumberRows(), (seed >> 16) % large.NumberCols());
+        seed = seed * 1103515245 + 12345;
+        GridLocation goal((seed >> 8) % large.NumberRows(), (seed >> 16) % large.NumberCols());
+
+        bool found = large[start] && large[goal] && bfs.Solve(large, start, goal, expected, nullptr);
+        agree = agree && layered.Solve(start, goal, route) == found
+                && (!found || (IsValidRoute(large, route, start, goal) && route.size() >= expected.size()));
+        shortest += found ? expected.size() : 0;
+        total += found ? route.size() : 0;
+    }
+    Test(agree && shortest > 0 && total < shortest + shortest / 10,
+         "Test routes through the second level agree with BFS", testsPassed, testsFailed);
+}
+
+/**
+ * Performs tests on the DynamicSolver class: after each batch of changes its
+ * route must be as short as a fresh breadth first search finds
+ * @param testsPassed running total of number of tests passed, updated upon return
+ * @param testsFailed running total of number of tests failed, updated upon return
+ */
+void TestDynamicSolver(unsigned& testsPassed, unsigned& testsFailed) {
+    const char* directories[] = { "../solvable/", "../unsolvable/" };
+    string message;
+    unsigned seed = 8086;
+
+    // Each corpus maze as loaded, then with cells toggled one at a time
+    for (size_t i = 0; i < 2; i++) {
+        for (const string& fileName : ListMazeFiles(directories[i])) {
+            Grid maze;
+            stack<GridLocation> expected;
+            stack<GridLocation> solution;
+
+            maze.LoadFromPath(fileName);
+            GridLocation goal(maze.NumberRows() - 1, maze.NumberCols() - 1);
+            DynamicSolver solver(maze, GridLocation(0, 0), goal);
+            bool found = SolveMaze(maze, expected);
+            bool agree = solver.Solve(solution) == found && (!found || (CheckSolution(maze, solution) && solution.size() == expected.size()));
+            for (unsigned toggle = 0; toggle < 25 && agree; toggle++) {
+                seed = seed * 1103515245 + 12345;
+                GridLocation loc((seed >> 8) % maze.NumberRows(), (seed >> 16) % maze.NumberCols());
+
+                maze[loc] = !maze[loc];
+                solver.SetCell(loc, maze[loc]);
+                found = SolveMaze(maze, expected);
+                agree = solver.Solve(solution) == found && (!found || (CheckSolution(maze, solution) && solution.size() == expected.size()));
+            }
+            message = "DynamicSolver through 25 changes to '" + fileName + "'";
+            Test(agree, message.c_str(), testsPassed, testsFailed);
+        }
+    }
+
+    Grid grid;
+    stringstream text("5 5\n-@-@-\n-@-@@\n-@-@-\n-@-@-\n---@-\n");
+    grid.LoadFromFile(text);
+    DynamicSolver small(grid, GridLocation(0, 0), GridLocation(0, 2));
+    vector<GridLocation> route;
+    SolveStats stats = SolveStats();
+    Test(small.Solve(route, &stats) && route.size() == 11 && stats.cellsExpanded > 0
+         && IsValidRoute(grid, route, GridLocation(0, 0), GridLocation(0, 2)), "Test route around the U", testsPassed, testsFailed);
+    Test(small.Solve(route, &stats) && route.size() == 11 && stats.cellsExpanded == 0,
+         "Test solving again without changes does no work", testsPassed, testsFailed);
+    small.SetCell(GridLocation(0, 1), true);
+    Test(small.Solve(route) && route.size() == 3 && small.Maze()[GridLocation(0, 1)], "Test opening a shortcut", testsPassed, testsFailed);
+    small.SetCell(GridLocation(0, 1), false);
+    small.SetCell(GridLocation(4, 1), false);
+    Test(!small.Solve(route) && route.empty(), "Test walling off the only route", testsPassed, testsFailed);
+    small.SetCell(GridLocation(4, 1), true);
+    small.SetCell(GridLocation(0, 2), false);
+    Test(!small.Solve(route), "Test goal walled off", testsPassed, testsFailed);
+    small.SetCell(GridLocation(0, 2), true);
+    small.SetCell(GridLocation(0, 0), false);
+    Test(!small.Solve(route), "Test start walled off", testsPassed, testsFailed);
+    small.SetCell(GridLocation(0, 0), true);
+    Test(small.Solve(route) && route.size() == 11, "Test route restored", testsPassed, testsFailed);
+
+    // Random grids: batches of random changes, checked against BfsSolver after each
+    bool agree = true;
+    for (unsigned trial = 0; trial < 40 && agree; trial++) {
+        Grid random(trial % 2 ? GridStorage::Bits : GridStorage::Bytes);
+        random.Configure(3 + trial % 23, 2 + (trial * 13) % 90);
+        for (size_t row = 0; row < random.NumberRows(); row++) {
+            for (size_t col = 0; col < random.NumberCols(); col++) {
+                seed = seed * 1103515245 + 12345;
+                random[GridLocation(row, col)] = (seed >> 16) % 100 < 70;
+            }
+        }
+        seed = seed * 1103515245 + 12345;
+        GridLocation start((seed >> 8) % random.NumberRows(), (seed >> 16) % random.NumberCols());
+        seed = seed * 1103515245 + 12345;
+        GridLocation goal((seed >> 8) % random.NumberRows(), (seed >> 16) % random.NumberCols());
+
+        DynamicSolver solver(random, start, goal);
+        BfsSolver bfs;
+        for (unsigned round = 0; round < 30 && agree; round++) {
+            stack<GridLocation> expected;
+
+            for (unsigned change = 0; change <= round % 5; change++) {
+                seed = seed * 1103515245 + 12345;
+                GridLocation loc((seed >> 8) % random.NumberRows(), (seed >> 16) % random.NumberCols());
+
+                random[loc] = !random[loc];
+                solver.SetCell(loc, random[loc]);
+            }
+            bool found = random[start] && random[goal] && bfs.Solve(random, start, goal, expected, nullptr);
+            agree = solver.Solve(route) == found
+                    && (!found || (IsValidRoute(random, route, start, goal) && route.size() == expected.size()));
+        }
+    }
+    Test(agree, "Test agreement with BFS through random changes", testsPassed, testsFailed);
+}
+
+/**
+ * Performs tests on the SolverWorkspace class, and checks that breadth first
+ * searches stop allocating once their workspace has grown to fit
+ * @param testsPassed running total of number of tests passed, updated upon return
+ * @param testsFailed running total of number of tests failed, updated upon return
+ */
+void TestSolverWorkspace(unsigned& testsPassed, unsigned& testsFailed) {
+    SolverWorkspace arena;
+    Test(arena.Capacity() == 0 && arena.Used() == 0 && arena.BlocksAllocated() == 0, "Test empty workspace", testsPassed, testsFailed);
+
+    arena.Reserve(1000);
+    uint32_t* a = arena.Allocate<uint32_t>(10);
+    uint64_t* b = arena.Allocate<uint64_t>(3);
+    Test(arena.BlocksAllocated() == 1 && arena.Capacity() >= 1000 && (uintptr_t) a % 64 == 0 && (uintptr_t) b % 64 == 0
+         && (unsigned char*) b >= (unsigned char*) (a + 10) && arena.Used() == 128, "Test aligned pieces from one block", testsPassed, testsFailed);
+    arena.Reset();
+    Test(arena.Allocate<uint32_t>(10) == a && arena.Used() == 64 && arena.BlocksAllocated() == 1,
+         "Test Reset hands out the same memory again", testsPassed, testsFailed);
+
+    // Outgrowing the block costs allocations once; Reset folds them into one block
+    size_t capacity = arena.Capacity();
+    unsigned char* big = arena.Allocate<unsigned char>(capacity);
+    big[capacity - 1] = 1;
+    Test(arena.BlocksAllocated() == 2 && arena.Used() > capacity, "Test overflow block", testsPassed, testsFailed);
+    arena.Reset();
+    Test(arena.BlocksAllocated() == 3 && arena.Capacity() >= capacity + 64 && arena.Used() == 0, "Test Reset grows the block", testsPassed, testsFailed);
+    arena.Allocate<uint32_t>(10);
+    arena.Allocate<unsigned char>(capacity);
+    arena.Reset();
+    Test(arena.BlocksAllocated() == 3, "Test the same work again allocates nothing", testsPassed, testsFailed);
+
+    // Breadth first search over the corpus: once the workspace fits the biggest
+    // maze, a second pass over all of them allocates nothing, and the routes
+    // are the ones SolveMaze finds
+    const char* directories[] = { "../solvable/", "../unsolvable/" };
+    SolverWorkspace workspace;
+    BfsSolver bfs(nullptr, &workspace);
+    vector<GridLocation> route;
+    vector<Grid> mazes;
+    size_t firstPass = 0;
+    bool agree = true;
+    for (size_t i = 0; i < 2; i++) {
+        for (const string& fileName : ListMazeFiles(directories[i])) {
+            mazes.push_back(Grid());
+            mazes.back().LoadFromPath(fileName);
+        }
+    }
+    for (unsigned pass = 0; pass < 2; pass++) {
+        for (const Grid& maze : mazes) {
+            stack<GridLocation> expected;
+            GridLocation goal(maze.NumberRows() - 1, maze.NumberCols() - 1);
+            bool found = SolveMaze(maze, expected);
+
+            agree = agree && bfs.Solve(maze, GridLocation(0, 0), goal, route, nullptr) == found
+                    && route.size() == (found ? expected.size() : 0)
+                    && (!found || IsValidRoute(maze, route, GridLocation(0, 0), goal));
+        }
+        firstPass = (pass == 0) ? workspace.BlocksAllocated() : firstPass;
+    }
+    Test(agree, "Test routes from a shared workspace", testsPassed, testsFailed);
+    Test(firstPass > 0 && workspace.BlocksAllocated() == firstPass, "Test second pass over the corpus allocates no blocks",
+         testsPassed, testsFailed);
+
+    // With the workspace and the route vector grown to fit, solving again
+    // makes no heap allocation of any kind.  Only MazeSolverTests counts
+    // operator new; MazeSolver checks the workspace blocks alone.
+    size_t blocks = workspace.BlocksAllocated();
+    size_t solved = 0;
+#ifdef COUNT_HEAP_ALLOCATIONS
+    size_t allocations = heapAllocations;
+#endif
+    for (const Grid& maze : mazes) {
+        solved += bfs.Solve(maze, GridLocation(0, 0), GridLocation(maze.NumberRows() - 1, maze.NumberCols() - 1), route, nullptr);
+    }
+#ifdef COUNT_HEAP_ALLOCATIONS
+    Test(solved > 0 && heapAllocations == allocations && workspace.BlocksAllocated() == blocks,
+         "Test vector form Solve makes no heap allocation", testsPassed, testsFailed);
+#else
+    Test(solved > 0 && workspace.BlocksAllocated() == blocks,
+         "Test vector form Solve allocates no blocks", testsPassed, testsFailed);
+#endif
+
+    // SolveMaze's solvers share the calling thread's workspace
+    stack<GridLocation> solution;
+    SolveMaze(mazes[0], solution);
+    size_t before = SolverWorkspace::ForThisThread().BlocksAllocated();
+    for (unsigned i = 0; i < 10; i++) {
+        SolveMaze(mazes[0], solution);
+    }
+    Test(before > 0 && SolverWorkspace::ForThisThread().BlocksAllocated() == before, "Test repeated SolveMaze allocates no workspace blocks",
+         testsPassed, testsFailed);
+}
+
+/**
+ * Performs tests on CellHandle, CellLayout and BorderedGrid: conversions at
+ * compile time and run time, and moves that agree with GenerateValidMoves
+ * @param testsPassed running total of number of tests passed, updated upon return
+ * @param testsFailed running total of number of tests failed, updated upon return
+ */
+void TestCellHandles(unsigned& testsPassed, unsigned& testsFailed) {
+    constexpr CellLayout layout(3, 4);
+    static_assert(layout.ToHandle(GridLocation(0, 0)).Index() == 7, "first cell follows the top border and one side");
+    static_assert(layout.ToLocation(layout.ToHandle(GridLocation(2, 3))).Col() == 3, "round trip");
+    static_assert(layout.ToHandle(GridLocation(1, 2)) + layout.Offset(Direction::North) == layout.ToHandle(GridLocation(0, 2)),
+                  "north is one stride back");
+    Test(layout.Stride() == 6 && layout.NumberHandles() == 30 && sizeof(CellHandle) == 4, "Test layout sizes", testsPassed, testsFailed);
+
+    bool roundTrip = true;
+    bool offsets = true;
+    for (size_t row = 0; row < 3; row++) {
+        for (size_t col = 0; col < 4; col++) {
+            CellHandle cell = layout.ToHandle(GridLocation(row, col));
+
+            roundTrip = roundTrip && layout.ToLocation(cell) == GridLocation(row, col) && cell.Index() < layout.NumberHandles();
+            offsets = offsets && (row == 0 || cell + layout.Offset(Direction::North) == layout.ToHandle(GridLocation(row - 1, col)))
+                      && (col == 3 || cell + layout.Offset(Direction::East) == layout.ToHandle(GridLocation(row, col + 1)))
+                      && (row == 2 || cell + layout.Offset(Direction::South) == layout.ToHandle(GridLocation(row + 1, col)))
+                      && (col == 0 || cell + layout.Offset(Direction::West) == layout.ToHandle(GridLocation(row, col - 1)));
+        }
+    }
+    Test(roundTrip, "Test handles and locations round trip", testsPassed, testsFailed);
+    Test(offsets, "Test neighbor offsets", testsPassed, testsFailed);
+    Test(layout.AreAdjacent(layout.ToHandle(GridLocation(1, 1)), layout.ToHandle(GridLocation(2, 1)))
+         && layout.AreAdjacent(layout.ToHandle(GridLocation(1, 1)), layout.ToHandle(GridLocation(1, 0)))
+         && !layout.AreAdjacent(layout.ToHandle(GridLocation(0, 3)), layout.ToHandle(GridLocation(1, 0)))
+         && !layout.AreAdjacent(layout.ToHandle(GridLocation(0, 0)), layout.ToHandle(GridLocation(1, 1))),
+         "Test adjacency doesn't wrap between rows", testsPassed, testsFailed);
+
+    // A single open cell: the border walls it in on every side
+    Grid single;
+    single.Configure(1, 1);
+    single[GridLocation(0, 0)] = true;
+    vector<unsigned char> singleCells(CellLayout(1, 1).NumberHandles());
+    BorderedGrid bordered(single, singleCells.data());
+    CellHandle moves[4];
+    Test(bordered.IsOpen(bordered.Layout().ToHandle(GridLocation(0, 0)))
+         && bordered.ValidMoves(bordered.Layout().ToHandle(GridLocation(0, 0)), moves) == 0,
+         "Test border around a single cell", testsPassed, testsFailed);
+    bordered.Close(bordered.Layout().ToHandle(GridLocation(0, 0)));
+    Test(!bordered.IsOpen(bordered.Layout().ToHandle(GridLocation(0, 0))) && single[GridLocation(0, 0)],
+         "Test closing a cell leaves the maze alone", testsPassed, testsFailed);
+
+    // Random grids in both storage modes, some rows wider than a word: the
+    // bordered copy's moves are GenerateValidMoves', in the same order
+    unsigned seed = 4242;
+    bool agree = true;
+    for (unsigned trial = 0; trial < 60 && agree; trial++) {
+        Grid random(trial % 2 ? GridStorage::Bits : GridStorage::Bytes);
+        random.Configure(1 + trial % 13, 1 + (trial * 29) % 140);
+        for (size_t row = 0; row < random.NumberRows(); row++) {
+            for (size_t col = 0; col < random.NumberCols(); col++) {
+                seed = seed * 1103515245 + 12345;
+                random[GridLocation(row, col)] = (seed >> 16) % 100 < 60;
+            }
+        }
+        vector<unsigned char> cells(CellLayout(random.NumberRows(), random.NumberCols()).NumberHandles());
+        BorderedGrid grid(random, cells.data());
+        for (size_t row = 0; row < random.NumberRows(); row++) {
+            for (size_t col = 0; col < random.NumberCols(); col++) {
+                GridLocation loc(row, col);
+                CellHandle cell = grid.Layout().ToHandle(loc);
+                GridLocation expected[4];
+                size_t expectedCount = 0;
+                size_t count = grid.ValidMoves(cell, moves);
+
+                GenerateValidMoves(random, loc, expected, expectedCount);
+                agree = agree && grid.IsOpen(cell) == random[loc] && count == expectedCount;
+                for (size_t i = 0; i < count && agree; i++) {
+                    agree = grid.Layout().ToLocation(moves[i]) == expected[i];
+                }
+            }
+        }
+    }
+    Test(agree, "Test bordered moves match GenerateValidMoves", testsPassed, testsFailed);
+
+    // The solvers that search in handles still find the shortest routes
+    const char* directories[] = { "../solvable/", "../unsolvable/" };
+    unique_ptr<Solver> astar = Solver::Create("astar");
+    agree = true;
+    for (size_t i = 0; i < 2; i++) {
+        for (const string& fileName : ListMazeFiles(directories[i])) {
+            Grid maze;
+            stack<GridLocation> expected;
+            stack<GridLocation> solution;
+            SolveStats stats;
+
+            maze.LoadFromPath(fileName);
+            bool found = SolveMaze(maze, expected);
+            agree = agree && (i == 0) == found && (!found || CheckSolution(maze, expected))
+                    && SolveMaze(maze, solution, *astar, &stats) == found
+                    && (!found || (CheckSolution(maze, solution) && solution.size() == expected.size()));
+        }
+    }
+    Test(agree, "Test bfs and astar over handles on the corpus", testsPassed, testsFailed);
+}
+
+/**
+ * Performs tests on the IsSolvable function, against the maze directories and
+ * against SolveMaze on generated grids
+ * @param testsPassed running total of number of tests passed, updated upon return
+ * @param testsFailed running total of number of tests failed, updated upon return
+ */
+void TestIsSolvable(unsigned& testsPassed, unsigned& testsFailed) {
+    const char* directories[] = { "../solvable/", "../unsolvable/" };
+
+    for (size_t i = 0; i < 2; i++) {
+        for (const string& fileName : ListMazeFiles(directories[i])) {
+            Grid bytes;
+            Grid bits(GridStorage::Bits);
+            ifstream ifs;
+            string message;
+
+            ifs.open(fileName, ifstream::in);
+            bool loaded = bytes.LoadFromFile(ifs);
+            ifs.close();
+            ifs.open(fileName, ifstream::in);
+            loaded = bits.LoadFromFile(ifs) && loaded;
+            ifs.close();
+
+            message = "IsSolvable on '" + fileName + "'";
+            Test(loaded && IsSolvable(bytes) == (i == 0) && IsSolvable(bits) == (i == 0), message.c_str(), testsPassed, testsFailed);
+
+            stack<GridLocation> solution;
+            bool streamed;
+            ifs.open(fileName, ifstream::in);
+            loaded = IsSolvableStream(ifs, streamed);
+            ifs.close();
+            message = "IsSolvableStream agrees with SolveMaze on '" + fileName + "'";
+            Test(loaded && streamed == SolveMaze(bytes, solution), message.c_str(), testsPassed, testsFailed);
+        }
+    }
+
+    // A corridor that runs right along row 0, back left along row 2 and right
+    // again along row 4, crossing word boundaries in both directions
+    Grid grid;
+    grid.Configure(5, 150);
+    for (size_t col = 0; col < 150; col++) {
+        grid[GridLocation(0, col)] = true;
+        grid[GridLocation(2, col)] = true;
+        grid[GridLocation(4, col)] = true;
+    }
+    grid[GridLocation(3, 0)] = true;
+    Test(!IsSolvable(grid), "Test goal unreachable", testsPassed, testsFailed);
+    grid[GridLocation(1, 149)] = true;
+    Test(IsSolvable(grid), "Test corridor doubling back across word boundaries", testsPassed, testsFailed);
+    grid[GridLocation(2, 64)] = false;
+    Test(!IsSolvable(grid), "Test corridor blocked at a word boundary", testsPassed, testsFailed);
+    grid[GridLocation(2, 64)] = true;
+    grid[GridLocation(4, 149)] = false;
+    Test(!IsSolvable(grid), "Test goal is a wall", testsPassed, testsFailed);
+
+    // Vertical switchbacks: corridors down every other column, joined alternately
+    // at the bottom and the top, so the route turns back on every column
+    Grid switchbacks;
+    stack<GridLocation> route;
+    switchbacks.Configure(100, 150);
+    for (size_t col = 0; col < 150; col += 2) {
+        for (size_t row = 0; row < 100; row++) {
+            switchbacks[GridLocation(row, col)] = true;
+        }
+        if (col + 2 < 150) {
+            switchbacks[GridLocation((col / 2) % 2 == 0 ? 99 : 0, col + 1)] = true;
+        }
+    }
+    switchbacks[GridLocation(99, 149)] = true;
+    Test(IsSolvable(switchbacks) && SolveMaze(switchbacks, route), "Test vertical switchbacks", testsPassed, testsFailed);
+    switchbacks[GridLocation(0, 127)] = false;
+    Test(!IsSolvable(switchbacks), "Test vertical switchbacks cut near the end", testsPassed, testsFailed);
+
+    Grid single;
+    single.Configure(1, 1);
+    Test(!IsSolvable(single), "Test 1x1 wall", testsPassed, testsFailed);
+    single[GridLocation(0, 0)] = true;
+    Test(IsSolvable(single), "Test 1x1 corridor", testsPassed, testsFailed);
+
+    // Random grids, which have plenty of pockets and U-turns, must agree with SolveMaze
+    unsigned seed = 12345;
+    bool agree = true;
+    bool streamAgrees = true;
+    for (unsigned trial = 0; trial < 200; trial++) {
+        Grid random;
+        stack<GridLocation> solution;
+        stringstream text;
+        bool streamed;
+
+        random.Configure(5 + trial % 23, 3 + (trial * 7) % 140);
+        for (size_t row = 0; row < random.NumberRows(); row++) {
+            for (size_t col = 0; col < random.NumberCols(); col++) {
+                seed = seed * 1103515245 + 12345;
+                random[GridLocation(row, col)] = (seed >> 16) % 100 < 62;
+            }
+        }
+        random[GridLocation(0, 0)] = true;
+        random[GridLocation(random.NumberRows() - 1, random.NumberCols() - 1)] = true;
+        agree = agree && IsSolvable(random) == SolveMaze(random, solution);
+        text << random.NumberRows() << " " << random.NumberCols() << "\n" << random;
+        streamAgrees = streamAgrees && IsSolvableStream(text, streamed) && streamed == IsSolvable(random);
+    }
+    Test(agree, "Test agreement with SolveMaze on random grids", testsPassed, testsFailed);
+    Test(streamAgrees, "Test IsSolvableStream agrees on random grids", testsPassed, testsFailed);
+
+    // Streaming: a route that must climb back up past rows already read, since the
+    // two arms only meet at the bottom of the U
+    bool streamed;
+    stringstream uTurn("5 5\n-@---\n-@-@-\n-@-@-\n-@-@-\n---@-\n");
+    Test(IsSolvableStream(uTurn, streamed) && streamed, "Test IsSolvableStream through a U-turn", testsPassed, testsFailed);
+    stringstream closed("3 3\n-@-\n-@-\n-@-\n");
+    Test(IsSolvableStream(closed, streamed) && !streamed, "Test IsSolvableStream with a wall across", testsPassed, testsFailed);
+    stringstream shortRow("3 3\n---\n--\n---\n");
+    stringstream badChar("2 3\n---\n-x-\n");
+    stringstream missingRow("3 3\n---\n---\n");
+    Test(!IsSolvableStream(shortRow, streamed) && !IsSolvableStream(badChar, streamed) && !IsSolvableStream(missingRow, streamed),
+         "Test IsSolvableStream rejects malformed mazes", testsPassed, testsFailed);
 }
 
 
@@ -405,6 +1943,52 @@ void TestCheckSolution(unsigned& testsPassed, unsigned& testsFailed) {
     maze3[GridLocation(1,0)] = true;
     maze3[GridLocation(1,1)] = true;
     Test(!CheckSolution(maze3, path8), "Test upper left corner is wall", testsPassed, testsFailed  );
+
+    // The same routes as arrays, upper left corner first
+    vector<GridLocation> route1;
+    for (size_t col = 0; col < 7; col ++) {
+        route1.push_back(GridLocation(0, col));
+    }
+    for (size_t row = 1; row < 5; row ++) {
+        route1.push_back(GridLocation(row, 6));
+    }
+    Test(CheckSolution(maze1, route1.data(), route1.size()), "Test valid path as an array", testsPassed, testsFailed);
+    Test(CheckSolution(maze1, route1.data(), route1.size()) && CheckSolution(maze1, path1),
+         "Test checks leave nothing behind for the next", testsPassed, testsFailed);
+    Test(!CheckSolution(maze1, route1.data(), route1.size() - 1) && !CheckSolution(maze1, route1.data() + 1, route1.size() - 1)
+         && !CheckSolution(maze1, route1.data(), 0), "Test array missing an end", testsPassed, testsFailed);
+    route1.insert(route1.begin() + 3, GridLocation(0, 1));
+    Test(!CheckSolution(maze1, route1.data(), route1.size()), "Test array that jumps back", testsPassed, testsFailed);
+
+    // Optimality against a distance field from the upper left corner
+    Grid open;
+    open.Configure(3, 3);
+    for (size_t row = 0; row < 3; row++) {
+        for (size_t col = 0; col < 3; col++) {
+            open[GridLocation(row, col)] = true;
+        }
+    }
+    vector<uint32_t> distance = ComputeDistanceField(open, GridLocation(0, 0));
+    GridLocation shortest[] = { GridLocation(0,0), GridLocation(0,1), GridLocation(1,1), GridLocation(1,2), GridLocation(2,2) };
+    GridLocation detour[] = { GridLocation(0,0), GridLocation(1,0), GridLocation(1,1), GridLocation(0,1),
+                              GridLocation(0,2), GridLocation(1,2), GridLocation(2,2) };
+    Test(CheckSolution(open, shortest, 5, &distance) && CheckSolution(open, detour, 7) && !CheckSolution(open, detour, 7, &distance),
+         "Test optimality against a distance field", testsPassed, testsFailed);
+
+    // Every solver's routes on the corpus are shortest ones
+    bool optimal = true;
+    for (const string& fileName : ListMazeFiles("../solvable/")) {
+        Grid maze;
+        stack<GridLocation> solution;
+
+        maze.LoadFromPath(fileName);
+        vector<uint32_t> field = ComputeDistanceField(maze, GridLocation(0, 0));
+        for (const string& name : Solver::Names()) {
+            unique_ptr<Solver> solver = Solver::Create(name);
+            optimal = optimal && SolveMaze(maze, solution, *solver) && CheckSolution(maze, solution, &field);
+        }
+    }
+    Test(optimal, "Test corpus solutions are shortest", testsPassed, testsFailed);
 }
 
 /**
@@ -726,6 +2310,61 @@ void TestGenerateValidMoves(unsigned& testsPassed, unsigned& testsFailed) {
     count = 4;
     GenerateValidMoves(grid, GridLocation(1,1), moves, count);
     Test(CheckMoves(moves, count, GridLocation(1, 0)), "Test open middle", testsPassed, testsFailed  );
+
+    // Batches: one mask per cell, bit (1 << Direction) per valid move
+    GridLocation batch[3] = { GridLocation(1,1), GridLocation(0,0), GridLocation(2,3) };
+    unsigned char masks[3];
+    grid[GridLocation(1,3)] = true;
+    grid[GridLocation(2,2)] = true;
+    GenerateValidMoves(grid, batch, 3, masks);
+    Test(masks[0] == (1 << (int) Direction::West) && masks[1] == (1 << (int) Direction::South)
+         && masks[2] == ((1 << (int) Direction::North) | (1 << (int) Direction::West)),
+         "Test batch of masks", testsPassed, testsFailed);
+
+    // Random grids in both storage modes: batched masks, from the grid and from
+    // a bordered copy, agree with the moves listed one cell at a time
+    unsigned seed = 99;
+    bool agree = true;
+    bool borderedAgree = true;
+    for (unsigned trial = 0; trial < 40; trial++) {
+        Grid random(trial % 2 ? GridStorage::Bits : GridStorage::Bytes);
+        random.Configure(1 + trial % 11, 1 + (trial * 37) % 150);
+        for (size_t row = 0; row < random.NumberRows(); row++) {
+            for (size_t col = 0; col < random.NumberCols(); col++) {
+                seed = seed * 1103515245 + 12345;
+                random[GridLocation(row, col)] = (seed >> 16) % 100 < 55;
+            }
+        }
+        vector<GridLocation> cells;
+        vector<CellHandle> handles;
+        vector<unsigned char> bytes(CellLayout(random.NumberRows(), random.NumberCols()).NumberHandles());
+        BorderedGrid bordered(random, bytes.data());
+        for (size_t row = 0; row < random.NumberRows(); row++) {
+            for (size_t col = 0; col < random.NumberCols(); col++) {
+                cells.push_back(GridLocation(row, col));
+                handles.push_back(bordered.Layout().ToHandle(GridLocation(row, col)));
+            }
+        }
+        vector<unsigned char> cellMasks(cells.size());
+        vector<unsigned char> handleMasks(cells.size());
+        GenerateValidMoves(random, cells.data(), cells.size(), cellMasks.data());
+        bordered.MoveMasks(handles.data(), handles.size(), handleMasks.data());
+        for (size_t i = 0; i < cells.size(); i++) {
+            unsigned expected = 0;
+
+            GenerateValidMoves(random, cells[i], moves, count);
+            for (size_t m = 0; m < count; m++) {
+                Direction dir = moves[m].Row() < cells[i].Row() ? Direction::North
+                                : moves[m].Col() > cells[i].Col() ? Direction::East
+                                : moves[m].Row() > cells[i].Row() ? Direction::South : Direction::West;
+                expected |= 1 << (int) dir;
+            }
+            agree = agree && cellMasks[i] == expected;
+            borderedAgree = borderedAgree && handleMasks[i] == expected;
+        }
+    }
+    Test(agree, "Test batched masks match single cell moves", testsPassed, testsFailed);
+    Test(borderedAgree, "Test bordered masks match single cell moves", testsPassed, testsFailed);
 }
 
 /**
@@ -762,6 +2401,21 @@ void TestGridClass(unsigned& testsPassed, unsigned& testsFailed) {
     Test( !grid1[GridLocation(0,0)] && grid1[GridLocation(0,1)]
           && grid1[GridLocation(0,2)] && !grid1[GridLocation(0,3)], "Test [] (get) for non-empty grid", testsPassed, testsFailed);
 
+    Grid grid2(grid1);
+    Test( grid2.NumberRows() == 1 && grid2.NumberCols() == 4 && !grid2[GridLocation(0,0)] && grid2[GridLocation(0,1)]
+          && grid2[GridLocation(0,2)] && !grid2[GridLocation(0,3)], "Test copy constructor", testsPassed, testsFailed);
+    grid2[GridLocation(0,0)] = true;
+    Test( !grid1[GridLocation(0,0)], "Test copy is independent of original", testsPassed, testsFailed);
+    Grid grid3(std::move(grid2));
+    Test( grid3.NumberRows() == 1 && grid3.NumberCols() == 4 && grid3[GridLocation(0,0)]
+          && grid2.NumberRows() == 0 && grid2.NumberCols() == 0, "Test move constructor", testsPassed, testsFailed);
+    grid2 = std::move(grid3);
+    Test( grid2.NumberRows() == 1 && grid2[GridLocation(0,0)] && grid2[GridLocation(0,1)]
+          && grid3.NumberRows() == 0 && !grid3.IsWithinGrid(GridLocation(0,0)), "Test move assignment", testsPassed, testsFailed);
+    grid3 = grid2;
+    Test( grid3.NumberRows() == 1 && grid3.NumberCols() == 4 && grid3[GridLocation(0,0)] && !grid3[GridLocation(0,3)],
+          "Test copy assignment", testsPassed, testsFailed);
+
     ifs.open("../solvable/5x7.maze", ifstream::in);
     if (!ifs.good()) {
         Test( false, "Test loading ../solvable/5x7.maze - file open failed", testsPassed, testsFailed);
@@ -778,6 +2432,175 @@ void TestGridClass(unsigned& testsPassed, unsigned& testsFailed) {
                       "-----@-\n"
                       "-@@@-@-\n"
                       "-@---@-\n", "Test maze contents after load", testsPassed, testsFailed);
+
+    // Bit per cell storage
+    Grid bits(GridStorage::Bits);
+    bits.Configure(3, 70);
+    Test(bits.Storage() == GridStorage::Bits && bits.NumberRows() == 3 && bits.NumberCols() == 70
+         && bits.WordsPerRow() == 2 && !bits[GridLocation(1,63)] && !bits[GridLocation(2,69)], "Test Configure (bits)", testsPassed, testsFailed);
+    bits[GridLocation(1,63)] = true;
+    bits[GridLocation(1,64)] = true;
+    bits[GridLocation(0,64)] = true;
+    bits[GridLocation(2,0)] = true;
+    Test(bits[GridLocation(1,63)] && bits[GridLocation(1,64)] && bits[GridLocation(0,64)] && bits[GridLocation(2,0)]
+         && !bits[GridLocation(1,62)] && !bits[GridLocation(1,65)] && !bits[GridLocation(0,63)], "Test [] (bits)", testsPassed, testsFailed);
+    bits[GridLocation(2,0)] = bits[GridLocation(2,1)];
+    Test(!bits[GridLocation(2,0)], "Test [] assignment from another cell (bits)", testsPassed, testsFailed);
+    Test(bits.RowWord(1, 0) == uint64_t(1) << 63 && bits.RowWord(1, 1) == 1 && bits.RowWord(2, 1) == 0, "Test RowWord (bits)", testsPassed, testsFailed);
+    Test(bits.NeighborWord(1, 0, Direction::East) == uint64_t(3) << 62 && bits.NeighborWord(1, 1, Direction::West) == 3
+         && bits.NeighborWord(1, 1, Direction::North) == 1 && bits.NeighborWord(0, 1, Direction::North) == 0
+         && bits.NeighborWord(1, 0, Direction::South) == 0, "Test NeighborWord across word and grid edges", testsPassed, testsFailed);
+    Test(bits.OpenNeighborMask(1, 0, Direction::East) == uint64_t(1) << 63 && bits.OpenNeighborMask(1, 1, Direction::West) == 1
+         && bits.OpenNeighborMask(1, 1, Direction::North) == 1 && bits.OpenNeighborMask(1, 0, Direction::North) == 0,
+         "Test OpenNeighborMask", testsPassed, testsFailed);
+
+    ifs.close();
+    ifs.open("../solvable/5x7.maze", ifstream::in);
+    Test(bits.LoadFromFile(ifs) && bits.Storage() == GridStorage::Bits, "Test loading ../solvable/5x7.maze (bits)", testsPassed, testsFailed);
+    ifs.close();
+    stringstream bitsStream;
+    bitsStream << bits;
+    Test(bitsStream.str() == ss.str(), "Test maze contents after load (bits)", testsPassed, testsFailed);
+    bool sameWords = true;
+    for (size_t row = 0; row < bits.NumberRows(); row++) {
+        sameWords = sameWords && bits.RowWord(row, 0) == grid1.RowWord(row, 0)
+                    && bits.OpenNeighborMask(row, 0, Direction::South) == grid1.OpenNeighborMask(row, 0, Direction::South);
+    }
+    Test(sameWords && grid1.RowWord(0, 0) == 0x7F, "Test RowWord agrees for bytes and bits", testsPassed, testsFailed);
+
+    // Memory mapped loading, against the stream loader
+    Grid mapped;
+    Grid mappedBits(GridStorage::Bits);
+    stringstream mappedStream;
+    Test(mapped.LoadFromPath("../solvable/5x7.maze") && mappedBits.LoadFromPath("../solvable/5x7.maze"),
+         "Test LoadFromPath ../solvable/5x7.maze", testsPassed, testsFailed);
+    mappedStream << mapped << mappedBits;
+    Test(mappedStream.str() == ss.str() + ss.str(), "Test maze contents after LoadFromPath", testsPassed, testsFailed);
+    Test(!mapped.LoadFromPath("../solvable/no-such-file.maze"), "Test LoadFromPath of a missing file", testsPassed, testsFailed);
+
+    // Rows wide enough for the vector kernels plus a tail, in both storage modes
+    const char* tempName = "grid-test.tmp";
+    unsigned seed = 99;
+    ofstream ofs(tempName);
+    ofs << "3 150\n";
+    for (size_t row = 0; row < 3; row++) {
+        for (size_t col = 0; col < 150; col++) {
+            seed = seed * 1103515245 + 12345;
+            ofs << (((seed >> 16) & 1) ? '-' : '@');
+        }
+        ofs << (row == 1 ? "\r\n" : "\n");
+    }
+    ofs.close();
+    ifs.open(tempName, ifstream::in);
+    bool streamLoaded = grid1.LoadFromFile(ifs);
+    ifs.close();
+    Test(streamLoaded && mapped.LoadFromPath(tempName) && mappedBits.LoadFromPath(tempName),
+         "Test loading a wide maze with a CRLF row", testsPassed, testsFailed);
+    bool sameCells = mapped.NumberRows() == 3 && mapped.NumberCols() == 150 && mappedBits.NumberCols() == 150;
+    for (size_t row = 0; row < 3 && sameCells; row++) {
+        for (size_t w = 0; w < mapped.WordsPerRow(); w++) {
+            sameCells = sameCells && mapped.RowWord(row, w) == grid1.RowWord(row, w)
+                        && mappedBits.RowWord(row, w) == grid1.RowWord(row, w);
+        }
+    }
+    Test(sameCells, "Test LoadFromPath agrees with LoadFromFile", testsPassed, testsFailed);
+
+    // Malformed files are rejected
+    const char* malformed[] = { "2 3\n---\n--\n", "2 3\n---\n----\n", "2 3\n---\n-x-\n", "2 3\n---\n", "3\n---\n", "" };
+    bool allRejected = true;
+    for (const char* text : malformed) {
+        ofs.open(tempName);
+        ofs << text;
+        ofs.close();
+        allRejected = allRejected && !mapped.LoadFromPath(tempName);
+    }
+    Test(allRejected, "Test LoadFromPath rejects short, long, bad, missing rows and bad headers", testsPassed, testsFailed);
+    ofs.open(tempName);
+    ofs << "2 3\n---\n-@-";
+    ofs.close();
+    Test(mapped.LoadFromPath(tempName) && !mapped[GridLocation(1,1)] && mapped[GridLocation(1,2)],
+         "Test LoadFromPath without a final newline", testsPassed, testsFailed);
+
+    // Binary files, mapped straight into bit per cell storage
+    Grid reloaded;
+    grid1.LoadFromPath("../solvable/13x39.maze");
+    Test(grid1.SaveBinary(tempName) && reloaded.LoadFromPath(tempName, true)
+         && reloaded.Storage() == GridStorage::Bits && reloaded.NumberRows() == 13 && reloaded.NumberCols() == 39,
+         "Test SaveBinary then LoadFromPath", testsPassed, testsFailed);
+    stringstream original;
+    stringstream copy;
+    original << grid1;
+    copy << reloaded;
+    Test(copy.str() == original.str(), "Test maze contents after binary round trip", testsPassed, testsFailed);
+    reloaded[GridLocation(0,0)] = false;
+    Test(mapped.LoadFromPath(tempName, true) && mapped[GridLocation(0,0)] && !reloaded[GridLocation(0,0)],
+         "Test changing a mapped grid leaves its file alone", testsPassed, testsFailed);
+    Grid moved(std::move(reloaded));
+    reloaded = moved;
+    Test(!moved[GridLocation(0,0)] && !reloaded[GridLocation(0,0)] && reloaded.NumberCols() == 39,
+         "Test moving and copying a mapped grid", testsPassed, testsFailed);
+
+    // Damage the file: a flipped cell fails verification, a short file fails to load
+    FILE* file = fopen(tempName, "r+b");
+    fseek(file, 64, SEEK_SET);
+    fputc(0, file);
+    fclose(file);
+    Test(mapped.LoadFromPath(tempName) && !mapped.LoadFromPath(tempName, true),
+         "Test binary checksum catches a damaged row", testsPassed, testsFailed);
+    Test(truncate(tempName, 64 + 64 * 12) == 0 && !mapped.LoadFromPath(tempName),
+         "Test truncated binary file is rejected", testsPassed, testsFailed);
+
+    // Hand made headers: columns that would wrap the stride around, rows that
+    // would wrap the size around, and a 3x2 maze with open cells past its last
+    // column, which a good 3x2 file next to it shows is otherwise well formed
+    const uint64_t badShapes[][3] = { { 1, UINT64_MAX, 64 }, { 1, UINT64_MAX - 6, 0 }, { 1, (uint64_t) 1 << 62, 0 },
+                                      { ((uint64_t) 1 << 58) + 1, 64, 64 }, { 3, 2, 64 }, { 3, 2, 64 } };
+    bool rejected = true;
+    for (size_t i = 0; i < 6; i++) {
+        unsigned char bytes[64 + 3 * 64] = { 0 };
+        uint32_t version = 1;
+
+        memcpy(bytes, "MAZEBIN", 8);
+        memcpy(bytes + 8, &version, sizeof(version));
+        memcpy(bytes + 16, badShapes[i], sizeof(badShapes[i]));
+        for (size_t row = 0; row < 3; row++) {
+            bytes[64 + row * 64] = (i == 4) ? 0xFF : 0x03;
+        }
+        file = fopen(tempName, "wb");
+        fwrite(bytes, 1, (i == 0) ? 128 : sizeof(bytes), file);
+        fclose(file);
+        rejected = rejected && (i == 5 ? mapped.LoadFromPath(tempName) && mapped.NumberCols() == 2
+                                       : !mapped.LoadFromPath(tempName));
+    }
+    Test(rejected, "Test binary headers that overflow and rows with open padding are rejected", testsPassed, testsFailed);
+    remove(tempName);
+}
+
+/**
+ * Test the implementation of the VisitedSet class.
+ * @param testsPassed running total of number of tests passed, updated upon return
+ * @param testsFailed running total of number of tests failed, updated upon return
+ */
+void TestVisitedSetClass(unsigned& testsPassed, unsigned& testsFailed) {
+    VisitedSet empty;
+    VisitedSet visited(130);
+
+    Test(empty.Capacity() == 0 && empty.Count() == 0, "Test default constructor", testsPassed, testsFailed);
+    Test(visited.Capacity() == 130 && visited.Count() == 0, "Test sized constructor", testsPassed, testsFailed);
+    Test(!visited.Contains(0) && !visited.Contains(63) && !visited.Contains(64) && !visited.Contains(129),
+         "Test Contains for empty set", testsPassed, testsFailed);
+    Test(visited.Insert(0) && visited.Insert(63) && visited.Insert(64) && visited.Insert(129),
+         "Test Insert of new cells", testsPassed, testsFailed);
+    Test(!visited.Insert(63) && !visited.Insert(129), "Test Insert of cells already present", testsPassed, testsFailed);
+    Test(visited.Contains(0) && visited.Contains(63) && visited.Contains(64) && visited.Contains(129)
+         && !visited.Contains(1) && !visited.Contains(65) && visited.Count() == 4, "Test Contains for non-empty set", testsPassed, testsFailed);
+    visited.Remove(64);
+    Test(!visited.Contains(64) && visited.Contains(63) && visited.Count() == 3, "Test Remove", testsPassed, testsFailed);
+    visited.Reset();
+    Test(visited.Capacity() == 130 && visited.Count() == 0 && !visited.Contains(0) && !visited.Contains(129),
+         "Test Reset", testsPassed, testsFailed);
+    visited.Configure(10);
+    Test(visited.Capacity() == 10 && visited.Count() == 0 && visited.Insert(9), "Test (re-)Configure", testsPassed, testsFailed);
 }
 
 /**
@@ -798,6 +2621,7 @@ void TestGridLocationClass(unsigned& testsPassed, unsigned& testsFailed) {
     Test( !(def == gl23) && !(gl13 == gl23) && !(gl13 == gl26), "Test == negative", testsPassed, testsFailed);
     Test( def < gl13 && gl13 < gl23 && gl23 < gl26, "Test < positive", testsPassed, testsFailed);
     Test( !(gl26 < def) && !(gl23 < gl23a) && !(gl23 < gl13) && !(gl26 < gl23), "Test < negative", testsPassed, testsFailed);
+    Test( gl13 < gl26 && !(gl26 < gl13) && !(gl23 < GridLocation(1,5)), "Test < is ordered by row first", testsPassed, testsFailed);
 }
 
 /**